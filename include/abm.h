@@ -71,6 +71,22 @@ public:
 		initialize_data_collection();
 	}
 
+	/**
+	 * \brief Creates an ABM object with reproducible random numbers 
+	 * \details Same as the time step only constructor, but all the random 
+	 *		numbers are drawn from counter-based streams keyed by seed; two 
+	 *		objects with the same seed and input produce the same simulation
+	 *
+	 * @param del_t - time step, days
+	 * @param seed - seed of all the random number generators in the model
+	 */
+	ABM(double del_t, const std::uint64_t seed) : DataManagementInterface(), dt(del_t), infection(del_t, seed)
+	{
+		time = 0.0;
+		flu.set_seed(seed);
+		initialize_data_collection();
+	}
+
 	//
 	// Initialization and object construction
 	//
@@ -91,6 +107,20 @@ public:
 	 */	
 	void simulation_setup(const std::string filename, const int ninf0 = 0, const bool custom_vac_offsets = false);
 
+	/**
+	 * \brief Create the agents and places of an already loaded town, introduce initially infected 
+	 * \details Same as the file-based setup, but places and agents are copied from 
+	 *		the ones created once in the Town object, and the mobility probabilities 
+	 *		are shared rather than recomputed; each ABM holds its own copy of the
+	 *		places and agents; town can be used to set up any number of ABM objects 
+	 *	
+	 * @param town - loaded, read-only simulation input
+	 * @param ninf0 - number of initially infected - overwriting input file
+	 * @param custom_vac_offsets - read the vac time offsets from file if true
+	 *
+	 */	
+	void simulation_setup_from_town(const Town& town, const int ninf0 = 0, const bool custom_vac_offsets = false);
+
 	/**
 	 * \brief Create households based on information in a file
 	 * \details Constructs households based on the ID and
@@ -183,8 +213,11 @@ public:
 
 	/**
 	 * \brief Initialize Mobility and assignment of leisure locations
+	 * \details With a cache directory, the probability table of the same 
+	 *		town and parameters is loaded from there instead of recomputed 
+	 * @param cache_dir - directory with cached probability tables, none if empty
 	 */
-	void initialize_mobility();
+	void initialize_mobility(const std::string& cache_dir = "");
 
 	/**
 	 * \brief Create agents based on information in a file
@@ -220,6 +253,35 @@ public:
 	/// @param dont_vac - dont vaccinate at this stage (e.g vaccinate in the seeding phase)
 	void initialize_vac_and_reopening(const bool dont_vac = false);
 
+	/**
+	 * \brief Set the number of threads used for computing the place contributions,
+	 *		state transitions, and mobility probabilities during setup from files
+	 * \details The results are the same for any number of threads; call before
+	 *		simulation_setup to also use the threads in the setup
+	 * @param n - number of threads, at least 1
+	 */
+	void set_number_of_threads(const int n);
+
+	/**
+	 * \brief Update place contributions with only the changes since the last step
+	 * \details Off by default; contributions of each agent are stored and the
+	 *		place sums are updated only for agents whose states, places, or
+	 *		infection variability changed. Sums then differ from the full
+	 *		computation by round-off. All the sums are recomputed whenever 
+	 *		transmission rates of places change, except for the leisure 
+	 *		locations, whose rate is applied to the total.
+	 * @param on - true to update incrementally, false to recompute every step
+	 */
+	void set_incremental_contributions(const bool on);
+
+	/**
+	 * \brief Compute the routine part of susceptible lambdas from the routine places of agents
+	 * \details On by default; when off, the places are looked up for every agent 
+	 *		at every step. Results are the same either way.
+	 * @param on - true to use the precomputed routine places, false to look them up
+	 */
+	void set_place_incidence(const bool on);
+
 	//
 	// Transmission of infection
 	//
@@ -249,16 +311,33 @@ public:
 	/// Update transmission dynamics in leisure locations outside of the town
 	void set_outside_leisure_transmission();
 
-	/// \brief Count contributions of all infectious agents in each place 
+	/**
+	 * \brief Count contributions of all infectious agents in each place 
+	 * \details Agents are split among the threads in contiguous blocks;
+	 *		contributions are added to the places after all threads 
+	 *		finish, in agent order, so the sums are the same for any
+	 *		number of threads; unless incremental, totals are recomputed
+	 *		only in places that received contributions since the last 
+	 *		reset_contributions() 
+	 */
 	void compute_place_contributions();
 
-	/// \brief Propagate infection and determine state transitions
+	/**
+	 * \brief Propagate infection and determine state transitions
+	 * \details Agents are split among the threads in contiguous 
+	 *		blocks; each agent draws random numbers from its own 
+	 *		stream for this step, changes of places, flu population, 
+	 *		and contact tracing are applied after all agents 
+	 *		transition, in agent order
+	 */
 	void compute_state_transitions();
 
-	/// \brief Set the lambda factors to 0.0
-	void reset_contributions()
-		{ contributions.reset_sums(households, schools, workplaces, hospitals, 
-						retirement_homes, carpools, public_transit, leisure_locations); }
+	/**
+	 * \brief Set the lambda factors to 0.0, unless contributions are updated incrementally
+	 * \details Only places that received contributions since the last reset are 
+	 *		modified, unless these are not known 
+	 */
+	void reset_contributions();
 	
 	/// Process all traced agents 
 	void setup_traced_isolation(const std::unordered_set<int>&);
@@ -276,6 +355,9 @@ public:
 	/// Current simulation time
 	double get_time() const { return time; }
 
+	/// Number of times the incrementally updated contributions were rebuilt from all the agents
+	int get_number_of_contribution_rebuilds() const { return n_contribution_rebuilds; }
+
 	/// Saves the matrix with mobility probabilities
 	void print_mobility_probabilities(const std::string fname)
 		{ mobility.print_probabilities(fname); }
@@ -300,14 +382,19 @@ public:
 
 	/// Return a copy of Infection object
 	Infection get_copied_infection_object() const { return infection; }
-	/// Return a reference to an Infection object
-	Infection& get_infection_object() { return infection; }
+	/// \brief Return a reference to an Infection object
+	/// \details The object can be changed through the reference at any time, so from 
+	///		then on the generators of the workers are copied from it at every step
+	Infection& get_infection_object() { infection_modifiable = true; return infection; }
 	/// Return a const reference to parameter map
 	const std::map<std::string, double>& get_infection_parameters() const
 		{ return infection_parameters; }
-	/// Return a reference to parameter map
-	std::map<std::string, double>& get_infection_parameters() 
-		{ return infection_parameters; }
+	/// \brief Change a parameter in both the map and the resolved parameters
+	/// \details Infection distributions are not changed, they are set when loaded
+	void set_infection_parameter(const std::string& name, const double value);
+	/// Return a const reference to the parameters resolved for agent processing
+	const InfectionParameters& get_resolved_infection_parameters() const 
+		{ return parameters; }
 	/// Return a copy of the Flu object
 	Flu get_flu_object() const { return flu; }
 	/// Return a reference to Flu object
@@ -318,6 +405,8 @@ public:
 	Testing& get_testing_object() { return testing; }
 	/// Return a Transitions object
 	Transitions& get_transitions_object() { return transitions; }
+	/// Return a const reference to the Vaccinations object
+	const Vaccinations& get_vaccinations_object() const { return vaccinations; }
 private:
 
 	// General model attributes
@@ -328,11 +417,18 @@ private:
 	
 	// Infection parameters
 	std::map<std::string, double> infection_parameters = {};
+	// Parameters used while processing agents, resolved from the map
+	InfectionParameters parameters;
 	// Age-dependent distributions
 	std::map<std::string, std::map<std::string, double>> age_dependent_distributions = {};
 
 	// Infection properties and transmission model
 	Infection infection;
+	// Copies of infection used by the workers, each switched to the
+	// stream of the agent it processes; empty if they need to be copied
+	std::vector<Infection> worker_infections;
+	// True once infection could be modified outside of the model
+	bool infection_modifiable = false;
 	// Performs vaccinations and manages properties of vaccines
 	Vaccinations vaccinations;
 	// Testing properties and their time dependence
@@ -351,6 +447,46 @@ private:
 	// with flu i.e.  non-covid symptomatic
 	Flu flu;
 
+	// Number of threads for processing agents
+	int n_threads = 1;
+	// Threads that process agents and places, started once
+	WorkerPool workers;
+
+	// Place contributions updated with changes only
+	bool incremental_contributions = false;
+	// Current contributions of each agent if incremental
+	ContributionRecords contribution_records;
+	// Number of times the recorded contributions were rebuilt from all the agents
+	int n_contribution_rebuilds = 0;
+	// Agents that contributed in the last update, sorted
+	std::vector<int> recorded_IDs;
+	// Routine places of each agent, built when agents are registered
+	PlaceIncidence place_incidence;
+	// Routine places are used in the transitions
+	bool use_place_incidence = true;
+	// Vaccine effectiveness of each agent at the current step
+	VaccineEffects vaccine_effects;
+	// Places with contributions if not incremental
+	TouchedPlaces touched_places;
+	// Storage of the places when the records above were made, 
+	// first and past the last element of each vector of places
+	std::vector<const Place*> place_storage;
+
+	/// Changes in population statistics from state transitions of a group of agents
+	struct TransitionCounts {
+		int infected = 0;
+		int recovering_exposed = 0;
+		int recovered = 0;
+		int dead_tested = 0;
+		int dead_not_tested = 0;
+		int tested = 0;
+		int tested_pos = 0;
+		int tested_neg = 0;
+		int tested_false_pos = 0;
+		int tested_false_neg = 0;
+		int re_vaccinated = 0;
+	};
+
 	// Vaccination properties
 	bool random_vaccines = false;
 	int n_vaccinated = 0;
@@ -367,15 +503,23 @@ private:
 	double ini_frac_les = 0.0;
 	// Difference between initial and final fraction
 	double del_frac_les = 0.0;
+	// Agents assigned a leisure location at the last distribution, 
+	// valid once leisure was distributed with all the agents created
+	// and until the agents are modified outside of the model
+	std::vector<int> leisure_agent_IDs;
+	bool leisure_tracked = false;
 
 	// Private methods
 
 	/// Set initial values on all the data collection variables and containers
 	void initialize_data_collection();
 
-	/// Load infection parameters, store in a map
+	/// Load infection parameters, store in a map and resolve the ones for agent processing
 	void load_infection_parameters(const std::string);
 
+	/// Set distributions in the Infection object based on the infection parameters 
+	void set_infection_distributions();
+
 	/// Load age-dependent distributions as vectors stored in a map
 	void load_age_dependent_distributions(const std::map<std::string, std::string>);
 
@@ -419,11 +563,94 @@ private:
 
 	/// Initiate contact tracing of an agent
 	void contact_trace_agent(Agent& agent);
+
+	/**
+	 * \brief State transitions of agents with indices in [first, last)
+	 * \details Called with deferred updates recorded in updates
+	 * 
+	 * @param first - index of the first agent
+	 * @param last - index past the last agent
+	 * @param step - number of this time step, selects the random number streams
+	 * @param local_infection - Infection object used only by the calling thread
+	 * @param counts - statistics of this group of agents
+	 * @param updates - deferred changes, also collects agents to contact trace
+	 * @param changed_IDs - collects agents whose counted states changed
+	 * @param incidence - routine places of the agents, nullptr if not built
+	 * @param vac_effects - vaccine effectiveness of the agents at this step
+	 */
+	void compute_agent_transitions(const int first, const int last, const int step,
+					Infection& local_infection, TransitionCounts& counts, 
+					DeferredUpdates& updates, std::vector<int>& changed_IDs,
+					const PlaceIncidence* incidence, const VaccineEffects* vac_effects);
+
+	/**
+	 * \brief Contributions of a group of agents, called with deferred updates recorded
+	 * @param agent_IDs - IDs of all the agents that can contribute
+	 * @param first - index of the first ID in agent_IDs to process
+	 * @param last - index past the last ID to process
+	 */
+	void compute_agent_contributions(const std::vector<int>& agent_IDs, const int first, const int last);
+
+	/**
+	 * \brief Contributions of agents from a list, computed and added to the places in parallel
+	 * \details Threads record contributions of their agents, then each thread adds
+	 *		the records for its own range of places in order of agents, so the sums
+	 *		are the same for any number of threads; expects current place_storage
+	 * @param agent_IDs - IDs of the agents, in order
+	 * @returns contributions recorded by each thread, in order of agents 
+	 */
+	std::vector<DeferredUpdates> compute_contributions_in_parallel(const std::vector<int>& agent_IDs);
+
+	/// Add changes in contributions of agents since the last step, rebuild if needed
+	void update_place_contributions();
+
+	/// Update the counted states and vaccination eligibility of an agent that may have changed
+	void update_agent_records(const Agent& agent)
+		{ population_states.update(agent); vaccinations.update_eligibility(agent); }
+
+	/// \brief Rebuild records of the agents if they were modified outside of the model
+	/// \details Agents count as unmodified again after this, see agents_modified()
+	void synchronize_agent_records();
+
+	/**
+	 * \brief Invalidate records of places if any vector of places was replaced or could have been modified
+	 * \details Vectors of places can be replaced or modified through the non-const getters
+	 */
+	void check_place_storage();
+
+	/// Apply changes of shared objects recorded while processing agents in parallel, in order
+	void apply_deferred_updates(const std::vector<DeferredUpdates>& updates);
+
+	/// Number of threads that process agents, at most one per agent
+	int number_of_workers() const { return number_of_workers(agents.size()); }
+	/// Number of threads that process n_items items, at most one per item 
+	int number_of_workers(const int n_items) const 
+		{ return std::max(1, std::min(n_threads, n_items)); }
+
+	/// Split all the agents among the threads, same as process_in_parallel with all agents
+	std::vector<DeferredUpdates> process_agents_in_parallel(
+			const std::function<void(const int, const int, const int, DeferredUpdates&)>& process)
+		{ return process_in_parallel(agents.size(), process); }
+
+	/**
+	 * \brief Split items among the threads and process them recording deferred updates
+	 * \details Exceptions thrown by any of the threads are rethrown after all of them finish
+	 * @param n_items - number of items to process
+	 * @param process - processes items with indices [first, last) as worker iw, 
+	 *			arguments are iw, first, last, and the updates recorded by that worker
+	 * @returns changes recorded by each worker, in item order 
+	 */
+	std::vector<DeferredUpdates> process_in_parallel(const int n_items,
+			const std::function<void(const int, const int, const int, DeferredUpdates&)>& process);
 	/**
 	 * \brief Retrieve information about agents from a file and store all in a vector
 	 * \details Optional parameter overwrites the loaded initially infected with custom
 	 */
 	void load_agents(const std::string fname, const int ninf0 = 0);
+	/// Copy agents created from the input, optionally with custom initially infected 
+	void load_agents(const std::vector<Agent>& town_agents, const int ninf0 = 0);
+	/// Copy agents created from the input and register them in places
+	void create_agents(const std::vector<Agent>& town_agents, const int ninf0 = 0);
 
 	/**
 	 * \brief Assign agents to households, schools, and worplaces
@@ -37,6 +37,9 @@
 //
 
 #include <unordered_set>
+#include <thread>
+#include <exception>
+#include <functional>
 #include "common.h"
 #include "./io_operations/abm_io.h"
 #include "./io_operations/load_parameters.h"
@@ -48,8 +51,16 @@
 #include "flu.h"
 #include "utils.h"
 #include "mobility.h"
+#include "town.h"
 #include "three_part_function.h"
 #include "four_part_function.h"
 #include "vaccinations.h"
+#include "deferred_updates.h"
+#include "contribution_records.h"
+#include "place_incidence.h"
+#include "touched_places.h"
+#include "vaccine_effects.h"
+#include "infection_parameters.h"
+#include "worker_pool.h"
 
 #endif
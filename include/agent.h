@@ -1,10 +1,13 @@
 #ifndef AGENT_H
 #define AGENT_H
 
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include "common.h"
+#include "agent_attributes.h"
 #include "infection.h"
-#include "three_part_function.h"
-#include "four_part_function.h"
+#include "vaccine_profiles.h"
 
 class Infection;
 
@@ -57,12 +60,20 @@ public:
 			const bool worksHospital, const int hospitalID, const bool infected, 
 			const std::string wt_mode, const double wt_time, 
 			const int cp_ID, const int pt_ID, const bool wfh) 
-			: is_student(student), is_working(works), age(yrs),
-		   		x(xi), y(yi), house_ID(houseID), is_non_covid_patient(isPatient), school_ID(schoolID), 
-				livesRH(lvRH), worksRH(wrkRH), worksSch(wrkSch), work_ID(workID),  
-				works_at_hospital(worksHospital), hospital_ID(hospitalID), is_infected(infected), 
-				work_travel_mode(wt_mode), work_travel_time(wt_time), carpool_ID(cp_ID), 
-				public_transit_ID(pt_ID), works_remotely(wfh){ }  
+			: house_ID(houseID), school_ID(schoolID), work_ID(workID), hospital_ID(hospitalID),  
+				carpool_ID(cp_ID), public_transit_ID(pt_ID), age(yrs), x(xi), y(yi),
+				work_travel_time(wt_time), work_travel_mode(travel_mode_from_name(wt_mode))
+	{
+		set_flag(Flag::is_student, student);
+		set_flag(Flag::is_working, works);
+		set_flag(Flag::is_non_covid_patient, isPatient);
+		set_flag(Flag::livesRH, lvRH);
+		set_flag(Flag::worksRH, wrkRH);
+		set_flag(Flag::worksSch, wrkSch);
+		set_flag(Flag::works_at_hospital, worksHospital);
+		set_flag(Flag::is_infected, infected);
+		set_flag(Flag::works_remotely, wfh);
+	}
 
 	//
 	// Infection related computations
@@ -86,8 +97,10 @@ public:
 	int get_hospital_ID() const { return hospital_ID; }
 	/// Travel time to work
 	double get_work_travel_time() const { return work_travel_time; }
+	/// Travel mode to work, name as in the input
+	std::string get_work_travel_mode() const { return travel_mode_name(work_travel_mode); }
 	/// Travel mode to work
-	std::string get_work_travel_mode() const { return work_travel_mode; }
+	TravelMode get_travel_mode() const { return work_travel_mode; }
 	/// Carpool ID
 	int get_carpool_ID() const { return carpool_ID; }
 	/// Public ID
@@ -95,9 +108,12 @@ public:
 	/// Leisure ID 
 	int get_leisure_ID() const { return leisure_location_ID; }
 	/// Leisure type ("household" or "public")
-	std::string get_leisure_type() const { return leisure_type; }
+	std::string get_leisure_type() const { return leisure_type_name(leisure_type); }
+	/// Leisure type 
+	LeisureType get_leisure_location_type() const { return leisure_type; }
 	// Occupation type ('A', 'B', 'C', 'D', or 'E')
-	std::string get_occupation() const { return occupation; }
+	std::string get_occupation() const { return occupation_name(occupation); }
+	Occupation get_occupation_type() const { return occupation; }
 	// Transmission rate of this agents occupation
 	double get_occupation_transmission() const { return occupation_beta; }
 
@@ -106,62 +122,73 @@ public:
 	/// Location - y coordinates
 	double get_y_location() const { return y; }
 
+	/// All the yes/no attributes and states packed in one word, for detecting changes
+	std::uint64_t get_state_flags() const { return flags; }
+
 	/// True if infected
-	bool infected() const { return is_infected; }
+	bool infected() const { return flag(Flag::is_infected); }
 	/// True if student
-	bool student() const { return is_student; }
+	bool student() const { return flag(Flag::is_student); }
 	/// True if agent works
-	bool works() const { return is_working; }
+	bool works() const { return flag(Flag::is_working); }
 	/// True if agent works at a hospital
-	bool hospital_employee() const { return works_at_hospital; }
+	bool hospital_employee() const { return flag(Flag::works_at_hospital); }
 	/// True if agent is a hospital patient with condition other than COVID
-	bool hospital_non_covid_patient() const { return is_non_covid_patient; }
+	bool hospital_non_covid_patient() const { return flag(Flag::is_non_covid_patient); }
 	/// True if agent works in a retirement home 
-	bool retirement_home_employee() const { return worksRH; }
+	bool retirement_home_employee() const { return flag(Flag::worksRH); }
 	/// True if agent works at a school
-	bool school_employee() const { return worksSch; }
+	bool school_employee() const { return flag(Flag::worksSch); }
 	/// True if agent lives in a retirement home 
-	bool retirement_home_resident() const { return livesRH; }
+	bool retirement_home_resident() const { return flag(Flag::livesRH); }
 	/// True if agent works from home
-	bool works_from_home() const { return works_remotely; }
+	bool works_from_home() const { return flag(Flag::works_remotely); }
 
 	/// State getters
-	bool exposed() const { return is_exposed; }
-	bool recovering_exposed() const { return is_recovering_exposed; }
-	bool symptomatic() const { return is_symptomatic; }
-	bool symptomatic_non_covid() const { return is_symptomatic_non_covid; }
-	bool former_suspected() const { return is_former_suspected; }
+	bool exposed() const { return flag(Flag::is_exposed); }
+	bool recovering_exposed() const { return flag(Flag::is_recovering_exposed); }
+	bool symptomatic() const { return flag(Flag::is_symptomatic); }
+	bool symptomatic_non_covid() const { return flag(Flag::is_symptomatic_non_covid); }
+	bool former_suspected() const { return flag(Flag::is_former_suspected); }
 	// Testing results
-	bool tested_covid_negative() const { return is_tested_covid_negative; }
-	bool tested_false_negative() const { return is_tested_false_negative; }
-	bool tested_false_positive() const { return is_tested_false_positive; }
-	bool tested_covid_positive() const { return is_tested_covid_positive; }
+	bool tested_covid_negative() const { return flag(Flag::is_tested_covid_negative); }
+	bool tested_false_negative() const { return flag(Flag::is_tested_false_negative); }
+	bool tested_false_positive() const { return flag(Flag::is_tested_false_positive); }
+	bool tested_covid_positive() const { return flag(Flag::is_tested_covid_positive); }
 	// Testing phases and types 
-	bool tested() const { return is_tested; }
-	bool tested_exposed() const { return is_tested_exposed; }
-	bool tested_in_car() const { return is_tested_in_car; }
-	bool tested_in_hospital() const { return is_tested_in_hospital; }
-	bool tested_awaiting_results() const { return is_tested_awaiting_results; }
-	bool tested_awaiting_test() const { return is_tested_awaiting_test; } 
+	bool tested() const { return flag(Flag::is_tested); }
+	bool tested_exposed() const { return flag(Flag::is_tested_exposed); }
+	bool tested_in_car() const { return flag(Flag::is_tested_in_car); }
+	bool tested_in_hospital() const { return flag(Flag::is_tested_in_hospital); }
+	bool tested_awaiting_results() const { return flag(Flag::is_tested_awaiting_results); }
+	bool tested_awaiting_test() const { return flag(Flag::is_tested_awaiting_test); } 
 	double get_time_for_flu_isolation() { return time_flu_ih; }
-	bool get_testing_since_exposed() { return is_testing_since_exposed; }
+	bool get_testing_since_exposed() { return flag(Flag::is_testing_since_exposed); }
 	// Treatment types
-	bool being_treated() const { return is_treated; }
-	bool home_isolated() const { return is_home_isolated; }
-	bool hospitalized() const { return is_hospitalized; }
-	bool hospitalized_ICU() const { return is_hospitalized_ICU; }
+	bool being_treated() const { return flag(Flag::is_treated); }
+	bool home_isolated() const { return flag(Flag::is_home_isolated); }
+	bool hospitalized() const { return flag(Flag::is_hospitalized); }
+	bool hospitalized_ICU() const { return flag(Flag::is_hospitalized_ICU); }
 	// Contact tracing
-	bool contact_traced() const { return is_contact_traced; }
+	bool contact_traced() const { return flag(Flag::is_contact_traced); }
 	// Treatment - as set for regular agent
-	bool get_will_be_hospitalized() const { return will_be_hospitalized; }
-	bool get_will_be_hospitalized_ICU() const { return will_be_in_ICU; }
-	bool get_will_be_home_isolated() const { return will_be_home_isolated; }
+	bool get_will_be_hospitalized() const { return flag(Flag::will_be_hospitalized); }
+	bool get_will_be_hospitalized_ICU() const { return flag(Flag::will_be_in_ICU); }
+	bool get_will_be_home_isolated() const { return flag(Flag::will_be_home_isolated); }
 	// Removal
-	bool dying() const { return will_die; }
-	bool recovering() const { return will_recover; }
-	bool removed() const { return is_removed; }
-	bool removed_recovered() const { return is_removed_recovered; }
-	bool removed_dead() const { return is_removed_dead; }
+	bool dying() const { return flag(Flag::will_die); }
+	bool recovering() const { return flag(Flag::will_recover); }
+	bool removed() const { return flag(Flag::is_removed); }
+	bool removed_recovered() const { return flag(Flag::is_removed_recovered); }
+	bool removed_dead() const { return flag(Flag::is_removed_dead); }
+
+	/**
+	 * \brief Earliest time when any of the timed transitions common to all agents is due 
+	 * \details Covers loss of immunity, vaccine effects reduction, vaccination 
+	 *		eligibility, mobility increase, and end of quarantine and its memory; 
+	 *		kept up to date by the setters, infinity if nothing is scheduled
+	 */
+	double get_next_timed_transition() const { return next_timed_transition; }
 
 	/// Get infectiousness variability factor of an agent
 	double get_inf_variability_factor() const { return inf_var; }
@@ -197,29 +224,42 @@ public:
 	double get_memory_duration() const { return end_of_memory; }
 
 	// Vaccinations
-	bool vaccinated() const { return is_vaccinated; }
-	bool needs_next_vaccination() const { return next_vaccination; }
-	bool removed_can_vaccinate() const { return was_removed_can_vaccinate; }
-	bool suspected_can_vaccinate() const { return was_suspected_can_vaccinate; }
-	bool more_active() const { return is_more_active; }
-	std::string get_vaccine_type() const { return vaccine_type; }
-	std::string get_vaccine_subtype() const { return vaccine_subtype; }
+	bool vaccinated() const { return flag(Flag::is_vaccinated); }
+	bool needs_next_vaccination() const { return flag(Flag::next_vaccination); }
+	bool removed_can_vaccinate() const { return flag(Flag::was_removed_can_vaccinate); }
+	bool suspected_can_vaccinate() const { return flag(Flag::was_suspected_can_vaccinate); }
+	bool more_active() const { return flag(Flag::is_more_active); }
+	std::string get_vaccine_type() const { return vaccine_type_name(vaccine_type); }
+	VaccineType get_vaccine_regimen() const { return vaccine_type; }
+	/// ID of the vaccine subtype in VaccineSubtypes of the vaccinations
+	int get_vaccine_subtype_ID() const { return vaccine_subtype; }
 	double get_vac_time_offset() const { return vac_offset; }
 	/// Time when the peak benefits of vaccine start dropping 
 	double get_time_vaccine_effects_reduction() const { return time_vac_drop; }
 	/// Time when the mobility increses 
 	double get_time_mobility_increase() const { return time_mobility_increase; }
+	/// Shared vaccine profile, nullptr if the agent has its own response or none
+	const VaccineResponse* get_vaccine_profile() const { return vac_profile.get(); }
+	/// Time when the shared vaccine profile starts
+	double get_vaccine_profile_time() const { return vac_profile_time; }
+	/// True if the agent has its own vaccine response
+	bool has_own_vaccine_response() const { return vac_response.ptr != nullptr; }
 	// Time dependencies 
-	double vaccine_effectiveness(const double time) 
-		{ return (vaccine_type == "one_dose" ? tpf_effectiveness(time) : fpf_effectiveness(time)); }
- 	double asymptomatic_correction(const double time) 
-		{ return (vaccine_type == "one_dose" ? tpf_asymptomatic(time) : fpf_asymptomatic(time)); }
-	double transmission_correction(const double time) 		
-		{ return (vaccine_type == "one_dose" ? tpf_transmission(time) : fpf_transmission(time)); }
-	double severe_correction(const double time) 		
-		{ return (vaccine_type == "one_dose" ? tpf_severe(time) : fpf_severe(time)); }
- 	double death_correction(const double time) 		
-		{ return (vaccine_type == "one_dose" ? tpf_death(time) : fpf_death(time)); }
+	double vaccine_effectiveness(const double time) const
+		{ return (vaccine_type == VaccineType::one_dose ? 
+				vaccine_response().tpf_effectiveness(response_time(time)) : vaccine_response().fpf_effectiveness(response_time(time))); }
+ 	double asymptomatic_correction(const double time) const
+		{ return (vaccine_type == VaccineType::one_dose ? 
+				vaccine_response().tpf_asymptomatic(response_time(time)) : vaccine_response().fpf_asymptomatic(response_time(time))); }
+	double transmission_correction(const double time) const
+		{ return (vaccine_type == VaccineType::one_dose ? 
+				vaccine_response().tpf_transmission(response_time(time)) : vaccine_response().fpf_transmission(response_time(time))); }
+	double severe_correction(const double time) const
+		{ return (vaccine_type == VaccineType::one_dose ? 
+				vaccine_response().tpf_severe(response_time(time)) : vaccine_response().fpf_severe(response_time(time))); }
+ 	double death_correction(const double time) const
+		{ return (vaccine_type == VaccineType::one_dose ? 
+				vaccine_response().tpf_death(response_time(time)) : vaccine_response().fpf_death(response_time(time))); }
 	
 	//
 	// Setters
@@ -238,21 +278,22 @@ public:
 	void set_leisure_ID(const int val) { leisure_location_ID = val; }
 	
 	/// Leisure type (household or public)
-	void set_leisure_type(const std::string val) { leisure_type = val; }
+	void set_leisure_type(const std::string val) { leisure_type = leisure_type_from_name(val); }
+	void set_leisure_type(const LeisureType val) { leisure_type = val; }
 
 	/// Assign household ID
 	void set_household_ID(const int ID) { house_ID = ID; }
 
 	/// Change infection status
-	void set_infected(const bool infected) { is_infected = infected; }
+	void set_infected(const bool infected) { set_flag(Flag::is_infected, infected); }
 
 	/// Time when recovered agent loses immunity
-	void set_time_recovered_to_susceptible(const double time) { time_RH2S = time; }
+	void set_time_recovered_to_susceptible(const double time) { time_RH2S = time; update_next_timed_transition(); }
 	/// Time when recovered agent can get vaccinated
-	void set_time_recovered_can_vaccinate(const double time) { time_rec_vac = time; }
+	void set_time_recovered_can_vaccinate(const double time) { time_rec_vac = time; update_next_timed_transition(); }
 	
 	// Occupation type ('A', 'B', 'C', 'D', or 'E' )
-	void set_occupation(const std::string occ) { occupation = occ; }
+	void set_occupation(const std::string occ) { occupation = occupation_from_name(occ); }
 	// Occupation transmission rate
 	void set_occupation_transmission(const double val) { occupation_beta = val; } 
 
@@ -300,74 +341,84 @@ public:
 	void set_time_ih_to_hsp(const double t_hsp) { time_ih_to_hsp = t_hsp; }
 
 	/// State setters
-	void set_exposed(const bool val) { is_exposed = val; }
-	void set_recovering_exposed(const bool re) { is_recovering_exposed = re; }
-	void set_symptomatic(const bool val) { is_symptomatic = val; }
-	void set_symptomatic_non_covid(const bool val) { is_symptomatic_non_covid = val; }
-	void set_former_suspected(const bool val) { is_former_suspected = val; }
+	void set_exposed(const bool val) { set_flag(Flag::is_exposed, val); }
+	void set_recovering_exposed(const bool re) { set_flag(Flag::is_recovering_exposed, re); }
+	void set_symptomatic(const bool val) { set_flag(Flag::is_symptomatic, val); }
+	void set_symptomatic_non_covid(const bool val) { set_flag(Flag::is_symptomatic_non_covid, val); }
+	void set_former_suspected(const bool val) { set_timer_flag(Flag::is_former_suspected, val); }
 	// Testing results
-	void set_tested_covid_negative(const bool val) { is_tested_covid_negative = val; }
-	void set_tested_false_negative(const bool val) { is_tested_false_negative = val; }
-	void set_tested_false_positive(const bool val) { is_tested_false_positive = val; }
-	void set_tested_covid_positive(const bool val) { is_tested_covid_positive = val; }
+	void set_tested_covid_negative(const bool val) { set_flag(Flag::is_tested_covid_negative, val); }
+	void set_tested_false_negative(const bool val) { set_flag(Flag::is_tested_false_negative, val); }
+	void set_tested_false_positive(const bool val) { set_flag(Flag::is_tested_false_positive, val); }
+	void set_tested_covid_positive(const bool val) { set_flag(Flag::is_tested_covid_positive, val); }
 	// Testing phases and types
-	void set_tested(const bool val) { is_tested = val; }
-	void set_tested_in_car(const bool val) { is_tested_in_car = val; }
-	void set_tested_in_hospital(const bool val) { is_tested_in_hospital = val; }
-	void set_tested_awaiting_results(const bool val) { is_tested_awaiting_results = val; }
-	void set_tested_awaiting_test(const bool val) { is_tested_awaiting_test = val; }
-	void set_tested_exposed(const bool val) { is_tested_exposed = val; }
+	void set_tested(const bool val) { set_flag(Flag::is_tested, val); }
+	void set_tested_in_car(const bool val) { set_flag(Flag::is_tested_in_car, val); }
+	void set_tested_in_hospital(const bool val) { set_flag(Flag::is_tested_in_hospital, val); }
+	void set_tested_awaiting_results(const bool val) { set_flag(Flag::is_tested_awaiting_results, val); }
+	void set_tested_awaiting_test(const bool val) { set_flag(Flag::is_tested_awaiting_test, val); }
+	void set_tested_exposed(const bool val) { set_flag(Flag::is_tested_exposed, val); }
 	void set_flu_isolation(const double val) { time_flu_ih = time_of_test - val; }
-	void set_testing_since_exposed(const bool val) { is_testing_since_exposed = val;}
+	void set_testing_since_exposed(const bool val) { set_flag(Flag::is_testing_since_exposed, val); }
 
 	// Treatment types
-	void set_being_treated(const bool val) { is_treated = val; }
-	void set_home_isolated(const bool val) { is_home_isolated = val; }
-	void set_hospitalized(const bool val) { is_hospitalized = val; }
-	void set_hospitalized_ICU(const bool val) { is_hospitalized_ICU = val; }
+	void set_being_treated(const bool val) { set_flag(Flag::is_treated, val); }
+	void set_home_isolated(const bool val) { set_flag(Flag::is_home_isolated, val); }
+	void set_hospitalized(const bool val) { set_flag(Flag::is_hospitalized, val); }
+	void set_hospitalized_ICU(const bool val) { set_flag(Flag::is_hospitalized_ICU, val); }
 	// Contact tracing
-	void set_contact_traced(const bool val) { is_contact_traced = val; }
-	void set_quarantine_duration(const double val) { end_of_quarantine = val; }
-	void set_memory_duration(const double val) { end_of_memory = val; }
+	void set_contact_traced(const bool val) { set_timer_flag(Flag::is_contact_traced, val); }
+	void set_quarantine_duration(const double val) { end_of_quarantine = val; update_next_timed_transition(); }
+	void set_memory_duration(const double val) { end_of_memory = val; update_next_timed_transition(); }
 	// Removal
-	void set_dying(const bool val) { will_die = val; }
-	void set_recovering(const bool val) { will_recover = val; }
-	void set_removed(const bool val) { is_removed = val; }
-	void set_removed_dead(const bool val) { is_removed_dead = val; }
-	void set_removed_recovered(const bool val) { is_removed_recovered = val; }
+	void set_dying(const bool val) { set_flag(Flag::will_die, val); }
+	void set_recovering(const bool val) { set_flag(Flag::will_recover, val); }
+	void set_removed(const bool val) { set_flag(Flag::is_removed, val); }
+	void set_removed_dead(const bool val) { set_flag(Flag::is_removed_dead, val); }
+	void set_removed_recovered(const bool val) { set_timer_flag(Flag::is_removed_recovered, val); }
 	// Treatment - as set for regular
-	void to_be_hospitalized(const bool val) { will_be_hospitalized = val; }
-	void to_be_in_ICU(const bool val) { will_be_in_ICU = val; }
-	void to_be_home_isolated(const bool val) { will_be_home_isolated = val; }
+	void to_be_hospitalized(const bool val) { set_flag(Flag::will_be_hospitalized, val); }
+	void to_be_in_ICU(const bool val) { set_flag(Flag::will_be_in_ICU, val); }
+	void to_be_home_isolated(const bool val) { set_flag(Flag::will_be_home_isolated, val); }
 
 	/// Set infectiousness variability factor of an agent
 	void set_inf_variability_factor(const double var) { inf_var = var; }
 
 	// Vaccination
-	void set_vaccinated(const bool val) { is_vaccinated = val; }
-	void set_needs_next_vaccination(const bool val) { next_vaccination = val; }
-	void set_removed_can_vaccinate(const bool val) { was_removed_can_vaccinate = val; }	
-	void set_suspected_can_vaccinate(const bool val) { was_suspected_can_vaccinate = val; }
-	void set_more_active(const bool val) { is_more_active = val; }
-	void set_vaccine_type(const std::string type) { vaccine_type = type; }
-	void set_vaccine_subtype(const std::string type) { vaccine_subtype = type; }
+	void set_vaccinated(const bool val) { set_timer_flag(Flag::is_vaccinated, val); }
+	void set_needs_next_vaccination(const bool val) { set_timer_flag(Flag::next_vaccination, val); }
+	void set_removed_can_vaccinate(const bool val) { set_timer_flag(Flag::was_removed_can_vaccinate, val); }	
+	void set_suspected_can_vaccinate(const bool val) { set_timer_flag(Flag::was_suspected_can_vaccinate, val); }
+	void set_more_active(const bool val) { set_timer_flag(Flag::is_more_active, val); }
+	void set_vaccine_type(const std::string type) { vaccine_type = vaccine_type_from_name(type); }
+	void set_vaccine_type(const VaccineType type) { vaccine_type = type; }
+	void set_vaccine_subtype(const int type_ID) { vaccine_subtype = type_ID; }
 	void set_vac_time_offset(const double val) { vac_offset = val; }
 	/// Time when the peak benefits of vaccine start dropping 
-	void set_time_vaccine_effects_reduction(const double val) { time_vac_drop = val; }
+	void set_time_vaccine_effects_reduction(const double val) { time_vac_drop = val; update_next_timed_transition(); }
 	/// Time when the mobility increses 
-	void set_time_mobility_increase(const double val) { time_mobility_increase = val; }
+	void set_time_mobility_increase(const double val) { time_mobility_increase = val; update_next_timed_transition(); }
+	/**
+	 * \brief Set the response to a shared vaccine profile
+	 * @param profile - profile from VaccineProfiles
+	 * @param time - time of vaccination, start of the profile
+	 */
+	void set_vaccine_profile(const std::shared_ptr<const VaccineResponse>& profile, const double time)
+		{ vac_profile = profile; vac_profile_time = time; vac_response.ptr.reset(); }
+	// Time dependence of the agent's own response, replaces a shared 
+	// profile; benefits not set keep the values of the profile
 	// Time dependence for 1 dose vaccines
-	void set_vaccine_effectiveness(ThreePartFunction tpf) { tpf_effectiveness = tpf; }
-	void set_asymptomatic_correction(ThreePartFunction tpf) { tpf_asymptomatic = tpf; }
-	void set_transmission_correction(ThreePartFunction tpf) { tpf_transmission = tpf; }
-	void set_severe_correction(ThreePartFunction tpf) { tpf_severe = tpf; }
-	void set_death_correction(ThreePartFunction tpf) { tpf_death = tpf; }
+	void set_vaccine_effectiveness(ThreePartFunction tpf) { writable_vaccine_response().tpf_effectiveness = tpf; }
+	void set_asymptomatic_correction(ThreePartFunction tpf) { writable_vaccine_response().tpf_asymptomatic = tpf; }
+	void set_transmission_correction(ThreePartFunction tpf) { writable_vaccine_response().tpf_transmission = tpf; }
+	void set_severe_correction(ThreePartFunction tpf) { writable_vaccine_response().tpf_severe = tpf; }
+	void set_death_correction(ThreePartFunction tpf) { writable_vaccine_response().tpf_death = tpf; }
 	// Time dependence for 2 dose vaccines
-	void set_vaccine_effectiveness(FourPartFunction fpf) { fpf_effectiveness = fpf; }
-	void set_asymptomatic_correction(FourPartFunction fpf) { fpf_asymptomatic = fpf; }
-	void set_transmission_correction(FourPartFunction fpf) { fpf_transmission = fpf; }
-	void set_severe_correction(FourPartFunction fpf) { fpf_severe = fpf; }
-	void set_death_correction(FourPartFunction fpf) { fpf_death = fpf; }
+	void set_vaccine_effectiveness(FourPartFunction fpf) { writable_vaccine_response().fpf_effectiveness = fpf; }
+	void set_asymptomatic_correction(FourPartFunction fpf) { writable_vaccine_response().fpf_asymptomatic = fpf; }
+	void set_transmission_correction(FourPartFunction fpf) { writable_vaccine_response().fpf_transmission = fpf; }
+	void set_severe_correction(FourPartFunction fpf) { writable_vaccine_response().fpf_severe = fpf; }
+	void set_death_correction(FourPartFunction fpf) { writable_vaccine_response().fpf_death = fpf; }
 
 	//
 	// I/O
@@ -383,10 +434,65 @@ public:
 
 private:
 
-	// General demographic information
-	bool is_student = false;
-	bool is_working = false;
-	int age = 0;
+	/// Yes/no attributes and states, each is a single bit of flags
+	enum class Flag : unsigned char {
+		// Demographics
+		is_student, is_working, is_non_covid_patient, works_at_hospital, 
+		worksRH, worksSch, livesRH, works_remotely,
+		// Infection status and states
+		is_infected, is_exposed, is_recovering_exposed, is_symptomatic, 
+		is_symptomatic_non_covid, is_removed_dead, is_removed_recovered, 
+		is_former_suspected,
+		// Testing results
+		is_tested_covid_negative, is_tested_false_negative, 
+		is_tested_false_positive, is_tested_covid_positive,
+		// Testing phases and types
+		is_tested, is_tested_in_car, is_tested_in_hospital, 
+		is_tested_awaiting_results, is_tested_awaiting_test, 
+		is_tested_exposed, is_testing_since_exposed,
+		// Treatment types
+		is_treated, is_home_isolated, is_hospitalized, is_hospitalized_ICU,
+		// Contact tracing
+		is_contact_traced,
+		// Removal
+		will_die, will_recover, is_removed, will_be_hospitalized, 
+		will_be_in_ICU, will_be_home_isolated,
+		// Vaccinations
+		is_vaccinated, next_vaccination, was_removed_can_vaccinate, 
+		was_suspected_can_vaccinate, is_more_active,
+		// Number of flags
+		n_flags
+	};
+	static_assert(static_cast<int>(Flag::n_flags) <= 64, "Agent flags do not fit in 64 bits");
+
+	/// Owning pointer to the vaccine response, copied with the agent
+	class VaccineResponsePtr {
+	public:
+		VaccineResponsePtr() = default;
+		VaccineResponsePtr(const VaccineResponsePtr& other) 
+			: ptr(other.ptr ? new VaccineResponse(*other.ptr) : nullptr) { }
+		VaccineResponsePtr& operator=(const VaccineResponsePtr& other)
+			{ ptr.reset(other.ptr ? new VaccineResponse(*other.ptr) : nullptr); return *this; }
+		VaccineResponsePtr(VaccineResponsePtr&&) = default;
+		VaccineResponsePtr& operator=(VaccineResponsePtr&&) = default;
+		std::unique_ptr<VaccineResponse> ptr;
+	};
+
+	//
+	// Hot data - checked for most agents in every step 
+	//
+
+	// All the flags
+	std::uint64_t flags = 0;
+
+	// ID
+	int ID = 0;
+
+	// Earliest time of any of the common timed transitions
+	double next_timed_transition = std::numeric_limits<double>::infinity();
+
+	// Infectiousness variability parameter
+	double inf_var = -1.0;
 
 	// Time of transition from recovered to susceptible 
 	double time_RH2S = 0.0;
@@ -427,110 +533,51 @@ private:
 	// Start home isolation for flu agents
 	// before getting tested
 	double time_flu_ih = 0.0;
+	// Contact tracing
+	double end_of_quarantine = 0.0;
+	double end_of_memory = 0.0;
 
-	// ID
-	int ID = 0;
-
-	// Location
-	double x = 0.0, y = 0.0;
-
-	// Household ID
+	// Household, school, and work related IDs 
 	int house_ID = -1;
-	// Hospital patient with something else than COVID
-	bool is_non_covid_patient = false;
-
-	// School and work related IDs and types
 	int school_ID = -1;
 	int work_ID = -1;
 	int hospital_ID = -1;
 	int carpool_ID = -1;
 	int public_transit_ID = -1;
 	int leisure_location_ID = 0;	
+	LeisureType leisure_type = LeisureType::none;
+
+	//
+	// Cold data - used only at setup, output, or
+	// in specific states
+	//
+
+	int age = 0;
+	// Location
+	double x = 0.0, y = 0.0;
 	int agent_school_type = -1; 
 	double work_travel_time = -1;
-	bool works_at_hospital = false;
-	bool worksRH = false;
-	bool worksSch = false;
-	bool livesRH = false;
-	bool works_remotely = false;
-	std::string work_travel_mode = {};
-	std::string leisure_type;
-	std::string occupation = "None";
+	TravelMode work_travel_mode = TravelMode::none;
+	Occupation occupation = Occupation::none;
 	double occupation_beta = 0.0;
 
-	// Infection status
-	bool is_infected = false;
-
 	// Ratio of distances with infected and all distances
 	double dist_ratio = 0.0;
 
-	// State information
-	bool is_exposed = false;
-	// Recovering without ever developing symptoms
-	bool is_recovering_exposed = false;
-	bool is_symptomatic = false;
-	bool is_symptomatic_non_covid = false;
-	bool is_removed_dead = false;
-	bool is_removed_recovered = false;
-	bool is_former_suspected = false; 
-	// Testing results
-	bool is_tested_covid_negative = false;
-	bool is_tested_false_negative = false;
-	bool is_tested_false_positive = false;
-	bool is_tested_covid_positive = false;
-	// Testing phases and types
-	bool is_tested = false;
-	bool is_tested_in_car = false;
-	bool is_tested_in_hospital = false;
-	bool is_tested_awaiting_results = false;
-	bool is_tested_awaiting_test = false;
-	bool is_tested_exposed = false;
-	bool is_testing_since_exposed = false;
-	// Treatment types
-	bool is_treated = false;
-	bool is_home_isolated = false;
-	bool is_hospitalized = false;
-	bool is_hospitalized_ICU = false;
-	// Contact tracing
-	bool is_contact_traced = false;
-	double end_of_quarantine = 0.0;
-	double end_of_memory = 0.0;
-	// Removal
-	bool will_die = false;
-	bool will_recover = false;
-	bool is_removed = false;
-	bool will_be_hospitalized = false;
-	bool will_be_in_ICU = false;
-	bool will_be_home_isolated = false;
 	// Vaccinations
-	bool is_vaccinated = false;
-	bool next_vaccination = false;
-	bool was_removed_can_vaccinate = false;
-	bool was_suspected_can_vaccinate = false;
-	bool is_more_active = false;
-	std::string vaccine_type{"one_dose"};
-	std::string vaccine_subtype{"not set"};
+	VaccineType vaccine_type = VaccineType::one_dose;
+	// ID in VaccineSubtypes of the vaccinations, 0 is "not set"
+	int vaccine_subtype = 0;
 	double time_vac_drop = 0.0;
 	double time_mobility_increase = 0.0;
-
-	// Infectiousness variability parameter
-	double inf_var = -1.0;
-
-	// Time dependency for 1 dose vaccines
-	ThreePartFunction tpf_effectiveness = {0.0};
-	ThreePartFunction tpf_asymptomatic = {1.0};
-	ThreePartFunction tpf_transmission = {1.0};
-	ThreePartFunction tpf_severe = {1.0};
-	ThreePartFunction tpf_death = {1.0};
-	// Time dependency for 2 dose vaccines
-	FourPartFunction fpf_effectiveness = {0.0};
-	FourPartFunction fpf_asymptomatic = {1.0};
-	FourPartFunction fpf_transmission = {1.0};
-	FourPartFunction fpf_severe = {1.0};
-	FourPartFunction fpf_death = {1.0};
 	// Time offset - simulates getting vaccinated
 	// before the simulation start
 	double vac_offset = 0.0;
+	// Shared profile and when it starts, or the agent's own
+	// response allocated only when first set, not both
+	std::shared_ptr<const VaccineResponse> vac_profile;
+	double vac_profile_time = 0.0;
+	VaccineResponsePtr vac_response;
 	
 	//
 	// Private member functions
@@ -545,6 +592,76 @@ private:
  	 * @returns Value of the distance function
 	 */	
 	double distance_function(const double a, const double b, const double dij) const;
+
+	/// Value of a flag
+	bool flag(const Flag which) const 
+		{ return (flags >> static_cast<int>(which)) & 1u; }
+
+	/// Set or clear a flag
+	void set_flag(const Flag which, const bool val)
+	{ 
+		const std::uint64_t mask = std::uint64_t(1) << static_cast<int>(which);
+		flags = val ? (flags | mask) : (flags & ~mask); 
+	}
+
+	/// Set or clear a flag that one of the timed transitions depends on
+	void set_timer_flag(const Flag which, const bool val)
+	{
+		set_flag(which, val);
+		update_next_timed_transition();
+	}
+
+	/// Recompute the earliest time of the common timed transitions
+	void update_next_timed_transition()
+	{
+		double next = std::numeric_limits<double>::infinity();
+		if (removed_recovered()) {
+			next = std::min(next, time_RH2S);
+			if (!removed_can_vaccinate()) {
+				next = std::min(next, time_rec_vac);
+			}
+		}
+		if (vaccinated()) {
+			if (!needs_next_vaccination()) {
+				next = std::min(next, time_vac_drop);
+			}
+			if (!more_active()) {
+				next = std::min(next, time_mobility_increase);
+			}
+		}
+		if (former_suspected() && !suspected_can_vaccinate()) {
+			next = std::min(next, time_rec_vac);
+		}
+		if (contact_traced()) {
+			next = std::min(next, std::min(end_of_quarantine, end_of_memory));
+		}
+		next_timed_transition = next;
+	}
+
+	/// Vaccine response of this agent - own, shared profile, or default if never set
+	const VaccineResponse& vaccine_response() const
+	{
+		static const VaccineResponse default_response;
+		if (vac_profile) {
+			return *vac_profile;
+		}
+		return vac_response.ptr ? *vac_response.ptr : default_response;
+	}
+
+	/// Time at which to evaluate the vaccine response, profiles start at 0
+	double response_time(const double time) const
+		{ return vac_profile ? time - vac_profile_time : time; }
+
+	/// Own vaccine response to modify, created from the shared profile or the defaults if not yet set
+	VaccineResponse& writable_vaccine_response()
+	{
+		if (!vac_response.ptr) {
+			vac_response.ptr.reset(vac_profile ? new VaccineResponse(vac_profile->shifted(vac_profile_time))
+												: new VaccineResponse());
+			vac_profile = nullptr;
+		}
+		return *vac_response.ptr;
+	}
 };
 
 /// Overloaded ostream operator for I/O
@@ -0,0 +1,156 @@
+#ifndef AGENT_ATTRIBUTES_H
+#define AGENT_ATTRIBUTES_H
+
+#include <unordered_map>
+#include "common.h"
+
+/*****************************************************
+ * Agent attributes with a fixed set of values
+ *
+ * Stored as enums and compared as such during the
+ * simulation; names are only parsed when the input
+ * is loaded and produced for output
+ *
+ ******************************************************/
+
+/// Mode of travel to work
+enum class TravelMode : unsigned char { none, car, carpool, public_transit, walk, wfh, other };
+
+/// Type of the leisure location an agent is currently assigned to
+enum class LeisureType : unsigned char { none, household, public_location };
+
+/// Occupation type, as in the agent input
+enum class Occupation : unsigned char { none, A, B, C, D, E };
+
+/// Vaccination regimen
+enum class VaccineType : unsigned char { one_dose, two_doses };
+
+/// Travel mode from its name in the input, throws std::invalid_argument if unknown
+inline TravelMode travel_mode_from_name(const std::string& name)
+{
+	static const std::unordered_map<std::string, TravelMode> modes = {
+		{"", TravelMode::none}, {"None", TravelMode::none}, {"car", TravelMode::car},
+		{"carpool", TravelMode::carpool}, {"public", TravelMode::public_transit},
+		{"walk", TravelMode::walk}, {"wfh", TravelMode::wfh}, {"other", TravelMode::other}};
+	const auto& iter = modes.find(name);
+	if (iter == modes.end()) {
+		throw std::invalid_argument("Unknown work travel mode: " + name);
+	}
+	return iter->second;
+}
+
+/// Name of a travel mode as in the input
+inline std::string travel_mode_name(const TravelMode mode)
+{
+	switch (mode) {
+		case TravelMode::car: return "car";
+		case TravelMode::carpool: return "carpool";
+		case TravelMode::public_transit: return "public";
+		case TravelMode::walk: return "walk";
+		case TravelMode::wfh: return "wfh";
+		case TravelMode::other: return "other";
+		default: return "None";
+	}
+}
+
+/// Leisure type from its name, throws std::invalid_argument if unknown
+inline LeisureType leisure_type_from_name(const std::string& name)
+{
+	if (name == "household") {
+		return LeisureType::household;
+	} else if (name == "public") {
+		return LeisureType::public_location;
+	} else if (name.empty()) {
+		return LeisureType::none;
+	}
+	throw std::invalid_argument("Wrong leisure type: " + name);
+}
+
+/// Name of a leisure type, empty if not assigned
+inline std::string leisure_type_name(const LeisureType type)
+{
+	switch (type) {
+		case LeisureType::household: return "household";
+		case LeisureType::public_location: return "public";
+		default: return "";
+	}
+}
+
+/// Occupation from its name in the input, throws std::invalid_argument if unknown
+inline Occupation occupation_from_name(const std::string& name)
+{
+	static const std::unordered_map<std::string, Occupation> occupations = {
+		{"none", Occupation::none}, {"None", Occupation::none}, {"A", Occupation::A},
+		{"B", Occupation::B}, {"C", Occupation::C}, {"D", Occupation::D}, {"E", Occupation::E}};
+	const auto& iter = occupations.find(name);
+	if (iter == occupations.end()) {
+		throw std::invalid_argument("Unknown occupation type: " + name);
+	}
+	return iter->second;
+}
+
+/// Name of an occupation as in the input
+inline std::string occupation_name(const Occupation occ)
+{
+	switch (occ) {
+		case Occupation::A: return "A";
+		case Occupation::B: return "B";
+		case Occupation::C: return "C";
+		case Occupation::D: return "D";
+		case Occupation::E: return "E";
+		default: return "None";
+	}
+}
+
+/// Vaccine type from its name, throws std::invalid_argument if unknown
+inline VaccineType vaccine_type_from_name(const std::string& name)
+{
+	if (name == "one_dose") {
+		return VaccineType::one_dose;
+	} else if (name == "two_doses") {
+		return VaccineType::two_doses;
+	}
+	throw std::invalid_argument("Unknown vaccine type: " + name);
+}
+
+/// Name of a vaccine type
+inline std::string vaccine_type_name(const VaccineType type)
+	{ return (type == VaccineType::two_doses) ? "two_doses" : "one_dose"; }
+
+/*****************************************************
+ * class: VaccineSubtypes
+ *
+ * Table of vaccine subtype names, agents store
+ * only the ID of their subtype
+ *
+ * Subtypes are named in the vaccination input and
+ * there are only a few of them; IDs are assigned
+ * in order of registration, 0 is "not set"; each
+ * Vaccinations object has its own table
+ *
+ ******************************************************/
+
+class VaccineSubtypes {
+public:
+
+	/// ID of a subtype name, registered if new
+	int get_ID(const std::string& name)
+	{
+		const auto& iter = IDs.find(name);
+		if (iter != IDs.end()) {
+			return iter->second;
+		}
+		names.push_back(name);
+		IDs[name] = names.size() - 1;
+		return names.size() - 1;
+	}
+
+	/// Name of a registered subtype
+	const std::string& get_name(const int ID) const { return names.at(ID); }
+
+private:
+	std::vector<std::string> names = {"not set"};
+	std::unordered_map<std::string, int> IDs = {{"not set", 0}};
+};
+
+#endif
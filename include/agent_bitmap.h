@@ -0,0 +1,96 @@
+#ifndef AGENT_BITMAP_H
+#define AGENT_BITMAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/*****************************************************
+ * class: AgentBitmap
+ *
+ * Set of agent IDs stored as one bit per agent
+ *
+ * Counting and intersecting sets goes through 64
+ * agents at a time; IDs are always retrieved in
+ * increasing order
+ *
+ ******************************************************/
+
+class AgentBitmap {
+public:
+
+	/// Empty set for agents with IDs up to n_agents, larger IDs extend it
+	void reset(const int n_agents = 0) { words.assign((n_agents + 63)/64, 0); }
+
+	/// Add (value true) or remove (value false) an ID
+	void set(const int aID, const bool value)
+	{
+		const int iw = (aID - 1)/64;
+		if (iw >= static_cast<int>(words.size())) {
+			if (!value) {
+				return;
+			}
+			words.resize(iw + 1, 0);
+		}
+		const std::uint64_t mask = std::uint64_t(1) << ((aID - 1) % 64);
+		if (value) {
+			words[iw] |= mask;
+		} else {
+			words[iw] &= ~mask;
+		}
+	}
+
+	/// True if the ID is in the set
+	bool test(const int aID) const
+	{
+		const int iw = (aID - 1)/64;
+		return iw < static_cast<int>(words.size())
+				&& ((words[iw] >> ((aID - 1) % 64)) & 1);
+	}
+
+	/// Number of IDs in the set
+	int count() const
+	{
+		int n = 0;
+		for (const auto& word : words) {
+			n += __builtin_popcountll(word);
+		}
+		return n;
+	}
+
+	/// Number of IDs in both this and the other set
+	int count_common(const AgentBitmap& other) const
+	{
+		int n = 0;
+		const int n_words = common_words(other);
+		for (int i = 0; i < n_words; ++i) {
+			n += __builtin_popcountll(words[i] & other.words[i]);
+		}
+		return n;
+	}
+
+	/// IDs in both this and the other set, in increasing order
+	std::vector<int> common_IDs(const AgentBitmap& other) const
+	{
+		std::vector<int> IDs;
+		const int n_words = common_words(other);
+		for (int i = 0; i < n_words; ++i) {
+			std::uint64_t word = words[i] & other.words[i];
+			while (word) {
+				IDs.push_back(64*i + __builtin_ctzll(word) + 1);
+				// Clear the lowest set bit
+				word &= word - 1;
+			}
+		}
+		return IDs;
+	}
+
+private:
+	// Bit j of word i is the agent with ID 64*i + j + 1
+	std::vector<std::uint64_t> words;
+
+	int common_words(const AgentBitmap& other) const
+		{ return std::min(words.size(), other.words.size()); }
+};
+
+#endif
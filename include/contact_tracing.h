@@ -14,6 +14,7 @@
 #include "places/leisure.h"
 #include "agent.h"
 #include "infection.h"
+#include "deferred_updates.h"
 
 
 /***************************************************** 
@@ -52,8 +53,15 @@ public:
 	/// Return true if a household is fully quarantined
 	bool house_is_isolated(const int hID) const { return is_isolated.at(hID-1); }
 
-	/// Lift household quarantine
-	void reset_house_isolation(const int hID) { is_isolated.at(hID-1) = false; }
+	/// Lift household quarantine, only recorded if the calling thread records deferred updates
+	void reset_house_isolation(const int hID) 
+	{
+		if (DeferredUpdates* rec = DeferredUpdates::recorder()) {
+			rec->record(DeferredUpdates::Type::house_isolation_reset, hID);
+			return;
+		}
+		is_isolated.at(hID-1) = false; 
+	}
 
 	/// Apply isolation to the household of agent aID
 	std::vector<int> isolate_household(const int aID, const Household& household);
@@ -0,0 +1,186 @@
+#ifndef CONTRIBUTION_RECORDS_H
+#define CONTRIBUTION_RECORDS_H
+
+#include <unordered_map>
+#include "agent.h"
+#include "deferred_updates.h"
+#include "places/hospital.h"
+
+/*****************************************************
+ * class: ContributionRecords
+ *
+ * Contributions that each agent currently adds to
+ * the place sums, for updating the sums with only
+ * the difference when agents change
+ *
+ * Contributions of an agent are determined by its
+ * states, places, and infection variability, these
+ * are stored with the contributions; when any of
+ * them changes, the old contributions are subtracted
+ * and the new ones added
+ *
+ * Also tracks the places with any contributions,
+ * only those need the total contribution recomputed
+ * at each step
+ *
+ * Records refer to places by address, so a copy
+ * starts without records and needs to be rebuilt
+ *
+ ******************************************************/
+
+class ContributionRecords {
+public:
+
+	/// Everything that determines contributions of an agent at a time step
+	struct Key {
+		bool contributing = false;
+		std::uint64_t states = 0;
+		// Exposed past the latency and testing at this step
+		bool infectious = false;
+		bool testing = false;
+		double inf_var = 0.0;
+		int house_ID = 0, school_ID = 0, work_ID = 0, hospital_ID = 0;
+		int carpool_ID = 0, public_transit_ID = 0, leisure_ID = 0;
+		LeisureType leisure_type = LeisureType::none;
+
+		bool operator==(const Key& other) const
+		{
+			return contributing == other.contributing && states == other.states
+				&& infectious == other.infectious && testing == other.testing
+				&& inf_var == other.inf_var && house_ID == other.house_ID
+				&& school_ID == other.school_ID && work_ID == other.work_ID
+				&& hospital_ID == other.hospital_ID && carpool_ID == other.carpool_ID
+				&& public_transit_ID == other.public_transit_ID
+				&& leisure_ID == other.leisure_ID && leisure_type == other.leisure_type;
+		}
+		bool operator!=(const Key& other) const { return !(*this == other); }
+	};
+
+	/**
+	 * \brief Key of an agent at a given time
+	 * @param agent - the agent
+	 * @param contributing - false if the agent currently has no contributions
+	 * @param time - current time
+	 */
+	static Key key_of(const Agent& agent, const bool contributing, const double time)
+	{
+		Key key;
+		if (!contributing) {
+			return key;
+		}
+		key.contributing = true;
+		key.states = agent.get_state_flags();
+		key.infectious = time >= agent.get_infectiousness_start_time();
+		key.testing = agent.tested() && (agent.get_time_of_test() <= time)
+						&& agent.tested_awaiting_test();
+		key.inf_var = agent.get_inf_variability_factor();
+		key.house_ID = agent.get_household_ID();
+		key.school_ID = agent.get_school_ID();
+		key.work_ID = agent.get_work_ID();
+		key.hospital_ID = agent.get_hospital_ID();
+		key.carpool_ID = agent.get_carpool_ID();
+		key.public_transit_ID = agent.get_public_transit_ID();
+		key.leisure_ID = agent.get_leisure_ID();
+		key.leisure_type = agent.get_leisure_location_type();
+		return key;
+	}
+
+	ContributionRecords() = default;
+	/// Copies are invalid, places of the copied records belong to the original
+	ContributionRecords(const ContributionRecords&) { }
+	ContributionRecords& operator=(const ContributionRecords&) { invalidate(); return *this; }
+
+	/// Remove all the records, for n_agents agents; place sums need to be reset separately
+	void reset(const int n_agents)
+	{
+		keys.assign(n_agents, Key());
+		contributions.assign(n_agents, {});
+		n_per_place.clear();
+		emptied.clear();
+		is_valid = true;
+	}
+
+	/// Mark the records as out of date, they need to be reset and rebuilt
+	void invalidate() { reset(0); is_valid = false; }
+
+	/// False if the records need to be reset and rebuilt
+	bool valid() const { return is_valid; }
+
+	/// True if the agent's contributions were recorded with a different key
+	bool changed(const int aID, const Key& key) const { return keys.at(aID-1) != key; }
+
+	/**
+	 * \brief Subtract the recorded contributions of an agent and add the new ones
+	 * \details Needs to be called without a deferred updates recorder
+	 * @param aID - agent ID
+	 * @param key - key the new contributions were computed with
+	 * @param new_contributions - recorded place_contribution and
+	 *		hospital_tested changes, other types are ignored
+	 */
+	void replace(const int aID, const Key& key, const std::vector<DeferredUpdates::Update>& new_contributions)
+	{
+		std::vector<DeferredUpdates::Update>& current = contributions.at(aID-1);
+		for (const auto& upd : current) {
+			apply(upd, -1);
+		}
+		current.clear();
+		for (const auto& upd : new_contributions) {
+			if (upd.type == DeferredUpdates::Type::place_contribution
+					|| upd.type == DeferredUpdates::Type::hospital_tested) {
+				apply(upd, 1);
+				current.push_back(upd);
+			}
+		}
+		keys.at(aID-1) = key;
+	}
+
+	/**
+	 * \brief Places whose total contribution needs to be recomputed
+	 * \details Places with any contributions and places that lost all
+	 *		of them since the last call
+	 */
+	std::vector<Place*> places_to_update()
+	{
+		std::vector<Place*> places;
+		places.reserve(n_per_place.size() + emptied.size());
+		for (const auto& place_count : n_per_place) {
+			places.push_back(place_count.first);
+		}
+		for (Place* place : emptied) {
+			if (n_per_place.find(place) == n_per_place.end()) {
+				places.push_back(place);
+			}
+		}
+		emptied.clear();
+		return places;
+	}
+
+private:
+	bool is_valid = false;
+	std::vector<Key> keys;
+	std::vector<std::vector<DeferredUpdates::Update>> contributions;
+	// Number of contributions in each place that has any
+	std::unordered_map<Place*, int> n_per_place;
+	// Places that lost all their contributions
+	std::vector<Place*> emptied;
+
+	/// Add (sign 1) or subtract (sign -1) a contribution
+	void apply(const DeferredUpdates::Update& upd, const int sign)
+	{
+		if (upd.type == DeferredUpdates::Type::place_contribution) {
+			upd.place->add_contribution(sign*upd.value, sign*upd.ID);
+		} else {
+			static_cast<Hospital*>(upd.place)->increase_total_tested(sign*upd.ID);
+		}
+		int& n_place = n_per_place[upd.place];
+		n_place += sign;
+		if (n_place == 0) {
+			// Exactly zero, without round-off left from the subtractions
+			upd.place->reset_contributions();
+			n_per_place.erase(upd.place);
+			emptied.push_back(upd.place);
+		}
+	}
+};
+
+#endif
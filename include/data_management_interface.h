@@ -213,27 +213,43 @@ public:
 	/// Return a const reference to an Agent object vector
 	const std::vector<Agent>& get_vector_of_agents() const { return agents; }
 
-	/// Return a non-const reference to an Agent object vector
-	std::vector<Agent>& vector_of_agents() { return agents; }
+	/// \brief Return a non-const reference to an Agent object vector
+	/// \details Records of the agents are rebuilt once, before they are used next;
+	///		call agents_modified() after changing agents through a kept reference
+	std::vector<Agent>& vector_of_agents() { agents_modified(); return agents; }
+
+	/**
+	 * \brief Mark agents as modified outside of the model 
+	 * \details Call after changing agents through a reference kept from 
+	 *		the non-const getters; state counts and other records of the 
+	 *		agents are rebuilt once, before they are used next
+	 */
+	void agents_modified() { agents_changed = true; states_changed = true; }
+
+	// Places retrieved through the non-const getters below have their 
+	// contributions recomputed in full at the next step
+
 	/// Return a reference to a Hospital object vector
-	std::vector<Hospital>& vector_of_hospitals() { return hospitals; }
+	std::vector<Hospital>& vector_of_hospitals() { places_modifiable = true; return hospitals; }
 	/// Return a reference to a Household object vector
-	std::vector<Household>& vector_of_households() { return households; }
+	std::vector<Household>& vector_of_households() { places_modifiable = true; return households; }
 	/// Return a reference to a RetirementHome object vector
-	std::vector<RetirementHome>& vector_of_retirement_homes() { return retirement_homes; }
+	std::vector<RetirementHome>& vector_of_retirement_homes() { places_modifiable = true; return retirement_homes; }
 	/// Return a reference to a School object vector
-	std::vector<School>& vector_of_schools() { return schools; }
+	std::vector<School>& vector_of_schools() { places_modifiable = true; return schools; }
 	/// Return a reference to a Workplace object vector
-	std::vector<Workplace>& vector_of_workplaces() { return workplaces; }
+	std::vector<Workplace>& vector_of_workplaces() { places_modifiable = true; return workplaces; }
 	/// Return a reference to a vector of carpool objects
-	std::vector<Transit>& vector_of_carpools() { return carpools; }
+	std::vector<Transit>& vector_of_carpools() { places_modifiable = true; return carpools; }
 	/// Return a reference to a vector of public transit objects 
-	std::vector<Transit>& vector_of_public_transit() { return public_transit; }
+	std::vector<Transit>& vector_of_public_transit() { places_modifiable = true; return public_transit; }
 	/// Return a reference to a vector of leisure locations 
-	std::vector<Leisure>& vector_of_leisure_locations() { return leisure_locations; }
+	std::vector<Leisure>& vector_of_leisure_locations() { places_modifiable = true; return leisure_locations; }
 
-	/// Return a reference to an Agent object vector
-	std::vector<Agent>& get_vector_of_agents_non_const()  { return agents; }
+	/// \brief Return a reference to an Agent object vector
+	/// \details Records of the agents are rebuilt once, before they are used next;
+	///		call agents_modified() after changing agents through a kept reference
+	std::vector<Agent>& get_vector_of_agents_non_const() { agents_modified(); return agents; }
 	/// Return a copy of an Agent object vector
 	std::vector<Agent> get_copied_vector_of_agents() const { return agents; }
 	/// Return a copy of a House object vector
@@ -269,6 +285,28 @@ protected:
 	std::vector<Transit> public_transit;
 	std::vector<Leisure> leisure_locations;
 
+	// Counts and lists of agents in each state, updated
+	// with every change of the agent states
+	mutable PopulationStates population_states;
+	// True if agents were modified outside of the model since the 
+	// records of the agents were last rebuilt
+	bool agents_changed = false;
+	// True if the counted states are out of date with such changes
+	mutable bool states_changed = false;
+	// True if places could have been modified outside of the model
+	// since the last step, records of their contributions are then rebuilt
+	bool places_modifiable = false;
+
+	/// Counted states of the agents, recounted first if they are out of date
+	PopulationStates& current_population_states() const
+	{
+		if (states_changed) {
+			population_states.recount(agents);
+			states_changed = false;
+		}
+		return population_states;
+	}
+
 	// Disease toll - total 
 	int n_infected_tot = 0;
 	int n_dead_tot = 0;
@@ -302,17 +340,17 @@ protected:
 	
 	/// Print basic places information to a file
 	template <typename T>
-	void print_places(std::vector<T> places, const std::string fname) const;
+	void print_places(const std::vector<T>& places, const std::string fname) const;
 
 	/// Print all agent IDs in a particular type of place to a file
 	template <typename T>
-	void print_agents_in_places(std::vector<T> places, const std::string fname) const;
+	void print_agents_in_places(const std::vector<T>& places, const std::string fname) const;
 
 };
 
 // Write Place objects
 template <typename T>
-void DataManagementInterface::print_places(std::vector<T> places, const std::string fname) const
+void DataManagementInterface::print_places(const std::vector<T>& places, const std::string fname) const
 {
 	// AbmIO settings
 	std::string delim(" ");
@@ -326,7 +364,7 @@ void DataManagementInterface::print_places(std::vector<T> places, const std::str
 
 // Write agent IDs in Place objects
 template <typename T>
-void DataManagementInterface::print_agents_in_places(std::vector<T> places, const std::string fname) const
+void DataManagementInterface::print_agents_in_places(const std::vector<T>& places, const std::string fname) const
 {
 	// AbmIO settings
 	std::string delim(" ");
@@ -336,7 +374,10 @@ void DataManagementInterface::print_agents_in_places(std::vector<T> places, cons
 	// First collect the data into a nested vector
 	std::vector<std::vector<int>> agents_all_places;
 	for (const auto& place : places){
+		// Registered agents, then visitors
 		std::vector<int> agent_IDs = place.get_agent_IDs();
+		const std::vector<int>& visitor_IDs = place.get_visitor_IDs();
+		agent_IDs.insert(agent_IDs.end(), visitor_IDs.begin(), visitor_IDs.end());
 		// If no agents, store a 0
 		if (agent_IDs.empty())
 			agents_all_places.push_back({0});
@@ -0,0 +1,94 @@
+#ifndef DEFERRED_UPDATES_H
+#define DEFERRED_UPDATES_H
+
+#include "common.h"
+
+class Place;
+
+/*****************************************************
+ * class: DeferredUpdates
+ *
+ * Changes of objects shared between agents that
+ * were requested while agents are processed in
+ * parallel
+ *
+ * While a thread is recording, place memberships
+ * and contributions, flu pools, and household
+ * isolation are not modified, the requests are
+ * stored instead and applied serially, in agent
+ * order, once all the threads finish; this way
+ * the outcome does not depend on the number of
+ * threads
+ *
+ ******************************************************/
+
+class DeferredUpdates {
+public:
+
+	/// Types of changes that can be deferred
+	enum class Type { place_add, place_remove, place_contribution, hospital_tested, 
+					  flu_susceptible_removal, flu_swap, house_isolation_reset, contact_tracing };
+
+	/// Single requested change
+	struct Update {
+		Type type;
+		// Affected place, only for place updates
+		Place* place;
+		// Agent ID, household ID for house_isolation_reset,
+		// number of infected for place_contribution,
+		// number of tested for hospital_tested
+		int ID;
+		// Contribution to the sum, only for place_contribution
+		double value;
+	};
+
+	//
+	// Recording
+	//
+
+	/// Object recording changes requested by the calling thread, nullptr if changes are applied directly
+	static DeferredUpdates* recorder() { return active_recorder(); }
+
+	/**
+	 * \brief Record the changes requested by the calling thread in this object
+	 * \details Lasts until stop_recording() is called from the same thread
+	 */
+	void start_recording() { active_recorder() = this; }
+
+	/// Apply the changes requested by the calling thread directly
+	static void stop_recording() { active_recorder() = nullptr; }
+
+	/**
+	 * \brief Store a requested change
+	 * @param type - type of the change
+	 * @param ID - agent ID, household ID for house isolation reset, 
+	 *		number of infected for place contribution, number of tested
+	 *		for hospital tested
+	 * @param place - place to modify, only for place updates
+	 * @param value - contribution to the sum of the place
+	 */
+	void record(const Type type, const int ID, Place* place = nullptr, const double value = 0.0)
+		{ updates.push_back({type, place, ID, value}); }
+
+	//
+	// Getters
+	//
+
+	/// All the recorded changes, in order of recording
+	const std::vector<Update>& get_updates() const { return updates; }
+
+	/// Remove all the recorded changes
+	void clear() { updates.clear(); }
+
+private:
+	std::vector<Update> updates;
+
+	/// Recorder of the calling thread
+	static DeferredUpdates*& active_recorder()
+	{
+		static thread_local DeferredUpdates* rec = nullptr;
+		return rec;
+	}
+};
+
+#endif
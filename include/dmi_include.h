@@ -19,6 +19,7 @@
 //
 
 #include "agent.h"
+#include "population_states.h"
 #include "common.h"
 #include "./io_operations/abm_io.h"
 #include "./io_operations/load_parameters.h"
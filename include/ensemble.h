@@ -0,0 +1,121 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include "abm.h"
+
+/*****************************************************
+ * class: Ensemble
+ *
+ * Runs multiple independent replicates of the same
+ * simulation setup within a single process
+ *
+ * Each replicate is a separate ABM object set up from
+ * one shared Town, with its own copy of the places and
+ * agents and the mobility probabilities of the Town;
+ * replicates are distributed among a
+ * fixed number of worker threads and each returns its
+ * own time series of main outputs
+ *
+ ******************************************************/
+
+/// Per-step output of a single replicate
+struct ReplicateResults {
+	// Active (currently infected) at each step
+	std::vector<int> active_count;
+	// Cumulative number of infected
+	std::vector<int> infected_count;
+	// Cumulative number of dead
+	std::vector<int> total_dead;
+};
+
+class Ensemble {
+public:
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Creates an Ensemble object for vaccination and reopening studies
+	 * \details Loads the town; each replicate follows the same sequence 
+	 *			as a single simulation driver - simulation_setup, initialize_vac_and_reopening,
+	 *			initialize_active_cases, and then n_steps of transmit_with_vac
+	 *
+	 * @param del_t - time step, days
+	 * @param filename - path of the file with input information
+	 * @param n_steps - number of time steps to simulate in each replicate
+	 * @param ninf0 - number of initially infected - overwriting input file
+	 * @param custom_vac_offsets - read the vac time offsets from file if true
+	 * @param n_town_threads - number of threads for computing the mobility probabilities of the town
+	 */
+	Ensemble(const double del_t, const std::string& filename, const int n_steps,
+				const int ninf0 = 0, const bool custom_vac_offsets = false,
+				const int n_town_threads = 1) :
+				dt(del_t), town(filename, n_town_threads), tmax(n_steps), inf0(ninf0),
+				vac_offsets(custom_vac_offsets) { }
+
+	/**
+	 * \brief Set the seeding parameters applied to every replicate
+	 *
+	 * @param N_act - number of agents with active COVID-19 at the beginning
+	 * @param vac - true if vaccinate agents as part of seeding
+	 * @param N_v - number of agents to vaccinate as part of seeding
+	 * @param no_vac - dont vaccinate in the vaccination and reopening setup
+	 */
+	void set_initial_conditions(const int N_act, const bool vac = false,
+									const int N_v = 0, const bool no_vac = false)
+		{ N_active = N_act; vaccinate = vac; N_vac = N_v; dont_vac = no_vac; }
+
+	/**
+	 * \brief Make the replicates reproducible
+	 * \details Replicate number i is seeded with seed + i, so the results 
+	 *			do not depend on the number of threads
+	 *
+	 * @param seed - base seed of the ensemble
+	 */
+	void set_seed(const std::uint64_t seed) { base_seed = seed; seeded = true; }
+
+	/**
+	 * \brief Run the replicates
+	 * \details Replicates are independent and distributed dynamically
+	 *			among the threads; exceptions thrown in any replicate are
+	 *			rethrown in the calling thread after all the workers finish
+	 *
+	 * @param n_replicates - number of independent simulations
+	 * @param n_threads - number of worker threads, capped by n_replicates
+	 *
+	 * @returns vector of results, index is the replicate number
+	 */
+	std::vector<ReplicateResults> run(const int n_replicates, const int n_threads);
+
+private:
+	// Time step
+	double dt = 1.0;
+	// Read-only input shared by all replicates
+	const Town town;
+	// Number of steps to simulate
+	int tmax = 0;
+	// Number of initially infected
+	int inf0 = 0;
+	// Read the vaccination time offsets from file
+	bool vac_offsets = false;
+
+	// Seeding
+	int N_active = 0;
+	bool vaccinate = false;
+	int N_vac = 0;
+	bool dont_vac = false;
+
+	// Seeding of random number generators
+	bool seeded = false;
+	std::uint64_t base_seed = 0;
+
+	/// Setup and run replicate number irep, storing its time series in res
+	void run_replicate(ReplicateResults& res, const int irep) const;
+};
+
+#endif
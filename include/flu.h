@@ -4,12 +4,18 @@
 #include "common.h"
 #include "testing.h"
 #include "rng.h"
+#include "deferred_updates.h"
+#include "id_set.h"
 
 /***************************************************** 
  * class: Flu 
  * 
  * Manages the susceptible agents that have symptoms
  * from an infection other than COVID  
+ *
+ * Susceptible and flu agents are kept in sets with 
+ * constant time removal and random selection; order
+ * of the IDs changes with removals
  * 
  *****************************************************/
 
@@ -32,6 +38,9 @@ public:
 	/// \brief Specifies the offset in days for the time Flu agents can be tested
 	void set_testing_duration(const double dt) { testing_period = dt; }
 
+	/// \brief Use a reproducible random number generator
+	void set_seed(const std::uint64_t seed) { rng = RNG(seed, RNGPurpose::flu); }
+
 	//
 	//	Flu computations and agent management 
 	//
@@ -47,10 +56,11 @@ public:
 	 * @param index - agent ID (starts with 1)
 	 */
 	void add_susceptible_agent(const int index) 
-		{ susceptible_agent_IDs.push_back(index); }
+		{ susceptible_agent_IDs.insert(index); }
 
 	/**
 	 * \brief Remove a susceptible agent 
+	 * \details Only recorded if the calling thread records deferred updates
 	 * @param index - agent ID (starts with 1)
 	 */
 	void remove_susceptible_agent(const int index);
@@ -59,12 +69,13 @@ public:
 	 * \brief Remove a flu agent 
 	 * @param index - agent ID (starts with 1)
 	 */
-	void remove_flu_agent(const int index);
+	void remove_flu_agent(const int index) { flu_agent_IDs.remove(index); }
 
 	/** 
 	 * \brief Remove recovered from flu, add new chosen randomly
 	 * @param index - agent to be removed from flu
-	 * @return ID of the agent that now has flu
+	 * @return ID of the agent that now has flu, -1 if none left 
+	 *		or if the calling thread records deferred updates
 	 */
 	int swap_flu_agent(const int index);
 
@@ -80,10 +91,10 @@ public:
 	// Getters
 	//
 
-	/// \brief Const reference to susceptible IDs vector
-	const std::vector<int>& get_susceptible_IDs() const { return susceptible_agent_IDs; }
-	/// \brief Const reference to IDs of agents with flu
-	const std::vector<int>& get_flu_IDs() const { return flu_agent_IDs; }
+	/// \brief Const reference to susceptible IDs vector, in no particular order
+	const std::vector<int>& get_susceptible_IDs() const { return susceptible_agent_IDs.get_IDs(); }
+	/// \brief Const reference to IDs of agents with flu, in no particular order
+	const std::vector<int>& get_flu_IDs() const { return flu_agent_IDs.get_IDs(); }
 
 private:
 	// Fraction of the total susceptible population
@@ -99,9 +110,9 @@ private:
 	RNG rng;
 
 	// Susceptible agents
-	std::vector<int> susceptible_agent_IDs;
+	IDSet susceptible_agent_IDs;
 	// Susceptible with flu
-	std::vector<int> flu_agent_IDs;
+	IDSet flu_agent_IDs;
 };
 
 #endif
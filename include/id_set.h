@@ -0,0 +1,88 @@
+#ifndef ID_SET_H
+#define ID_SET_H
+
+#include <algorithm>
+#include <vector>
+
+/*****************************************************
+ * class: IDSet
+ *
+ * Set of agent IDs with constant time insertion,
+ * removal, and access by index
+ *
+ * IDs are stored in a vector and the position of
+ * each ID in a second vector indexed by the ID;
+ * removal moves the last ID in place of the removed
+ * one so the order of IDs changes
+ *
+ ******************************************************/
+
+class IDSet {
+public:
+
+	/// Empty set for agents with IDs up to n_agents, larger IDs extend it
+	void reset(const int n_agents = 0)
+		{ IDs.clear(); position.assign(n_agents, -1); is_sorted = true; }
+
+	/// Insert an ID, nothing if it is already in the set
+	void insert(const int aID)
+	{
+		if (contains(aID)) {
+			return;
+		}
+		if (aID > static_cast<int>(position.size())) {
+			position.resize(aID, -1);
+		}
+		position.at(aID-1) = IDs.size();
+		IDs.push_back(aID);
+		is_sorted = false;
+	}
+
+	/// Remove an ID, nothing if it is not in the set
+	void remove(const int aID)
+	{
+		if (!contains(aID)) {
+			return;
+		}
+		const int pos = position.at(aID-1);
+		IDs.at(pos) = IDs.back();
+		position.at(IDs.back()-1) = pos;
+		IDs.pop_back();
+		position.at(aID-1) = -1;
+		is_sorted = false;
+	}
+
+	/// True if the ID is in the set
+	bool contains(const int aID) const
+		{ return aID <= static_cast<int>(position.size()) && position.at(aID-1) >= 0; }
+
+	/// Number of IDs in the set
+	int size() const { return IDs.size(); }
+	/// True if there are no IDs
+	bool empty() const { return IDs.empty(); }
+	/// ID at an index in [0, size()), order changes with removals
+	int at(const int index) const { return IDs.at(index); }
+	/// IDs in the set, in no particular order
+	const std::vector<int>& get_IDs() const { return IDs; }
+
+	/// IDs in increasing order
+	const std::vector<int>& sorted_IDs()
+	{
+		if (!is_sorted) {
+			std::sort(IDs.begin(), IDs.end());
+			for (int i = 0; i < static_cast<int>(IDs.size()); ++i) {
+				position.at(IDs.at(i)-1) = i;
+			}
+			is_sorted = true;
+		}
+		return IDs;
+	}
+
+private:
+	std::vector<int> IDs;
+	// Index of each agent in IDs, -1 if not in the set
+	std::vector<int> position;
+	bool is_sorted = true;
+};
+
+#endif
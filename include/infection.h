@@ -35,6 +35,14 @@ public:
 	 */
 	Infection(const double del_t) : dt(del_t) { }
 
+	/**
+	 * \brief Creates an Infection object with a reproducible random number generator 
+	 *
+	 * @param del_t - time step 
+	 * @param seed - seed of the random number generator
+	 */
+	Infection(const double del_t, const std::uint64_t seed) : dt(del_t), rng(seed, RNGPurpose::infection) { }
+
 	//
 	// Infection transmission
 	//
@@ -121,6 +129,14 @@ public:
 	int get_int(const int imin, const int imax) 
 		{ return rng.get_random_int(imin, imax); }  
 
+	/// Draw the following numbers from the stream of agent agent_ID at time step step
+	void set_rng_stream(const int agent_ID, const int step) 
+		{ rng.set_stream(agent_ID, step); }
+
+	/// Draw from streams of a different purpose, same key
+	void set_rng_purpose(const RNGPurpose purpose) 
+		{ rng = rng.split(purpose); }
+
 	//
 	// Setters
 	//
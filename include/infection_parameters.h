@@ -0,0 +1,249 @@
+#ifndef INFECTION_PARAMETERS_H
+#define INFECTION_PARAMETERS_H
+
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <utility>
+#include "common.h"
+
+/*****************************************************
+ * class: InfectionParameters
+ *
+ * Infection parameters used while processing
+ * individual agents, resolved from the parameter map
+ * once when the parameters are loaded
+ *
+ * Hot paths read the fields directly instead of
+ * searching the map by name; all the parameters
+ * listed here are required in the input
+ *
+ ******************************************************/
+
+struct InfectionParameters {
+
+	//
+	// Constructors
+	//
+
+	/// Parameters set to 0
+	InfectionParameters() = default;
+
+	/**
+	 * \brief Resolve the parameters from a map of parameter name and value
+	 * \details Throws std::invalid_argument listing all the parameters 
+	 *		missing from the map; names that the model doesn't use are 
+	 *		not checked here, see unknown_parameters()
+	 * @param params - map of all the infection parameters
+	 */
+	explicit InfectionParameters(const std::map<std::string, double>& params)
+	{
+		std::string missing = "";
+		for (const auto& field : fields()) {
+			const auto& iter = params.find(field.first);
+			if (iter == params.end()) {
+				missing += (missing.empty() ? "" : ", ") + field.first;
+			} else {
+				this->*field.second = iter->second;
+			}
+		}
+		if (!missing.empty()) {
+			throw std::invalid_argument("Missing infection parameters: " + missing);
+		}
+	}
+
+	// Infection course
+	double time_from_exposed_to_infectiousness = 0.0;
+	double recovery_time = 0.0;
+	double post_infection_vaccination_lag = 0.0;
+	double post_infection_immunity_duration = 0.0;
+
+	// Testing
+	double fraction_tested_in_hospitals = 0.0;
+	double flu_testing_duration = 0.0;
+	double time_from_decision_to_test = 0.0;
+	double time_from_test_to_results = 0.0;
+	double fraction_false_positive = 0.0;
+	double fraction_false_negative = 0.0;
+
+	// Hospitalization
+	double time_in_ICU = 0.0;
+	double time_in_hospital_after_ICU = 0.0;
+	double time_before_death_to_ICU = 0.0;
+	double time_in_hospital = 0.0;
+
+	// Quarantine and contact tracing
+	double quarantine_duration = 0.0;
+	double quarantine_memory = 0.0;
+	double contact_tracing_compliance = 0.0;
+	double max_contacts_at_workplace = 0.0;
+	double max_contacts_at_school = 0.0;
+	double max_contacts_at_hospital = 0.0;
+	double max_contacts_at_RH = 0.0;
+	double max_contacts_residents_at_RH = 0.0;
+
+	// Leisure
+	double leisure_fraction = 0.0;
+	double vaccinations_mobility_increase_factor = 0.0;
+
+	// Simulation
+	double time_to_start_data_collection = 0.0;
+
+	/**
+	 * \brief Names in a parameter map that no part of the model uses 
+	 * \details Such entries are most likely misspelled names of optional
+	 *		parameters or parameters of older versions of the model
+	 * @param params - map of all the infection parameters
+	 * @return Unknown names, in the order of the map
+	 */
+	static std::vector<std::string> unknown_parameters(const std::map<std::string, double>& params)
+	{
+		std::set<std::string> known = map_parameters();
+		for (const auto& field : fields()) {
+			known.insert(field.first);
+		}
+		std::vector<std::string> unknown;
+		for (const auto& param : params) {
+			if (known.find(param.first) == known.end()) {
+				unknown.push_back(param.first);
+			}
+		}
+		return unknown;
+	}
+
+	/// Print the names in a parameter map that no part of the model uses, they are ignored
+	static void report_unknown(const std::map<std::string, double>& params)
+	{
+		const std::vector<std::string> unknown = unknown_parameters(params);
+		if (unknown.empty()) {
+			return;
+		}
+		std::cout << "Infection parameters: ignoring unknown parameters";
+		for (const auto& name : unknown) {
+			std::cout << (name == unknown.front() ? " - " : ", ") << name;
+		}
+		std::cout << std::endl;
+	}
+
+	/// Name of each parameter in the input and the corresponding field
+	static const std::vector<std::pair<std::string, double InfectionParameters::*>>& fields()
+	{
+		static const std::vector<std::pair<std::string, double InfectionParameters::*>> all_fields = {
+			{"time from exposed to infectiousness", &InfectionParameters::time_from_exposed_to_infectiousness},
+			{"recovery time", &InfectionParameters::recovery_time},
+			{"Post-infection vaccination lag", &InfectionParameters::post_infection_vaccination_lag},
+			{"Post-infection immunity duration", &InfectionParameters::post_infection_immunity_duration},
+			{"fraction tested in hospitals", &InfectionParameters::fraction_tested_in_hospitals},
+			{"flu testing duration", &InfectionParameters::flu_testing_duration},
+			{"time from decision to test", &InfectionParameters::time_from_decision_to_test},
+			{"time from test to results", &InfectionParameters::time_from_test_to_results},
+			{"fraction false positive", &InfectionParameters::fraction_false_positive},
+			{"fraction false negative", &InfectionParameters::fraction_false_negative},
+			{"time in ICU", &InfectionParameters::time_in_ICU},
+			{"time in hospital after ICU", &InfectionParameters::time_in_hospital_after_ICU},
+			{"time before death to ICU", &InfectionParameters::time_before_death_to_ICU},
+			{"time in hospital", &InfectionParameters::time_in_hospital},
+			{"quarantine duration", &InfectionParameters::quarantine_duration},
+			{"quarantine memory", &InfectionParameters::quarantine_memory},
+			{"contact tracing compliance", &InfectionParameters::contact_tracing_compliance},
+			{"max contacts at workplace", &InfectionParameters::max_contacts_at_workplace},
+			{"max contacts at school", &InfectionParameters::max_contacts_at_school},
+			{"max contacts at hospital", &InfectionParameters::max_contacts_at_hospital},
+			{"max contacts at RH", &InfectionParameters::max_contacts_at_RH},
+			{"max contacts residents at RH", &InfectionParameters::max_contacts_residents_at_RH},
+			{"leisure - fraction", &InfectionParameters::leisure_fraction},
+			{"vaccinations - mobility increase factor", &InfectionParameters::vaccinations_mobility_increase_factor},
+			{"time to start data collection", &InfectionParameters::time_to_start_data_collection}
+		};
+		return all_fields;
+	}
+
+	/// \brief Names of the other parameters, read from the map by name
+	/// \details Mostly when the town and the infection are set up, 
+	///		"leisure - max locations" is optional
+	static const std::set<std::string>& map_parameters()
+	{
+		static const std::set<std::string> all_names = {
+			"household transmission rate",
+			"severity correction",
+			"household scaling parameter",
+			"workplace transmission rate",
+			"out-of-town leisure transmission",
+			"fraction estimated infected",
+			"work absenteeism correction",
+			"carpool transmission rate",
+			"public transit current capacity",
+			"public transit beta0",
+			"public transit beta full",
+			"leisure locations transmission rate",
+			"lockdown absenteeism",
+			"RH employee absenteeism factor",
+			"RH employee transmission rate",
+			"RH resident transmission rate",
+			"RH transmission rate of home isolated",
+			"school transmission rate",
+			"school employee absenteeism correction",
+			"school employee transmission rate",
+			"daycare absenteeism correction",
+			"primary and middle school absenteeism correction",
+			"high school absenteeism correction",
+			"college absenteeism correction",
+			"healthcare employees transmission rate",
+			"hospital patients transmission rate",
+			"hospitalized transmission rate",
+			"hospitalized ICU transmission rate",
+			"hospital tested transmission rate",
+			"negative tests fraction",
+			"fraction with flu",
+			"agent variability gamma shape",
+			"agent variability gamma scale",
+			"latency log-normal mean",
+			"latency log-normal standard deviation",
+			"fraction to get tested",
+			"average fraction to get tested",
+			"exposed fraction to get tested",
+			"transmission rate of home isolated",
+			"probability of death in ICU",
+			"probability dying if needing but not admitted to icu",
+			"oth gamma shape",
+			"oth gamma scale",
+			"otd logn mean",
+			"otd logn std",
+			"htd wbl shape",
+			"htd wbl scale",
+			"start testing",
+			"school closure",
+			"lockdown",
+			"reopening phase 1",
+			"reopening phase 2",
+			"reopening phase 3",
+			"fraction of ld businesses",
+			"fraction of phase 1 businesses",
+			"fraction of phase 2 businesses",
+			"fraction of phase 3 businesses",
+			"fraction of phase 4 businesses",
+			"school transmission reduction",
+			"leisure - dr0",
+			"leisure - beta",
+			"leisure - kappa",
+			"leisure - max locations",
+			"leisure - fraction - initial",
+			"leisure - fraction - final",
+			"initially vaccinated",
+			"vaccination rate",
+			"leisure reopening rate",
+			"Maximum number to vaccinate",
+			"maximum number of visits to track",
+			"management science art transmission rate",
+			"service occupation transmission rate",
+			"sales office transmission rate",
+			"construction maintenance transmission rate",
+			"production transportation transmission rate"
+		};
+		return all_names;
+	}
+};
+
+#endif
@@ -2,6 +2,10 @@
 #define MOBILITY_H
 
 #include <cmath>
+#include <memory>
+#include <cstdint>
+#include <string>
+#include <vector>
 #include "io_operations/abm_io.h"
 #include "io_operations/load_parameters.h"
 #include "places/place.h"
@@ -36,6 +40,13 @@ public:
 
 	/**
 	 * \brief Compute and store visiting probabilities for public leisure locations
+	 * \details If the number of locations per household is limited, only the
+	 *		most probable locations of each household are stored with their
+	 *		exact probabilities; the remaining probability is spread uniformly
+	 *		over all other locations; households are split among
+	 *		the threads set with set_number_of_threads; if a cache directory
+	 *		is set, the table is mapped from a matching cache file instead, 
+	 *		or computed and saved there if there is none
 	 *
 	 * @param households - vector of household objects
 	 * @param leisure_locations - vector of public leisure locations
@@ -79,12 +90,62 @@ public:
 	void set_probability_parameters(const double _dr0, const double _beta, const double _kappa)
 		{ dr0 = _dr0; beta = _beta; kappa = _kappa; }
 
+	/**
+	 * \brief Set the probability parameters and the limit of stored locations from the input
+	 * \details "leisure - max locations" is optional; without it all the locations are
+	 *		stored for every household, as a dense households x locations matrix;
+	 *		a limit of K stores 12 bytes per location instead of 8 and draws visits
+	 *		to the other locations from a uniform tail, which only saves memory with
+	 *		little error if the distribution is concentrated on few locations;
+	 *		in New Rochelle (29645 households, 6254 locations, 1.48 GB dense) it is
+	 *		nearly flat - the largest total variation distance from the exact
+	 *		distribution is 0.38 for K = 100, 0.15 for K = 1000 (0.36 GB),
+	 *		and 0.05 for K = 3000 (1.07 GB), so the shipped inputs store all
+	 * @param infection_parameters - infection parameters as loaded from the input
+	 */
+	void set_parameters(const std::map<std::string, double>& infection_parameters);
+
+	/**
+	 * \brief Set the number of threads used for computing the probabilities
+	 * @param n - number of threads, at least 1
+	 */
+	void set_number_of_threads(const int n);
+
+	/**
+	 * \brief Set the directory for cached probability tables
+	 * \details Cache files are named after a hash of the coordinates and 
+	 *		the probability parameters, so one directory can hold tables 
+	 *		of different towns and settings; if the directory is not writable
+	 *		a warning is printed and the table is only computed
+	 * @param dir - path of an existing directory, empty to disable caching
+	 */
+	void set_cache_directory(const std::string& dir) { cache_dir = dir; }
+
+	/**
+	 * \brief Limit the number of locations stored for each household
+	 * @param n_max - number of most probable locations to store, 0 to store all (default),
+	 *		see set_parameters()
+	 */
+	void set_max_locations(const int n_max);
+
 	//
 	// Getters
 	//
 	
-	std::vector<std::vector<double>> get_public_probabilities()
-		{ return public_probabilities; }
+	/// \brief Cumulative visiting probabilities of all the locations, one row per household
+	/// \details Constructed from the stored locations, for output and testing
+	std::vector<std::vector<double>> get_public_probabilities() const;
+
+	/// Number of locations stored for a household
+	int get_number_of_stored_locations(const int house_ID) const
+		{ check_household_ID(house_ID); return public_probabilities->n_stored; }
+
+	/// Path of the cache file for these locations and the current settings, empty if not caching
+	std::string get_cache_file_name(const std::vector<Household>& households,
+				   					const std::vector<Leisure>& leisure_locations) const;
+
+	/// True if the table was mapped from a cache file rather than computed
+	bool loaded_from_cache() const { return public_probabilities->mapping != nullptr; }
 
 	//
 	// IO
@@ -95,19 +156,112 @@ public:
 
 private:
 
-	// Probabilities of each household viting 
-	// a given public leisure location
-	// Outer vector: households, inner: public leisure location
-	std::vector<std::vector<double>> public_probabilities;
+	/**
+	 * \brief Stored visiting probabilities of all the households
+	 * \details Each household stores the same number of locations, 
+	 *		its row starts at (house_ID-1)*n_stored; the arrays are 
+	 *		either owned vectors or a read-only mapped cache file
+	 */
+	struct LeisureTable {
+		LeisureTable() = default;
+		LeisureTable(const LeisureTable&) = delete;
+		LeisureTable& operator=(const LeisureTable&) = delete;
+		~LeisureTable();
+
+		int n_houses = 0;
+		// Number of locations stored per household
+		int n_stored = 0;
+		// Cumulative probabilities of the stored locations, 
+		// the last one in a row is less than 1 if the rest is in the tail
+		const double* cdf = nullptr;
+		// Sorted IDs of the stored locations, nullptr if all are stored
+		const std::int32_t* IDs = nullptr;
+
+		// Storage when computed
+		std::vector<double> cdf_data;
+		std::vector<std::int32_t> ID_data;
+		// Storage when loaded from a cache file
+		void* mapping = nullptr;
+		std::size_t mapping_size = 0;
+	};
+
+	/// Beginning of a cache file, followed by the cdf and then the IDs arrays
+	struct CacheHeader {
+		char magic[8];
+		std::uint64_t key;
+		std::int64_t n_houses;
+		std::int64_t n_leisure;
+		std::int64_t n_stored;
+	};
+
+	// Visiting distributions of public leisure locations
+	// Read-only after construction and shared between copies
+	std::shared_ptr<const LeisureTable> public_probabilities
+			= std::make_shared<const LeisureTable>();
+	// Total number of public leisure locations
+	int n_leisure = 0;
 
 	// Parameters for the probability model
 	double dr0 = 0.0, beta = 0.0, kappa = 0.0;
+	// Maximum number of locations stored per household, 0 for all
+	int max_locations = 0;
+	// Number of threads for computing the probabilities
+	int n_threads = 1;
+	// Directory with cached tables, none if empty
+	std::string cache_dir = "";
+
+	/// Leisure location coordinates in radians, one vector per quantity 
+	struct LeisureCoordinates {
+		std::vector<double> lat;
+		std::vector<double> lon;
+		std::vector<double> cos_lat;
+	};
+
+	/// Visiting probabilities of all the locations from a single household, stored in probs
+	void compute_probabilities(const Place& house, const LeisureCoordinates& coordinates, 
+									std::vector<double>& probs) const;
+
+	/// Compute the table of all households
+	std::shared_ptr<const LeisureTable> compute_table(const std::vector<Household>& households,
+									const std::vector<Leisure>& leisure_locations) const;
+
+	/**
+	 * \brief Store the visiting distribution of a household in its table row
+	 * @param probs - probabilities of all the locations
+	 * @param order - work array of the same size as probs
+	 * @param cdf - beginning of the row of cumulative probabilities
+	 * @param IDs - beginning of the row of stored IDs, nullptr if all are stored
+	 */
+	void create_distribution(const std::vector<double>& probs, std::vector<int>& order,
+								double* cdf, std::int32_t* IDs) const;
+
+	/// Cache key - hash of the coordinates and probability parameters
+	std::uint64_t compute_cache_key(const std::vector<Household>& households,
+									const std::vector<Leisure>& leisure_locations) const;
+
+	/// Path of the cache file for a key, empty if not caching
+	std::string cache_file_name(const std::uint64_t key) const;
+
+	/// Map the table from a cache file, nullptr if missing or not matching the key
+	std::shared_ptr<const LeisureTable> load_table(const std::string& fname, const std::uint64_t key,
+													const int n_houses) const;
+
+	/// Save the table to a cache file, only warns if the file can't be written
+	void save_table(const std::string& fname, const std::uint64_t key, const LeisureTable& table) const;
+
+	/// Throws std::out_of_range if there is no household with this ID in the table
+	void check_household_ID(const int house_ID) const;
+
+	/// ID of the location selected by a uniform random number prob from a household row 
+	int sample_location(const int house_ID, const double prob) const;
 
 	// Computes and returns probabilities based on distance
-	double compute_probability(double dist);
+	double compute_probability(double dist) const;
 
 	// Just Pi
 	double pi = 3.14159265358979323846;
+	// Beginning of every cache file, changes with the file format
+	std::string cache_magic = "ABMMOB01";
 };
 
 #endif
@@ -0,0 +1,170 @@
+#ifndef PLACE_INCIDENCE_H
+#define PLACE_INCIDENCE_H
+
+#include "agent.h"
+#include "places/household.h"
+#include "places/retirement_home.h"
+#include "places/school.h"
+#include "places/workplace.h"
+#include "places/hospital.h"
+#include "places/transit.h"
+#include "places/leisure.h"
+
+/*****************************************************
+ * class: PlaceIncidence
+ *
+ * Places each agent visits in its daily routine -
+ * household, school, work, and transit - and the
+ * weight of each place in the agent's infection
+ * probability, in compressed sparse row format
+ *
+ * The routine is fixed once agents are registered;
+ * with the total contributions of all places copied
+ * into one vector, routine lambda of an agent is a
+ * product of its row and that vector
+ *
+ * Places in each row are in the same order as the
+ * terms of the susceptible lambda computations so
+ * that the sums are exactly the same; leisure and
+ * changes due to isolation or testing are handled
+ * by the transitions
+ *
+ ******************************************************/
+
+class PlaceIncidence {
+public:
+
+	/**
+	 * \brief Build the rows of all the agents
+	 * \details Hospital patients have empty rows, their infection
+	 *		is computed only from the hospital
+	 */
+	void build(const std::vector<Agent>& agents,
+				const std::vector<Household>& households, const std::vector<RetirementHome>& retirement_homes,
+				const std::vector<School>& schools, const std::vector<Workplace>& workplaces,
+				const std::vector<Hospital>& hospitals, const std::vector<Transit>& carpools,
+				const std::vector<Transit>& public_transit, const std::vector<Leisure>& leisure_locations)
+	{
+		// Global index of the first place of each type
+		first_index = {0};
+		for (const int n_places : {households.size(), retirement_homes.size(), schools.size(),
+				workplaces.size(), hospitals.size(), carpools.size(), public_transit.size(),
+				leisure_locations.size()}) {
+			first_index.push_back(first_index.back() + n_places);
+		}
+		lambda.assign(first_index.back(), 0.0);
+
+		row_start.assign(1, 0);
+		place_index.clear();
+		weight.clear();
+		for (const auto& agent : agents) {
+			add_row(agent, workplaces);
+		}
+	}
+
+	/// Copy total contributions of all places, needs to be called after they change
+	void update_lambdas(const std::vector<Household>& households, const std::vector<RetirementHome>& retirement_homes,
+				const std::vector<School>& schools, const std::vector<Workplace>& workplaces,
+				const std::vector<Hospital>& hospitals, const std::vector<Transit>& carpools,
+				const std::vector<Transit>& public_transit, const std::vector<Leisure>& leisure_locations)
+	{
+		copy_lambdas(households, PlaceType::household);
+		copy_lambdas(retirement_homes, PlaceType::retirement_home);
+		copy_lambdas(schools, PlaceType::school);
+		copy_lambdas(workplaces, PlaceType::workplace);
+		copy_lambdas(hospitals, PlaceType::hospital);
+		copy_lambdas(carpools, PlaceType::carpool);
+		copy_lambdas(public_transit, PlaceType::public_transit);
+		copy_lambdas(leisure_locations, PlaceType::leisure);
+	}
+
+	/// Sum of weighted total contributions of all the places in the routine of an agent
+	double routine_lambda(const int aID) const
+	{
+		double lambda_tot = 0.0;
+		const int last = row_start.at(aID);
+		for (int i = row_start.at(aID-1); i < last; ++i) {
+			lambda_tot += weight[i]*lambda[place_index[i]];
+		}
+		return lambda_tot;
+	}
+
+	/// Number of agents with rows
+	int get_number_of_agents() const { return row_start.size() - 1; }
+
+private:
+
+	enum class PlaceType { household, retirement_home, school, workplace,
+							hospital, carpool, public_transit, leisure };
+
+	// Index in lambda of the first place of each type,
+	// last is the total number of places
+	std::vector<int> first_index;
+	// Total contribution of each place
+	std::vector<double> lambda;
+	// Places of agent with ID i are in [row_start[i-1], row_start[i])
+	std::vector<int> row_start;
+	std::vector<int> place_index;
+	std::vector<double> weight;
+
+	/// Add a place to the last row
+	void add_place(const PlaceType type, const int place_ID, const double w = 1.0)
+	{
+		place_index.push_back(first_index.at(static_cast<int>(type)) + place_ID - 1);
+		weight.push_back(w);
+	}
+
+	/// Routine of an agent, in order of the lambda computations in transitions
+	void add_row(const Agent& agent, const std::vector<Workplace>& workplaces)
+	{
+		if (agent.hospital_non_covid_patient()) {
+			// Nothing
+		} else if (agent.retirement_home_resident()) {
+			add_place(PlaceType::retirement_home, agent.get_household_ID());
+		} else {
+			add_place(PlaceType::household, agent.get_household_ID());
+			if (agent.hospital_employee()) {
+				add_place(PlaceType::hospital, agent.get_hospital_ID());
+				if (agent.student()) {
+					add_place(PlaceType::school, agent.get_school_ID());
+				}
+			} else {
+				if (agent.works() && !agent.works_from_home()) {
+					if (agent.retirement_home_employee()) {
+						add_place(PlaceType::retirement_home, agent.get_work_ID());
+					} else if (agent.school_employee()) {
+						add_place(PlaceType::school, agent.get_work_ID());
+					} else if (workplaces.at(agent.get_work_ID()-1).outside_town()) {
+						add_place(PlaceType::workplace, agent.get_work_ID(),
+									agent.get_occupation_transmission());
+					} else {
+						add_place(PlaceType::workplace, agent.get_work_ID());
+					}
+				}
+				if (agent.student()) {
+					add_place(PlaceType::school, agent.get_school_ID());
+				}
+			}
+			if (agent.get_travel_mode() == TravelMode::carpool) {
+				add_place(PlaceType::carpool, agent.get_carpool_ID());
+			}
+			if (agent.get_travel_mode() == TravelMode::public_transit) {
+				add_place(PlaceType::public_transit, agent.get_public_transit_ID());
+			}
+		}
+		row_start.push_back(place_index.size());
+	}
+
+	/// Copy total contributions of places of one type
+	template <typename T>
+	void copy_lambdas(const std::vector<T>& places, const PlaceType type)
+	{
+		const int first = first_index.at(static_cast<int>(type));
+		const int n_places = places.size();
+		for (int i = 0; i < n_places; ++i) {
+			lambda[first + i] = places[i].get_infected_contribution();
+		}
+	}
+};
+
+#endif
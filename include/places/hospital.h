@@ -54,52 +54,59 @@ public:
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_exposed(double inf_var) override 
-		{ lambda_sum += inf_var*beta_employee; ++num_infected; }
+		{ add_contribution(inf_var*beta_employee, 1); }
 
 	/** 
 	 *  \brief Include exposed contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_exposed_patient(double inf_var) 
-		{ lambda_sum += inf_var*beta_non_covid_patient; ++num_infected; }
+		{ add_contribution(inf_var*beta_non_covid_patient, 1); }
 
 	/** 
 	 *  \brief Include symptomatic  contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_symptomatic_patient(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_non_covid_patient; ++num_infected; }
+		{ add_contribution(inf_var*ck*beta_non_covid_patient, 1); }
 
 	/** 
 	 *  \brief Include tested at hospital contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_hospital_tested(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_testee; ++num_infected; }
+		{ add_contribution(inf_var*ck*beta_testee, 1); }
 
 	/** 
 	 *  \brief Include tested at hospital contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_exposed_hospital_tested(double inf_var) 
-		{ lambda_sum += inf_var*beta_testee; ++num_infected; }
+		{ add_contribution(inf_var*beta_testee, 1); }
 
 	/** 
 	 *  \brief Include hospitalized contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_hospitalized(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_hospitalized; ++num_infected; }
+		{ add_contribution(inf_var*ck*beta_hospitalized, 1); }
 
 	/** 
 	 *  \brief Include hospitalized in ICU contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_hospitalized_ICU(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_hospitalized_ICU; ++num_infected;}
-
-	/// \brief Increase number of tested at that time step
-	void increase_total_tested() { n_tested++; }
+		{ add_contribution(inf_var*ck*beta_hospitalized_ICU, 1); }
+
+	/// \brief Increase number of tested at that time step, by n (negative to decrease)
+	void increase_total_tested(const int n = 1) 
+	{
+		if (DeferredUpdates* rec = DeferredUpdates::recorder()) {
+			rec->record(DeferredUpdates::Type::hospital_tested, n, this);
+			return;
+		}
+		n_tested += n; 
+	}
 
   	/// \brief Reset select variables of a place after transmission step
     void reset_contributions() override 
@@ -70,14 +70,14 @@ public:
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_symptomatic_home_isolated(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_ih; ++num_infected; }
+		{ add_contribution(inf_var*ck*beta_ih, 1); }
 
 	/** 
 	 *  \brief Include contribution of an exposed , home isolated agent in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_exposed_home_isolated(double inf_var) 
-		{ lambda_sum += inf_var*beta_ih; ++num_infected; }
+		{ add_contribution(inf_var*beta_ih, 1); }
 
 private:
 	// Household size scaling factor
@@ -39,12 +39,30 @@ public:
 	Leisure(const int leisure_ID, const double xi, const double yi,
 			 const double severity_cor, const double beta,  
 			 const std::string ltype) : 
-			type(ltype), Place(leisure_ID, xi, yi, severity_cor, beta){ }
+			type(ltype), is_outside(ltype == "outside"), 
+			Place(leisure_ID, xi, yi, severity_cor, beta){ }
 
 	//
 	// Infection related computations
 	//
 
+	/** 
+	 *  \brief Include exposed contribution in the sum
+	 *  \details Transmission rate is applied to the total instead, 
+	 *		so the sum stays valid when the rate changes
+	 *	@param inf_var - agent infectiousness variability factor
+	 */
+	void add_exposed(double inf_var) override 
+		{ add_contribution(inf_var, 1); }
+
+	/** 
+	 *  \brief Include symptomatic contribution in the sum
+	 *  \details Transmission rate is applied to the total instead
+	 *	@param inf_var - agent infectiousness variability factor
+	 */
+	void add_symptomatic(double inf_var) override 
+		{ add_contribution(inf_var*ck, 1); }
+
 	/// Calculates and stores probability contribution of infected agents if any 
 	void compute_infected_contribution() override;
 	
@@ -63,8 +81,7 @@ public:
 	//
 	
 	/// True if the leisure location is outside current town
-	bool outside_town() const override 
-		{ return (type == "outside")?(true) : (false); }
+	bool outside_town() const override { return is_outside; }
 
 	/// Lambda for a leisure location outside the modeled town
 	double get_outside_lambda() const { return lam_tot_out; }
@@ -86,6 +103,8 @@ public:
 private:
 	// Leisure location type 
 	std::string type = "none";
+	// True if type is "outside", checked for every agent in each step
+	bool is_outside = false;
 	// Lambda of an outside leisure location
 	double lam_tot_out = 0.0;
 };
@@ -1,7 +1,9 @@
 #ifndef PLACE_H
 #define PLACE_H
 
+#include <unordered_map>
 #include "../common.h"
+#include "../deferred_updates.h"
 
 /***************************************************** 
  * class: Place
@@ -44,14 +46,22 @@ public:
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	virtual void add_exposed(double inf_var) 
-		{ lambda_sum += inf_var*beta_j; ++num_infected; }
+		{ add_contribution(inf_var*beta_j, 1); }
 
 	/** 
 	 *  \brief Include symptomatic contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	virtual void add_symptomatic(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_j; ++num_infected; }
+		{ add_contribution(inf_var*ck*beta_j, 1); }
+
+	/**
+	 *  \brief Add to the sum of contributions and the number of infected 
+	 *  \details Only recorded if the calling thread records deferred updates
+	 *	@param lambda - contribution to the sum
+	 *	@param n_inf - number of infected to add
+	 */
+	void add_contribution(const double lambda, const int n_inf);
 
 	/**
 	 * \brief Calculates and stores fraction of infected agents if any  
@@ -77,14 +87,17 @@ public:
 	/// Return place ID
 	int get_ID() const { return ID; }
 
-	/// Return IDs of agents registered in this place	
-	std::vector<int> get_agent_IDs() const { return agent_IDs; }
+	/// Return IDs of agents registered in this place, valid until agents are added or removed
+	const std::vector<int>& get_agent_IDs() const { return agent_IDs; }
 
 	/// Return total number of infected agents
 	int get_total_infected() const { return num_infected; }
 
-	/// Return total number of agents
-	int get_number_of_agents() const { return agent_IDs.size(); }
+	/// Return IDs of agents visiting this place at the current step
+	const std::vector<int>& get_visitor_IDs() const { return visitor_IDs; }
+
+	/// Return total number of agents, including visitors
+	int get_number_of_agents() const { return agent_IDs.size() + visitor_IDs.size(); }
 
 	/// Return probability contribution of infected agents
 	double get_infected_contribution() const { return lambda_tot; }
@@ -131,16 +144,32 @@ public:
 
 	/**
 	 * \brief Add a new agent to this place
+	 * \details Only recorded if the calling thread records deferred updates
 	 * @param index - agent ID (starts with 1)
 	 */
-	void add_agent(const int index) { agent_IDs.push_back(index); }
+	void add_agent(const int index);
 
 	/**
 	 * \brief Remove an agent from this place
+	 * \details Only recorded if the calling thread records deferred updates;
+	 *		the last agent is moved in place of the removed one, all 
+	 *		entries are removed if the agent was added more than once
 	 * @param index - agent ID (starts with 1)
 	 */
 	void remove_agent(const int index);
 
+	/**
+	 * \brief Add an agent visiting this place at the current step
+	 * \details Households and leisure locations; visitors are kept 
+	 *		apart from the agents in this place and all of them are 
+	 *		removed at once, not deferred
+	 * @param index - agent ID (starts with 1)
+	 */
+	void add_visitor(const int index) { visitor_IDs.push_back(index); }
+
+	/// Remove all the visitors
+	void clear_visitors() { visitor_IDs.clear(); }
+
 	// Virtual dtor - avoid UDB and memory leaks
 	virtual ~Place() = default;
 
@@ -151,7 +180,15 @@ protected:
 	double x = 0.0, y = 0.0;
 	// IDs of agents in this place
 	std::vector<int> agent_IDs;
-	// Total number of agents
+	// Position of each agent in agent_IDs, one entry per position
+	// if added more than once; only places with more than 
+	// slot_index_min agents keep it, others are searched directly
+	std::unordered_multimap<int, int> agent_slots;
+	static const int slot_index_min = 32;
+	// IDs of agents visiting at the current step
+	std::vector<int> visitor_IDs;
+	// Total number of agents when the contribution was last computed,
+	// places without contributions are not always computed
 	int num_tot = 0;
 	// Total number of infected
 	int num_infected = 0;
@@ -169,6 +206,13 @@ protected:
 
 	// Ratio of infected agents
 	double inf_ratio = 0.0;	
+
+	/// Store agent ID with its position
+	void insert_agent_ID(const int index);
+	/// Lowest position of an agent in agent_IDs, -1 if not in this place
+	int agent_position(const int index) const;
+	/// Remove one stored position of an agent
+	void erase_slot(const int index, const int pos);
 };
 
 /// Overloaded ostream operator for I/O
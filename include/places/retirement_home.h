@@ -52,28 +52,28 @@ public:
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_exposed_employee(double inf_var) 
-		{ lambda_sum += inf_var*beta_emp; ++num_infected; }
+		{ add_contribution(inf_var*beta_emp, 1); }
 
 	/** 
 	 *  \brief Include symptomatic employee contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_symptomatic_employee(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_emp*psi_emp; ++num_infected; }
+		{ add_contribution(inf_var*ck*beta_emp*psi_emp, 1); }
 
 	/** 
 	 *  \brief Include contribution of a symptomatic, home isolated agent in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_symptomatic_home_isolated(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_ih; ++num_infected;}
+		{ add_contribution(inf_var*ck*beta_ih, 1); }
 
 	/** 
 	 *  \brief Include contribution of an exposed, home isolated agent in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_exposed_home_isolated(double inf_var) 
-		{ lambda_sum += inf_var*beta_ih; ++num_infected; }
+		{ add_contribution(inf_var*beta_ih, 1); }
 	
 	//
 	// Getters
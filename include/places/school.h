@@ -50,21 +50,21 @@ public:
 	 *  \brief Include exposed employee contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
-	void add_exposed_employee(double inf_var) { lambda_sum += inf_var*beta_emp; ++num_infected; }
+	void add_exposed_employee(double inf_var) { add_contribution(inf_var*beta_emp, 1); }
 
 	/** 
 	 *  \brief Include symptomatic employee contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_symptomatic_employee(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_emp*psi_emp; ++num_infected; }
+		{ add_contribution(inf_var*ck*beta_emp*psi_emp, 1); }
 
 	/** 
 	 *  \brief Include symptomatic student contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
 	void add_symptomatic_student(double inf_var) 
-		{ lambda_sum += inf_var*ck*beta_j*psi_j; ++num_infected; }
+		{ add_contribution(inf_var*ck*beta_j*psi_j, 1); }
 
 	//
 	// Setters
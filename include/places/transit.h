@@ -48,14 +48,14 @@ public:
 	 *  \brief Include symptomatic contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
-	void add_symptomatic(double inf_var) override { lambda_sum += inf_var*ck*beta_j*psi_j; }
+	void add_symptomatic(double inf_var) override { add_contribution(inf_var*ck*beta_j*psi_j, 0); }
 
 	/** 
 	 *  \brief Include symptomatic contribution in the sum with non-default absenteeism correction
 	 *	@param inf_var - agent infectiousness variability factor
 	 *  @param psi - absenteeism correction for that agent's category
 	 */
-	void add_special_symptomatic(const double inf_var, const double psi) { lambda_sum += inf_var*ck*beta_j*psi; }
+	void add_special_symptomatic(const double inf_var, const double psi) { add_contribution(inf_var*ck*beta_j*psi, 0); }
 
 	//
 	// Setters
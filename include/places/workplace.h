@@ -39,7 +39,8 @@ public:
 	Workplace(const int work_ID, const double xi, const double yi,
 			 const double severity_cor, const double psi, const double beta, 
 			 const std::string wtype) : 
-			psi_j(psi), type(wtype), Place(work_ID, xi, yi, severity_cor, beta){ }
+			psi_j(psi), type(wtype), is_outside(wtype == "outside"), 
+			Place(work_ID, xi, yi, severity_cor, beta){ }
 
 	//
 	// Infection related computations
@@ -49,7 +50,7 @@ public:
 	 *  \brief Include symptomatic contribution in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
-	void add_symptomatic(double inf_var) override { lambda_sum += inf_var*ck*beta_j*psi_j; }
+	void add_symptomatic(double inf_var) override { add_contribution(inf_var*ck*beta_j*psi_j, 0); }
 
 	
 	/// Calculates and stores probability contribution of infected agents if any 
@@ -74,8 +75,7 @@ public:
 	double get_absenteeism_correction() const { return psi_j; }
 	
 	/// True if the workplace is outside current town
-	bool outside_town() const override 
-		{ return (type == "outside")?(true) : (false); }
+	bool outside_town() const override { return is_outside; }
 
 	/// Lambda for a workplace outside the modeled town
 	double get_outside_lambda() const { return lam_tot_out; }
@@ -102,6 +102,8 @@ private:
 	double psi_j = 0.0;
 	// Workplace type 
 	std::string type = "none";
+	// True if type is "outside", checked for every agent in each step
+	bool is_outside = false;
 	// Lambda of an outside workplace
 	double lam_tot_out = 0.0;
 };
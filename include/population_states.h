@@ -0,0 +1,151 @@
+#ifndef POPULATION_STATES_H
+#define POPULATION_STATES_H
+
+#include "agent.h"
+#include "common.h"
+#include "id_set.h"
+
+/*****************************************************
+ * class: PopulationStates
+ *
+ * Number of agents in the states reported every
+ * time step and lists of agents in the states that
+ * the simulation iterates over
+ *
+ * Stores the counted states of each agent and is
+ * updated only for agents whose states may have
+ * changed, so that the counts and the lists don't
+ * require going through the whole population
+ *
+ ******************************************************/
+
+class PopulationStates {
+public:
+
+	/**
+	 * \brief Count states of all the agents, replacing the previous counts
+	 * \details Agent IDs need to be consecutive and start with 1
+	 * @param agents - vector of all the agents
+	 */
+	void recount(const std::vector<Agent>& agents)
+	{
+		const int n_agents = agents.size();
+		counted.assign(n_agents, 0);
+		n_active = 0;
+		n_treated = {0, 0, 0};
+		for (auto set : {&infected, &exposed, &symptomatic, &contributing}) {
+			set->reset(n_agents);
+		}
+		for (const auto& agent : agents) {
+			update(agent);
+		}
+	}
+
+	/// Update the counts and the lists with current states of the agent
+	void update(const Agent& agent)
+	{
+		const int aID = agent.get_ID();
+		const unsigned char old_states = counted.at(aID-1);
+		const unsigned char new_states = states_of(agent);
+		if (old_states == new_states) {
+			return;
+		}
+		const unsigned char added = new_states & ~old_states;
+		const unsigned char removed = old_states & ~new_states;
+		change(infected, aID, added & INFECTED, removed & INFECTED);
+		change(exposed, aID, added & EXPOSED, removed & EXPOSED);
+		change(symptomatic, aID, added & SYMPTOMATIC, removed & SYMPTOMATIC);
+		change(contributing, aID, added & CONTRIBUTING, removed & CONTRIBUTING);
+		n_active += ((added & ACTIVE) ? 1 : 0) - ((removed & ACTIVE) ? 1 : 0);
+		const unsigned char treatments[3] = {HOME_ISOLATED, HOSPITALIZED, HOSPITALIZED_ICU};
+		for (int i = 0; i < 3; ++i) {
+			n_treated.at(i) += ((added & treatments[i]) ? 1 : 0) - ((removed & treatments[i]) ? 1 : 0);
+		}
+		counted.at(aID-1) = new_states;
+	}
+
+	//
+	// Getters
+	//
+
+	/// Number of infected agents
+	int get_num_infected() const { return infected.size(); }
+	/// Number of exposed agents
+	int get_num_exposed() const { return exposed.size(); }
+	/// Number of symptomatic agents
+	int get_num_symptomatic() const { return symptomatic.size(); }
+	/// Number of infected - confirmed, including the false positive
+	int get_num_active_cases() const { return n_active; }
+	/// Number of home isolated | hospitalized | hospitalized in an ICU
+	std::vector<int> get_treatment_data() const { return n_treated; }
+
+	/// IDs of infected agents, in no particular order
+	const std::vector<int>& get_infected_IDs() const { return infected.get_IDs(); }
+	/// IDs of exposed agents, in no particular order
+	const std::vector<int>& get_exposed_IDs() const { return exposed.get_IDs(); }
+	/// IDs of symptomatic agents, in no particular order
+	const std::vector<int>& get_symptomatic_IDs() const { return symptomatic.get_IDs(); }
+
+	/**
+	 * \brief IDs of agents that can contribute to infection in places, sorted
+	 * \details These are agents that are not dead and are either infected
+	 *		or susceptible and waiting for a test in a hospital
+	 */
+	const std::vector<int>& get_contributing_IDs() { return contributing.sorted_IDs(); }
+
+private:
+
+	// Counted states of each agent, as bits
+	enum : unsigned char { INFECTED = 1, EXPOSED = 2, SYMPTOMATIC = 4, ACTIVE = 8,
+		HOME_ISOLATED = 16, HOSPITALIZED = 32, HOSPITALIZED_ICU = 64, CONTRIBUTING = 128 };
+
+	std::vector<unsigned char> counted;
+	IDSet infected, exposed, symptomatic, contributing;
+	int n_active = 0;
+	std::vector<int> n_treated = {0, 0, 0};
+
+	/// Insert the ID into or remove it from a set as requested
+	static void change(IDSet& set, const int aID, const bool insert, const bool remove)
+	{
+		if (insert) {
+			set.insert(aID);
+		} else if (remove) {
+			set.remove(aID);
+		}
+	}
+
+	/// States of an agent as counted here
+	static unsigned char states_of(const Agent& agent)
+	{
+		unsigned char states = 0;
+		if (agent.infected()) {
+			states |= INFECTED;
+		}
+		if (agent.exposed()) {
+			states |= EXPOSED;
+		}
+		if (agent.symptomatic()) {
+			states |= SYMPTOMATIC;
+		}
+		if ((agent.infected() && agent.tested_covid_positive())
+				|| (agent.symptomatic_non_covid() && agent.home_isolated()
+					&& agent.tested_false_positive())) {
+			states |= ACTIVE;
+		}
+		// Treatments are counted in this order of priority
+		if (agent.home_isolated()) {
+			states |= HOME_ISOLATED;
+		} else if (agent.hospitalized()) {
+			states |= HOSPITALIZED;
+		} else if (agent.hospitalized_ICU()) {
+			states |= HOSPITALIZED_ICU;
+		}
+		if (!agent.removed_dead() && (agent.infected() || (agent.tested()
+				&& agent.tested_in_hospital() && agent.tested_awaiting_test()))) {
+			states |= CONTRIBUTING;
+		}
+		return states;
+	}
+};
+
+#endif
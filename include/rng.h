@@ -2,18 +2,134 @@
 #define RNG_H
 
 #include <random>
+#include <array>
+#include <cstdint>
 
-/***************************************************** 
+/*****************************************************
+ * class: Philox4x32
+ *
+ * Counter-based random bit generator (Philox4x32-10,
+ * Salmon et al., SC11)
+ *
+ * Output is a pure function of a 64 bit key and a
+ * 128 bit counter; the first counter word is the
+ * position within a stream and the remaining three
+ * select the stream, so any stream can be reached
+ * directly without generating the preceding numbers
+ *
+ *****************************************************/
+
+class Philox4x32
+{
+public:
+	typedef std::uint32_t result_type;
+
+	/// Creates an engine with a given key, positioned at the beginning of stream (0,0,0)
+	explicit Philox4x32(const std::uint64_t seed = 0) { set_key(seed); }
+
+	/// Set the key and rewind to the beginning of the current stream
+	void set_key(const std::uint64_t seed)
+	{
+		key = {{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}};
+		ctr.at(0) = 0;
+		pos = 4;
+	}
+
+	/// Move to the beginning of the stream identified by the three words
+	void set_stream(const std::uint32_t s1, const std::uint32_t s2, const std::uint32_t s3)
+	{
+		ctr = {{0, s1, s2, s3}};
+		pos = 4;
+	}
+
+	/// Next 32 random bits
+	result_type operator()()
+	{
+		if (pos == 4) {
+			block = generate_block(ctr, key);
+			++ctr.at(0);
+			pos = 0;
+		}
+		return block[pos++];
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 0xFFFFFFFF; }
+
+	/// Ten rounds of Philox bijection applied to a counter
+	static std::array<std::uint32_t, 4> generate_block(std::array<std::uint32_t, 4> c,
+														std::array<std::uint32_t, 2> k)
+	{
+		for (int r = 0; r < 10; ++r) {
+			if (r > 0) {
+				k[0] += 0x9E3779B9;
+				k[1] += 0xBB67AE85;
+			}
+			const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53)*c[0];
+			const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57)*c[2];
+			c = {{static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<std::uint32_t>(p1),
+				  static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<std::uint32_t>(p0)}};
+		}
+		return c;
+	}
+
+private:
+	std::array<std::uint32_t, 2> key = {{0, 0}};
+	std::array<std::uint32_t, 4> ctr = {{0, 0, 0, 0}};
+	// Current block of output and position in it
+	std::array<std::uint32_t, 4> block = {{0, 0, 0, 0}};
+	int pos = 4;
+};
+
+/// Independent uses of random numbers, each draws from its own streams
+enum class RNGPurpose : std::uint32_t { infection = 0, flu = 1, transitions = 2 };
+
+/*****************************************************
  * class: RNG
- * 
- * Random number generator 
- * 
+ *
+ * Random number generator
+ *
+ * Seeded generators are reproducible; the stream
+ * is selected by agent ID, time step, and purpose
+ *
  *****************************************************/
 
 class RNG
 {
 public:
-    RNG() : gen(std::random_device()()) { } 
+	/// Generator with a random seed
+    RNG() : gen(random_seed()) { }
+
+	/**
+	 *	\brief Generator with a fixed seed
+	 *	@param seed - run seed
+	 *	@param purpose - what the numbers are used for, determines the default stream
+	 */
+	RNG(const std::uint64_t seed, const RNGPurpose purpose = RNGPurpose::infection) :
+		gen(seed), rng_purpose(purpose) { set_stream(0, 0); }
+
+	/**
+	 *	\brief Move to the beginning of an independent stream
+	 *	@param agent_ID - ID of the agent the numbers are drawn for, 0 if none
+	 *	@param step - time step number
+	 */
+	void set_stream(const int agent_ID, const int step)
+	{
+		gen.set_stream(static_cast<std::uint32_t>(agent_ID), static_cast<std::uint32_t>(step),
+						static_cast<std::uint32_t>(rng_purpose));
+	}
+
+	/**
+	 *	\brief Copy of this generator that draws from streams of a different purpose
+	 *	@param purpose - new purpose
+	 */
+	RNG split(const RNGPurpose purpose) const
+	{
+		RNG new_rng(*this);
+		new_rng.rng_purpose = purpose;
+		new_rng.set_stream(0, 0);
+		return new_rng;
+	}
 
 	/**
 	 *	\brief Random number sampled from uniform distribution
@@ -21,7 +137,7 @@ public:
 	 *	@param dmax - maximum, exclusive
 	 */
     double get_random(const double dmin, const double dmax)
-	{  
+	{
         std::uniform_real_distribution<double> dist(dmin, dmax);
         return dist(gen);
     }
@@ -32,29 +148,29 @@ public:
 	 *	@param dmax - maximum, inclusive
 	 */
     int get_random_int(const int dmin, const int dmax)
-	{  
+	{
         std::uniform_int_distribution<int> dist(dmin, dmax);
         return dist(gen);
     }
 
 	/**
 	 *	\brief Random number sampled from a gamma distribution
-	 *	@param k - shape parameter 
-	 *	@param theta - scale parameter 
+	 *	@param k - shape parameter
+	 *	@param theta - scale parameter
 	 */
     double get_random_gamma(const double k, const double theta)
-	{  
+	{
         std::gamma_distribution<double> dist(k, theta);
         return dist(gen);
     }
 
 	/**
 	 *	\brief Random number sampled from a lognormal distribution
-	 *	@param m - mean 
-	 *	@param s - standard deviation 
+	 *	@param m - mean
+	 *	@param s - standard deviation
 	 */
     double get_random_lognormal(const double m, const double s)
-	{  
+	{
         std::lognormal_distribution<double> dist(m, s);
         return dist(gen);
     }
@@ -62,29 +178,37 @@ public:
 	/**
 	 *	\brief Random number sampled from a Weibull distribution
 	 *	@param a - shape parameter
-	 *	@param b - scale parameter 
+	 *	@param b - scale parameter
 	 */
     double get_random_weibull(const double a, const double b)
-	{  
+	{
         std::weibull_distribution<double> dist(a, b);
         return dist(gen);
     }
 
 	/// Performs in-place random shuffling of a vector
 	void vector_shuffle(std::vector<int>& v)
-	{ 
+	{
 		std::shuffle(v.begin(), v.end(), gen);
 	}
 
 	/// Performs in-place random shuffling of a vector
 	// Yes, this should be templated
 	void vector_shuffle(std::vector<double>& v)
-	{ 
+	{
 		std::shuffle(v.begin(), v.end(), gen);
 	}
 
 private:
-    std::mt19937 gen;
+    Philox4x32 gen;
+	RNGPurpose rng_purpose = RNGPurpose::infection;
+
+	/// 64 bit seed from the system entropy source
+	static std::uint64_t random_seed()
+	{
+		std::random_device rd;
+		return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+	}
 };
 
 #endif
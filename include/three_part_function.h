@@ -40,7 +40,28 @@ public:
 			s_dec(0), i_dec(val), y1(val) { } 
 
 	/// Value of the function at t
-	double operator()(const double t) { return y_value(t); }	
+	double operator()(const double t) const { return y_value(t); }	
+
+	/**
+	 * \brief Values at one time of copies of the function started at different times
+	 * \details Same values as the function at time - start, computed 
+	 *		without branches so that the loop vectorizes
+	 *
+	 * @param starts - times added to all ts of each copy
+	 * @param time - time at which to evaluate
+	 * @param values - values of the copies, resized to the number of starts
+	 */
+	void evaluate(const std::vector<double>& starts, const double time, 
+					std::vector<double>& values) const;
+
+	/**
+	 * \brief Copy of the function with all ts moved by an offset
+	 * \details Same as creating it from the points with the offset
+	 *		added; constant functions are the same at all times
+	 *
+	 * @param offset - added to all ts
+	 */
+	ThreePartFunction shifted(const double offset) const;
 private:
 	/// Calculate slopes and intercepts
 	void setup_properties();
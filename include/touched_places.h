@@ -0,0 +1,80 @@
+#ifndef TOUCHED_PLACES_H
+#define TOUCHED_PLACES_H
+
+#include <algorithm>
+#include "deferred_updates.h"
+#include "places/place.h"
+
+/*****************************************************
+ * class: TouchedPlaces
+ *
+ * Places that received contributions since their
+ * sums were last reset
+ *
+ * Only these places need the total contribution
+ * recomputed and the sums reset; all other places
+ * keep zero sums and zero total contribution. Places
+ * outside the town have a total contribution that
+ * doesn't depend on agents, they are always included
+ *
+ * Places are stored by address, so a copy starts
+ * without the list and all places need to be reset
+ *
+ ******************************************************/
+
+class TouchedPlaces {
+public:
+
+	TouchedPlaces() = default;
+	/// Copies are invalid, stored places belong to the original
+	TouchedPlaces(const TouchedPlaces&) { }
+	TouchedPlaces& operator=(const TouchedPlaces&) { invalidate(); return *this; }
+
+	/**
+	 * \brief Start tracking, all the sums need to be reset at this point
+	 * @param always_touched - places that are always included
+	 */
+	void reset(const std::vector<Place*>& always_touched)
+	{
+		always = always_touched;
+		places = always;
+		is_valid = true;
+	}
+
+	/// Stop tracking, all the places need to be reset and recomputed
+	void invalidate() { always.clear(); places.clear(); is_valid = false; }
+
+	/// False if places were modified without tracking
+	bool valid() const { return is_valid; }
+
+	/// Add the places that recorded contributions or tests modify
+	void add(const std::vector<DeferredUpdates>& updates)
+	{
+		for (const auto& worker_updates : updates) {
+			for (const auto& upd : worker_updates.get_updates()) {
+				if (upd.type == DeferredUpdates::Type::place_contribution
+						|| upd.type == DeferredUpdates::Type::hospital_tested) {
+					places.push_back(upd.place);
+				}
+			}
+		}
+	}
+
+	/// All the touched places, each once
+	const std::vector<Place*>& get_places()
+	{
+		std::sort(places.begin(), places.end());
+		places.erase(std::unique(places.begin(), places.end()), places.end());
+		return places;
+	}
+
+	/// Start over after the sums of all the touched places were reset
+	void clear() { places = always; }
+
+private:
+	bool is_valid = false;
+	std::vector<Place*> places;
+	std::vector<Place*> always;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef TOWN_H
+#define TOWN_H
+
+#include "common.h"
+#include "./io_operations/abm_io.h"
+#include "./io_operations/load_parameters.h"
+#include "agent.h"
+#include "places/household.h"
+#include "places/retirement_home.h"
+#include "places/school.h"
+#include "places/workplace.h"
+#include "places/hospital.h"
+#include "places/transit.h"
+#include "places/leisure.h"
+#include "mobility.h"
+#include "infection_parameters.h"
+
+/*****************************************************
+ * class: Town
+ *
+ * Read-only input of a simulation that does not
+ * change after setup
+ *
+ * Stores the input file names, the base infection
+ * parameters, the places and agents created from
+ * the input files, and the leisure mobility
+ * probabilities
+ *
+ * Places and agents are created once and copied
+ * into every ABM set up from this object, without 
+ * parsing the files again; each ABM holds its own 
+ * copy, including coordinates, memberships, and 
+ * agent demographics, so their memory is paid once 
+ * per replicate. Only the mobility probabilities 
+ * are shared, multiple replicates hold a single copy
+ *
+ ******************************************************/
+
+class Town {
+public:
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Creates a Town object from the simulation input
+	 * \details Creates the places and agents from all the files listed 
+	 *		in the input file and computes the mobility probabilities; if the 
+	 *		input lists a "Mobility cache directory", the probabilities are loaded 
+	 *		from a cache file there when one matches the town and parameters
+	 *
+	 * @param filename - path of the file with input information, same as in ABM::simulation_setup
+	 * @param n_threads - number of threads for computing the mobility probabilities
+	 */
+	Town(const std::string& filename, const int n_threads = 1);
+
+	//
+	// Getters
+	//
+
+	/// Tag - file name pairs from the input file
+	const std::map<std::string, std::string>& get_setup_files() const
+		{ return setup_files; }
+
+	/// Infection parameters as loaded from file
+	const std::map<std::string, double>& get_infection_parameters() const
+		{ return infection_parameters; }
+
+	/// Places as created from the input, without agents 
+	const std::vector<Household>& get_households() const { return households; }
+	const std::vector<RetirementHome>& get_retirement_homes() const { return retirement_homes; }
+	const std::vector<School>& get_schools() const { return schools; }
+	const std::vector<Workplace>& get_workplaces() const { return workplaces; }
+	const std::vector<Hospital>& get_hospitals() const { return hospitals; }
+	const std::vector<Transit>& get_carpools() const { return carpools; }
+	const std::vector<Transit>& get_public_transit() const { return public_transit; }
+	const std::vector<Leisure>& get_leisure_locations() const { return leisure_locations; }
+
+	/// Agents as created from the input, infected as in the input file and not in places yet
+	const std::vector<Agent>& get_agents() const { return agents; }
+
+	/// Mobility object with the shared leisure probabilities
+	const Mobility& get_mobility() const { return mobility; }
+
+	//
+	// Creation from loaded file content
+	//
+
+	/**
+	 * \brief Create places of one type, one per line of the file
+	 * \details Transmission rates are taken from the infection parameters, 
+	 *		rates of places outside of the town are set by the ABM
+	 * @param file - loaded content of the file with the places
+	 * @param infection_parameters - parameters as loaded from file, by name
+	 */
+	static std::vector<Household> create_households(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+	static std::vector<RetirementHome> create_retirement_homes(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+	static std::vector<School> create_schools(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+	static std::vector<Workplace> create_workplaces(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+	static std::vector<Hospital> create_hospitals(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+	static std::vector<Transit> create_carpools(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+	static std::vector<Transit> create_public_transit(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+	static std::vector<Leisure> create_leisure_locations(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+
+	/**
+	 * \brief Create agents, one per line of the file, with IDs starting at 1
+	 * \details Agents are infected as in the file, but nothing else 
+	 *		about the infection is set; they are not registered in places
+	 * @param file - loaded content of the file with the agents
+	 * @param infection_parameters - parameters as loaded from file, by name
+	 */
+	static std::vector<Agent> create_agents(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters);
+
+	/// Read a space-separated file into a 2D vector of strings
+	static std::vector<std::vector<std::string>> read_object(const std::string& fname);
+
+private:
+
+	// Input file tags and corresponding file names
+	std::map<std::string, std::string> setup_files;
+	// Infection parameters before any simulation-specific changes
+	std::map<std::string, double> infection_parameters;
+	// Places and agents before the simulation
+	std::vector<Household> households;
+	std::vector<RetirementHome> retirement_homes;
+	std::vector<School> schools;
+	std::vector<Workplace> workplaces;
+	std::vector<Hospital> hospitals;
+	std::vector<Transit> carpools;
+	std::vector<Transit> public_transit;
+	std::vector<Leisure> leisure_locations;
+	std::vector<Agent> agents;
+	// Leisure location probabilities
+	Mobility mobility;
+
+	/// Compute the leisure probabilities from household and leisure coordinates
+	void initialize_mobility(const int n_threads);
+};
+
+#endif
@@ -19,11 +19,15 @@
 //
 
 #include "../common.h"
+#include "../infection_parameters.h"
 #include "../agent.h"
 #include "../infection.h"
 #include "../states_manager/regular_states_manager.h"
 #include "../flu.h"
+#include "state_changes.h"
 #include "../testing.h"
+#include "../place_incidence.h"
+#include "../vaccine_effects.h"
 
 /***************************************************** 
  * class: FluTransitions 
@@ -46,26 +50,28 @@ public:
 
 	/// \brief Implement transitions relevant to susceptible
 	/// \details Returns 1 if the agent got infected 
-	std::vector<int> susceptible_transitions(Agent& agent, const double time, Infection& infection,	
+	SusceptibleStateChanges susceptible_transitions(Agent& agent, const double time, Infection& infection,	
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			    std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, Flu& flu, const Testing& testing, const double dt);
+				const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, Flu& flu, const Testing& testing, const double dt,
+				const PlaceIncidence* incidence = nullptr,
+				const VaccineEffects* vac_effects = nullptr);
 
 	/// \brief Determine any testing related properties
 	void set_testing_status(Agent& agent, Infection& infection, const double time, 
 				std::vector<School>& schools, std::vector<Workplace>& workplaces, 
 				std::vector<Hospital>& hospitals, std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters,
+				const InfectionParameters& infection_parameters,
 				const Testing& testing);
 
 	/// \brief Agent transitions related to testing time
 	void testing_transitions_flu(Agent& agent, const double time,
-									const std::map<std::string, double>& infection_parameters);
+									const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions upon receiving test results
 	void testing_results_transitions_flu(Agent& agent, std::vector<Agent>& agents, Flu& flu,
@@ -74,14 +80,14 @@ public:
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters, const Testing& testing);
+			const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Set properties related to newly created agent with flu, including testing
 	void process_new_flu(Agent& agent, const int n_hospitals, const double time, 
 			   		std::vector<School>& schools, std::vector<Workplace>& workplaces,
 					std::vector<RetirementHome>& retirement_homes, std::vector<Transit>& carpools,
 					std::vector<Transit>& public_transit, Infection& infection, 
-					const std::map<std::string, double>& infection_parameters, 
+					const InfectionParameters& infection_parameters, 
 					Flu& flu, const Testing& testing);
 private:
 
@@ -94,11 +100,17 @@ private:
 					const std::vector<Workplace>& workplaces, const std::vector<Hospital>& hospitals,
 					const std::vector<RetirementHome>& retirement_homes,
 					const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit,
-					const std::vector<Leisure>& leisure_locations);
+					const std::vector<Leisure>& leisure_locations, const PlaceIncidence* incidence);
+
+	/// \brief Household, school, work, and transit part of lambda of susceptible agent
+	double compute_routine_lambda(const Agent& agent, 
+					const std::vector<Household>& households, const std::vector<School>& schools,
+					const std::vector<Workplace>& workplaces, const std::vector<RetirementHome>& retirement_homes,
+					const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit);
 
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				                const std::map<std::string, double>& infection_parameters);
+				                const InfectionParameters& infection_parameters);
 
 	/// \brief Remove agent's index from all workplaces and schools that have them registered
 	void remove_from_all_workplaces_and_schools(Agent& agent,
@@ -18,11 +18,15 @@
 //
 
 #include "../common.h"
+#include "../infection_parameters.h"
 #include "../agent.h"
 #include "../infection.h"
 #include "../states_manager/hsp_employee_states_manager.h"
 #include "../flu.h"
+#include "state_changes.h"
 #include "../testing.h"
+#include "../place_incidence.h"
+#include "../vaccine_effects.h"
 
 /***************************************************** 
  * class: HspEmployeeTransitions 
@@ -50,35 +54,37 @@ public:
 				std::vector<Hospital>& hospitals,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, const Testing& testing);
+				const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, const Testing& testing,
+				const PlaceIncidence* incidence = nullptr,
+				const VaccineEffects* vac_effects = nullptr);
 
 	/// \brief Implement transitions relevant to exposed
 	/// \details Return 1 if recovered without symptoms 
-	std::vector<int> exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
+	InfectedStateChanges exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Hospital>& hospitals,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				const Testing& testing);
 
 	/// \brief Determine any testing related properties
 	void set_testing_status(Agent& agent, Infection& infection, const double time, 
 				std::vector<School>& schools, std::vector<Hospital>& hospitals, 
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Transitions of a symptomatic agent 
 	/// @return Vector where first entry is one if agent recovered, second if agent died
-	std::vector<int> symptomatic_transitions(Agent& agent, const double time, 
+	InfectedStateChanges symptomatic_transitions(Agent& agent, const double time, 
 				const double dt, Infection& infection,
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Hospital>& hospitals,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters);
+				const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions related to testing time
 	void testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions upon receiving test results
 	int testing_results_transitions(Agent& agent, 
@@ -86,13 +92,13 @@ public:
 			std::vector<Household>& households, std::vector<School>& schools,
 			std::vector<Hospital>& hospitals,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Determine treatment changes 
 	void treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Remove agent from hospitals and schools for home isolation
 	void remove_from_hospitals_and_schools(const Agent& agent,
@@ -105,7 +111,7 @@ public:
 			std::vector<Household>& households, std::vector<School>& schools,
 			std::vector<Hospital>& hospitals,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 private:
 
@@ -116,15 +122,16 @@ private:
 	double compute_susceptible_lambda(const Agent& agent, const double time, 
 					const std::vector<Household>& households, const std::vector<School>& schools,
 					const std::vector<Hospital>& hospitals, const std::vector<Transit>& carpools,
-					const std::vector<Transit>& public_transit, const std::vector<Leisure>& leisure_locations);
+					const std::vector<Transit>& public_transit, const std::vector<Leisure>& leisure_locations,
+					const PlaceIncidence* incidence);
 
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				                const std::map<std::string, double>& infection_parameters);
+				                const InfectionParameters& infection_parameters);
 	
 	/// \brief Verifies and manages removal of an agent from the model
 	/// @return Vector where first entry is one if agent recovered, second if agent died
-	std::vector<int> check_agent_removal(Agent& agent, const double time,
+	RemovalStateChanges check_agent_removal(Agent& agent, const double time,
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Hospital>& hospitals, std::vector<Transit>& carpools, 
 					std::vector<Transit>& public_transit);
@@ -16,10 +16,13 @@
 //
 
 #include "../common.h"
+#include "../infection_parameters.h"
 #include "../agent.h"
+#include "../vaccine_effects.h"
 #include "../infection.h"
 #include "../states_manager/hsp_employee_states_manager.h"
 #include "../flu.h"
+#include "state_changes.h"
 
 /***************************************************** 
  * class: HspPatientTransitions 
@@ -44,46 +47,47 @@ public:
 	/// \brief Implement transitions relevant to susceptible
 	/// \details Returns 1 if the agent got infected 
 	int susceptible_transitions(Agent& agent, const double time, Infection& infection,	
-				std::vector<Hospital>& hospitals, const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, const Testing& testing);
+				std::vector<Hospital>& hospitals, const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, const Testing& testing,
+				const VaccineEffects* vac_effects = nullptr);
 
 	/// \brief Implement transitions relevant to exposed
 	/// \details Return 1 if recovered without symptoms 
-	std::vector<int> exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, std::vector<Household>& households,
-				std::vector<Hospital>& hospitals, const std::map<std::string, double>& infection_parameters, const Testing& testing);
+	InfectedStateChanges exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, std::vector<Household>& households,
+				std::vector<Hospital>& hospitals, const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Determine any testing related properties
 	void set_testing_status(Agent& agent, Infection& infection, const double time, 
 				std::vector<Hospital>& hospitals, 
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Transitions of a symptomatic agent 
 	/// @return Vector where first entry is one if agent recovered, second if agent died
-	std::vector<int> symptomatic_transitions(Agent& agent, const double time, 
+	InfectedStateChanges symptomatic_transitions(Agent& agent, const double time, 
 				const double dt, Infection& infection, std::vector<Household>& households,
-				std::vector<Hospital>& hospitals, const std::map<std::string, double>& infection_parameters);
+				std::vector<Hospital>& hospitals, const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions related to testing time
 	void testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions upon receiving test results
 	int testing_results_transitions(Agent& agent, 
 			const double time, const double dt, Infection& infection,
 			std::vector<Household>& households,	std::vector<Hospital>& hospitals, 
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Determine treatment changes 
 	void treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// Determine type of intial treatement and its properties
 	void select_initial_treatment(Agent& agent, 
 			const double time, const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 private:
 
@@ -96,11 +100,11 @@ private:
 
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				                const std::map<std::string, double>& infection_parameters);
+				                const InfectionParameters& infection_parameters);
 	
 	/// \brief Verifies and manages removal of an agent from the model
 	/// @return Vector where first entry is one if agent recovered, second if agent died
-	std::vector<int> check_agent_removal(Agent& agent, const double time,
+	RemovalStateChanges check_agent_removal(Agent& agent, const double time,
 					std::vector<Household>& households, std::vector<Hospital>& hospitals);
 
 	/// \brief Remove agent's ID from places where they are registered
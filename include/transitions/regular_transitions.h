@@ -19,11 +19,15 @@
 //
 
 #include "../common.h"
+#include "../infection_parameters.h"
 #include "../agent.h"
 #include "../infection.h"
 #include "../states_manager/regular_states_manager.h"
 #include "../flu.h"
+#include "state_changes.h"
 #include "../testing.h"
+#include "../place_incidence.h"
+#include "../vaccine_effects.h"
 
 /***************************************************** 
  * class: RegularTransitions 
@@ -52,17 +56,19 @@ public:
 			    std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents,	Flu& flu, const Testing& testing);
+				const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents,	Flu& flu, const Testing& testing,
+				const PlaceIncidence* incidence = nullptr,
+				const VaccineEffects* vac_effects = nullptr);
 
 	/// \brief Implement transitions relevant to exposed
 	/// \details Return 1 if recovered without symptoms 
-	std::vector<int> exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
+	InfectedStateChanges exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,				
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Determine any testing related properties
 	bool set_testing_status(Agent& agent, Infection& infection, const double time, 
@@ -70,21 +76,21 @@ public:
 				std::vector<Hospital>& hospitals, 
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Transitions of a symptomatic agent 
 	/// @return Vector where first entry is one if agent recovered, second if agent died
-	std::vector<int> symptomatic_transitions(Agent& agent, const double time, 
+	InfectedStateChanges symptomatic_transitions(Agent& agent, const double time, 
 				const double dt, Infection& infection,
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters);
+				const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions related to testing time
 	void testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions upon receiving test results
 	int testing_results_transitions(Agent& agent, 
@@ -93,14 +99,14 @@ public:
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Determine treatment changes 
 	void treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// Determine testing status, treatment choices, and recovery 
 	void untested_sy_setup(Agent& agent, Infection& infection, const double time, const double dt, 
@@ -108,7 +114,7 @@ public:
 										std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing);
 
 	/// Determine type of intial treatement and its properties
@@ -118,18 +124,18 @@ public:
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	void set_all_testing_states(Agent& agent, const bool val) 
 		{ states_manager.set_all_testing_states(agent, val); }
 
 	/// Determine if the agent is recovering or dying 
 	void recovery_status(Agent& agent, Infection& infection, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// Determine if the agent is recovering or dying in ICU 
 	void recovery_status_ICU(Agent& agent, Infection& infection, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 private:
 
@@ -141,11 +147,17 @@ private:
 					const std::vector<Household>& households, const std::vector<School>& schools,
 					const std::vector<Workplace>& workplaces, const std::vector<RetirementHome>& retirement_homes,
 					const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit,
-					const std::vector<Leisure>& leisure_locations);
+					const std::vector<Leisure>& leisure_locations, const PlaceIncidence* incidence);
+
+	/// \brief Household, school, work, and transit part of lambda of susceptible agent
+	double compute_routine_lambda(const Agent& agent, 
+					const std::vector<Household>& households, const std::vector<School>& schools,
+					const std::vector<Workplace>& workplaces, const std::vector<RetirementHome>& retirement_homes,
+					const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit);
 
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				                const std::map<std::string, double>& infection_parameters);
+				                const InfectionParameters& infection_parameters);
 
 	/// Setup initial treatment properties 
 	void setup_initial_treatment(Agent& agent, 
@@ -154,11 +166,11 @@ private:
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Verifies and manages removal of an agent from the model
 	/// @return Vector where first entry is one if agent recovered, second if agent died
-	std::vector<int> check_agent_removal(Agent& agent, const double time,
+	RemovalStateChanges check_agent_removal(Agent& agent, const double time,
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				 	std::vector<RetirementHome>& retirement_homes,
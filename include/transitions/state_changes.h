@@ -0,0 +1,25 @@
+#ifndef STATE_CHANGES_H
+#define STATE_CHANGES_H
+
+#include <array>
+
+/*****************************************************
+ * Changes in the population statistics caused by
+ * the transitions of a single agent
+ *
+ * Fixed size, so that processing an agent does not
+ * allocate; each entry is 0 or 1 unless noted 
+ *
+ ******************************************************/
+
+/// Susceptible agent: infected, tested, tested negative, tested false positive
+typedef std::array<int, 4> SusceptibleStateChanges;
+
+/// Infected agent: recovered, dead (2 if not confirmed positive), 
+/// tested, tested positive, tested false negative
+typedef std::array<int, 5> InfectedStateChanges;
+
+/// Removal of an agent: recovered, dead
+typedef std::array<int, 2> RemovalStateChanges;
+
+#endif
@@ -72,45 +72,49 @@ public:
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters);
+				const InfectionParameters& infection_parameters);
 
 	/// \brief Implement transitions relevant to susceptible
-	/// \details Returns 1 if the agent got infected 
-	std::vector<int> susceptible_transitions(Agent& agent, const double time, 
+	/// \details Returns 1 if the agent got infected; if incidence is 
+	///		not nullptr, routine places are taken from it, and if vac_effects 
+	///		is not nullptr, vaccine effectiveness is taken from it
+	SusceptibleStateChanges susceptible_transitions(Agent& agent, const double time, 
 				const double dt, Infection& infection,	
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, Flu& flu, const Testing& testing);
+				const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, Flu& flu, const Testing& testing,
+				const PlaceIncidence* incidence = nullptr,
+				const VaccineEffects* vac_effects = nullptr);
 
 	/// \brief Implement transitions relevant to exposed
 	/// \details Return 1 if recovered without symptoms 
-	std::vector<int> exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
+	InfectedStateChanges exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Transitions of a symptomatic agent 
 	/// @return Vector where first entry is one if agent recovered, second if agent died
-	std::vector<int> symptomatic_transitions(Agent& agent, const double time, 
+	InfectedStateChanges symptomatic_transitions(Agent& agent, const double time, 
 				const double dt, Infection& infection,
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters);
+				const InfectionParameters& infection_parameters);
 	
 	/// \brief Set properties related to newly created agent with flu, including testing
 	void process_new_flu(Agent& agent, const int n_hospitals, const double time, 
 			   		std::vector<School>& schools, std::vector<Workplace>& workplaces,
 					std::vector<RetirementHome>& retirement_homes, std::vector<Transit>& carpools,
 					std::vector<Transit>& public_transit, Infection& infection, 
-					const std::map<std::string, double>& infection_parameters, 
+					const InfectionParameters& infection_parameters, 
 					Flu& flu, const Testing& testing) 
 		{ flu_tr.process_new_flu(agent, n_hospitals, time, schools, 
 						workplaces, retirement_homes, 
@@ -8,14 +8,22 @@
 #include "./io_operations/load_parameters.h"
 #include "agent.h"
 #include "infection.h"
-#include "three_part_function.h"
-#include "four_part_function.h"
+#include "vaccine_profiles.h"
+#include "id_set.h"
+#include "agent_bitmap.h"
 
 /***************************************************** 
  * class: Vaccinations
  * 
  * Operations related to vaccinating, choice 
  * and setup of newly vaccinated agents 
+ *
+ * Agents eligible for random vaccination can be
+ * tracked; the owner of the agents then reports 
+ * every agent that may have changed, and random
+ * vaccination doesn't go through all the agents;
+ * members of each vaccination group are then kept
+ * as bitmaps and intersected with eligible agents
  * 
  ******************************************************/
 
@@ -108,14 +116,40 @@ public:
 	const std::map<std::string, double>& get_vaccination_parameters() const 
 		{ return vaccination_parameters; }
 
+	/// Name of the vaccine subtype of an agent, "not set" if not vaccinated
+	const std::string& get_vaccine_subtype(const Agent& agent) const 
+		{ return subtypes.get_name(agent.get_vaccine_subtype_ID()); }
+
 	/// Returns maximum number of agents currently eligible for vaccination
-	int max_eligible_random(const std::vector<Agent>& agents);
+	int max_eligible_random(const std::vector<Agent>& agents) const;
 
 	/// Returns maximum number of agents in a group currently eligible for vaccination
-	int max_eligible_group(const std::vector<Agent>& agents, const std::string& group_name);
+	int max_eligible_group(const std::vector<Agent>& agents, const std::string& group_name) const;
+
+	//
+	// Tracking of eligible agents
+	//
+
+	/**
+	 * \brief Find all the agents eligible for random vaccination and keep track of them
+	 * \details From then on, update_eligibility() needs to be called for every 
+	 *		agent that may have changed, other than in vaccinations
+	 * @param agents - vector of all the agents, IDs start with 1
+	 */
+	void track_eligibility(const std::vector<Agent>& agents);
+
+	/// Stop tracking, eligible agents will be found from all the agents
+	void stop_tracking_eligibility()
+		{ eligible_IDs.reset(); eligible_bits.reset(); group_members.clear(); tracking_eligible = false; }
+
+	/// True if eligible agents are tracked
+	bool tracking_eligibility() const { return tracking_eligible; }
+
+	/// Record current eligibility of an agent, if tracked
+	void update_eligibility(const Agent& agent);
 
 	/// Minimum age to get vaccinated
-	int get_min_vac_age() const { return vaccination_parameters.at("Minimum vaccination age"); }
+	int get_min_vac_age() const { return static_cast<int>(min_vac_age); }
 	/// Vaccinates agents with provided IDs and sets all the agent properties
 	void vaccinate_and_setup(std::vector<Agent>& agents, const std::vector<int>& agent_IDs,
 								Infection& infection, const double time);
@@ -128,6 +162,8 @@ private:
 	std::string input_file;
 	// Map of property tag - property value pairs
 	std::map<std::string, double> vaccination_parameters;
+	// Minimum age of vaccinated agents, checked for every agent at every step
+	double min_vac_age = 0.0;
 	// Map of vaccination types and probabilities of receiving them
 	// The probabilities for subtypes of each general type are assumed to be a CDF
 	// General types are "one dose" and "two doses", and subtypes are the specific
@@ -136,10 +172,37 @@ private:
 	// Outer maps are vaccination types, inner are properties altered by
 	// vaccinating in an extent that correspond to each type
 	std::map<std::string, std::map<std::string, std::vector<std::vector<double>>>> vac_types_properties;
+	// Shared response and timing of a vaccine subtype
+	struct SubtypeProfile {
+		int subtype_ID = 0;
+		// Subtype of agents that received a third dose after this one
+		int former_ID = 0;
+		std::shared_ptr<const VaccineResponse> response;
+		// Time after vaccination when the mobility increases
+		// and when the benefits start dropping
+		double mobility_increase = 0.0;
+		double effects_reduction = 0.0;
+		// Peak value of each benefit, in order of VaccineProfiles::Benefits
+		std::vector<double> max_benefits;
+	};
+	// Profiles of all the subtypes, in order of their CDFs
+	std::vector<SubtypeProfile> one_dose_profiles;
+	std::vector<SubtypeProfile> two_dose_profiles;
+	// Names of the subtypes and their responses
+	VaccineSubtypes subtypes;
+	VaccineProfiles profiles;
 	// Vector with time offsets
 	std::vector<double> time_offsets;
 	// Flag to use those and not uniform
 	bool use_offsets_from_file = false;
+	// Agents eligible for random vaccination, if tracked
+	IDSet eligible_IDs;
+	AgentBitmap eligible_bits;
+	bool tracking_eligible = false;
+	// Members of each vaccination group, in order of group_names, if tracked
+	std::vector<AgentBitmap> group_members;
+	// Names of groups that can be vaccinated
+	static const std::vector<std::string> group_names;
 
 	/// Load parameters related to vaccinations store in a map
 	void load_vaccination_parameters(const std::string&, const std::string&);
@@ -147,6 +210,24 @@ private:
 	/// Load and shuffle time custom offsets 
 	void load_and_shuffle_time_offsets(const std::string&, Infection&);
 
+	/// Shared response and timing of a loaded subtype, registered with its response
+	SubtypeProfile create_subtype_profile(const std::string& tag, const VaccineType type);
+
+	/// Shared response and timing of a subtype with given ID, throws std::invalid_argument if not loaded
+	const SubtypeProfile& get_subtype_profile(const int subtype_ID) const;
+
+	/**
+	 * \brief Randomly chooses the vaccine and sets the agent's response
+	 *
+	 * @param agent - agent vaccinated for the first time
+	 * @param infection - object governing all random ops
+	 * @param start - time of vaccination, with the offset if any
+	 */
+	void setup_first_vaccination(Agent& agent, Infection& infection, const double start);
+
+	/// Sets the response of an already vaccinated agent to the third dose
+	void setup_third_dose(Agent& agent, const double time);
+
 	/// Copy parameters in lst into nested vec 
 	void copy_vaccination_dependencies(std::forward_list<double>&& lst,
 			std::vector<std::vector<double>>& vec);
@@ -159,7 +240,7 @@ private:
 	 *
      * @returns - vector of IDs of eligible agents (index in the vector is ID-1)
 	 */
-	std::vector<int> filter_general(const std::vector<Agent>& agents);
+	std::vector<int> filter_general(const std::vector<Agent>& agents) const;
 	
 	/**
 	 * \brief Select agents in a given group eligible for vaccination based on criteria valid for all agents
@@ -171,13 +252,34 @@ private:
      * @returns - vector of IDs of eligible agents (index in the vector is ID-1)
 	 */
 	std::vector<int> filter_general_and_group(const std::vector<Agent>& agents, 
-						const std::string& group_name);
+						const std::string& group_name) const;
+
+	/**
+	 * \brief Randomly choose agents eligible for vaccination based on criteria valid for all agents
+	 * \details Draws without replacement from the tracked agents or, if not
+	 *		tracked, from all the eligible agents; tracked agents are removed
+	 *		as they are chosen
+	 *
+	 * @param agents - all the agents in the simulation
+	 * @param n_vac - number of agents to choose, reduced if fewer are eligible
+	 * @param infection - object governing all random ops
+	 *
+	 * @returns - IDs of the chosen agents
+	 */
+	std::vector<int> select_random(const std::vector<Agent>& agents, int n_vac, Infection& infection);
+
+	/// Record eligibility of an agent with given ID in the tracked agents
+	void set_eligible(const int aID, const bool eligible)
+		{ eligible ? eligible_IDs.insert(aID) : eligible_IDs.remove(aID); eligible_bits.set(aID, eligible); }
+
+	/// Index of a group in group_names, -1 if there is no such group
+	static int group_index(const std::string& group_name);
 		
 	/// True if agent meets core criteria for vaccination eligibility
-	bool check_general(const Agent& agent);	
+	bool check_general(const Agent& agent) const;	
 	
 	/// True if agent is in the target vaccination group 
-	bool check_group(const Agent& agent, const std::string& group_name);
+	bool check_group(const Agent& agent, const std::string& group_name) const;
 };
 
 #endif
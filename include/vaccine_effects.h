@@ -0,0 +1,114 @@
+#ifndef VACCINE_EFFECTS_H
+#define VACCINE_EFFECTS_H
+
+#include "agent.h"
+
+/*****************************************************
+ * class: VaccineEffects
+ *
+ * Vaccine effectiveness of all the agents at the
+ * current time step, evaluated once per step
+ *
+ * Effectiveness is needed for every susceptible
+ * agent at every step; agents sharing a vaccine
+ * profile are kept together with their start times
+ * in contiguous vectors and the profile is evaluated
+ * for all of them at once; agents with their own
+ * response are evaluated one by one, agents never
+ * vaccinated have the default zero
+ *
+ * Agents are grouped when vaccinated, the groups
+ * need to be rebuilt after any vaccination
+ *
+ ******************************************************/
+
+class VaccineEffects {
+public:
+
+	/// Groups need to be rebuilt, call after responses of agents change
+	void invalidate() { is_valid = false; }
+
+	/**
+	 * \brief Evaluate effectiveness of all the agents at a time
+	 * \details Groups agents first if not valid
+	 * @param agents - all the agents, IDs start with 1
+	 * @param time - current time
+	 */
+	void update(const std::vector<Agent>& agents, const double time)
+	{
+		if (!is_valid || effectiveness_values.size() != agents.size()) {
+			build(agents);
+		}
+		for (auto& group : groups) {
+			if (group.type == VaccineType::one_dose) {
+				group.profile->tpf_effectiveness.evaluate(group.starts, time, group.values);
+			} else {
+				group.profile->fpf_effectiveness.evaluate(group.starts, time, group.values);
+			}
+			const int n_agents = group.IDs.size();
+			for (int i = 0; i < n_agents; ++i) {
+				effectiveness_values[group.IDs[i]-1] = group.values[i];
+			}
+		}
+		for (const int aID : own_IDs) {
+			effectiveness_values[aID-1] = agents[aID-1].vaccine_effectiveness(time);
+		}
+	}
+
+	/// Effectiveness of an agent at the time of the last update
+	double effectiveness(const int aID) const { return effectiveness_values.at(aID-1); }
+
+private:
+
+	// Agents with the same profile and vaccine type
+	struct Group {
+		const VaccineResponse* profile = nullptr;
+		VaccineType type = VaccineType::one_dose;
+		std::vector<int> IDs;
+		std::vector<double> starts;
+		std::vector<double> values;
+	};
+
+	bool is_valid = false;
+	std::vector<Group> groups;
+	// Agents with their own response
+	std::vector<int> own_IDs;
+	// Effectiveness of each agent, index is ID-1
+	std::vector<double> effectiveness_values;
+
+	/// Sort agents into groups, there are only a few profiles
+	void build(const std::vector<Agent>& agents)
+	{
+		groups.clear();
+		own_IDs.clear();
+		effectiveness_values.assign(agents.size(), 0.0);
+		for (const auto& agent : agents) {
+			if (agent.has_own_vaccine_response()) {
+				own_IDs.push_back(agent.get_ID());
+				continue;
+			}
+			const VaccineResponse* profile = agent.get_vaccine_profile();
+			if (!profile) {
+				continue;
+			}
+			const VaccineType type = agent.get_vaccine_regimen();
+			auto iter = std::find_if(groups.begin(), groups.end(),
+					[&](const Group& group) { return group.profile == profile && group.type == type; });
+			if (iter == groups.end()) {
+				groups.push_back(Group());
+				groups.back().profile = profile;
+				groups.back().type = type;
+				iter = groups.end() - 1;
+			}
+			iter->IDs.push_back(agent.get_ID());
+			iter->starts.push_back(agent.get_vaccine_profile_time());
+		}
+		is_valid = true;
+	}
+};
+
+/// Vaccine effectiveness of an agent, from the evaluated values if available
+inline double vaccine_effectiveness(const Agent& agent, const double time, const VaccineEffects* effects)
+	{ return effects ? effects->effectiveness(agent.get_ID()) : agent.vaccine_effectiveness(time); }
+
+#endif
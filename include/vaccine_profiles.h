@@ -0,0 +1,114 @@
+#ifndef VACCINE_PROFILES_H
+#define VACCINE_PROFILES_H
+
+#include <map>
+#include <memory>
+#include "common.h"
+#include "agent_attributes.h"
+#include "three_part_function.h"
+#include "four_part_function.h"
+
+/// Time dependence of vaccine benefits
+struct VaccineResponse {
+	// Time dependency for 1 dose vaccines
+	ThreePartFunction tpf_effectiveness = {0.0};
+	ThreePartFunction tpf_asymptomatic = {1.0};
+	ThreePartFunction tpf_transmission = {1.0};
+	ThreePartFunction tpf_severe = {1.0};
+	ThreePartFunction tpf_death = {1.0};
+	// Time dependency for 2 dose vaccines
+	FourPartFunction fpf_effectiveness = {0.0};
+	FourPartFunction fpf_asymptomatic = {1.0};
+	FourPartFunction fpf_transmission = {1.0};
+	FourPartFunction fpf_severe = {1.0};
+	FourPartFunction fpf_death = {1.0};
+
+	/// Copy of the response with all the functions moved by an offset
+	VaccineResponse shifted(const double offset) const
+	{
+		VaccineResponse response;
+		response.tpf_effectiveness = tpf_effectiveness.shifted(offset);
+		response.tpf_asymptomatic = tpf_asymptomatic.shifted(offset);
+		response.tpf_transmission = tpf_transmission.shifted(offset);
+		response.tpf_severe = tpf_severe.shifted(offset);
+		response.tpf_death = tpf_death.shifted(offset);
+		response.fpf_effectiveness = fpf_effectiveness.shifted(offset);
+		response.fpf_asymptomatic = fpf_asymptomatic.shifted(offset);
+		response.fpf_transmission = fpf_transmission.shifted(offset);
+		response.fpf_severe = fpf_severe.shifted(offset);
+		response.fpf_death = fpf_death.shifted(offset);
+		return response;
+	}
+};
+
+/*****************************************************
+ * class: VaccineProfiles
+ *
+ * Table of vaccine response profiles - responses
+ * of vaccine subtypes with time counted from the
+ * vaccination
+ *
+ * All agents vaccinated with a subtype share its
+ * profile and store only the profile and the time
+ * of vaccination; agents share the ownership so
+ * the profiles stay valid in copies of the agents;
+ * each Vaccinations object has its own table
+ *
+ * Profiles are evaluated at the time since the
+ * vaccination; values can differ in the last bits
+ * from functions created with the vaccination time
+ * as the offset
+ *
+ ******************************************************/
+
+class VaccineProfiles {
+public:
+
+	/// Points (time, value) of the effectiveness, asymptomatic,
+	/// transmission, severe, and death benefits, in that order
+	using Benefits = std::vector<std::vector<std::vector<double>>>;
+
+	/**
+	 * \brief Profile with given benefits, added to the table if new
+	 *
+	 * @param type - one dose vaccines have three part, two dose four part functions
+	 * @param benefits - points of each benefit, time relative to vaccination
+	 *
+	 * @returns - the profile, same for the same type and benefits
+	 */
+	std::shared_ptr<const VaccineResponse> get(const VaccineType type, const Benefits& benefits)
+	{
+		const std::pair<VaccineType, Benefits> key(type, benefits);
+		auto iter = profiles.find(key);
+		if (iter == profiles.end()) {
+			iter = profiles.emplace(key, std::make_shared<const VaccineResponse>(create(type, benefits))).first;
+		}
+		return iter->second;
+	}
+
+private:
+
+	std::map<std::pair<VaccineType, Benefits>, std::shared_ptr<const VaccineResponse>> profiles;
+
+	/// Response with functions of the type starting at time 0
+	static VaccineResponse create(const VaccineType type, const Benefits& benefits)
+	{
+		VaccineResponse profile;
+		if (type == VaccineType::one_dose) {
+			profile.tpf_effectiveness = ThreePartFunction(benefits.at(0), 0.0);
+			profile.tpf_asymptomatic = ThreePartFunction(benefits.at(1), 0.0);
+			profile.tpf_transmission = ThreePartFunction(benefits.at(2), 0.0);
+			profile.tpf_severe = ThreePartFunction(benefits.at(3), 0.0);
+			profile.tpf_death = ThreePartFunction(benefits.at(4), 0.0);
+		} else {
+			profile.fpf_effectiveness = FourPartFunction(benefits.at(0), 0.0);
+			profile.fpf_asymptomatic = FourPartFunction(benefits.at(1), 0.0);
+			profile.fpf_transmission = FourPartFunction(benefits.at(2), 0.0);
+			profile.fpf_severe = FourPartFunction(benefits.at(3), 0.0);
+			profile.fpf_death = FourPartFunction(benefits.at(4), 0.0);
+		}
+		return profile;
+	}
+};
+
+#endif
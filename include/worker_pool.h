@@ -0,0 +1,141 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*****************************************************
+ * class: WorkerPool
+ *
+ * Threads that are started once and then wait for
+ * work, so that processing in parallel does not start
+ * and join new threads every time
+ *
+ * The calling thread is worker 0, the pool holds the
+ * other workers and grows to the largest number of
+ * workers requested so far
+ *
+ * Threads are not copied, a copy starts without them
+ *
+ ******************************************************/
+
+class WorkerPool {
+public:
+
+	WorkerPool() = default;
+	/// Copies start their own threads when used
+	WorkerPool(const WorkerPool&) { }
+	WorkerPool& operator=(const WorkerPool&) { return *this; }
+
+	/// Stops and joins all the threads
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			stopping = true;
+		}
+		start.notify_all();
+		for (auto& thr : threads) {
+			thr.join();
+		}
+	}
+
+	/**
+	 * \brief Run a task on n_workers workers and wait for all of them to finish
+	 * \details Exceptions thrown by any of the workers are rethrown
+	 *		after all of them finish
+	 * @param n_workers - number of workers, the task is called once for each
+	 * @param task - called with index of the worker, from 0 to n_workers-1
+	 */
+	void run(const int n_workers, const std::function<void(const int)>& task)
+	{
+		if (n_workers <= 1) {
+			task(0);
+			return;
+		}
+		std::unique_lock<std::mutex> lock(mtx);
+		while (static_cast<int>(threads.size()) < n_workers - 1) {
+			const int iw = threads.size() + 1;
+			threads.emplace_back([this, iw]() { wait_for_work(iw); });
+		}
+		current_task = &task;
+		n_active = n_workers;
+		n_running = n_workers - 1;
+		errors.assign(n_workers, nullptr);
+		++generation;
+		lock.unlock();
+		start.notify_all();
+
+		try {
+			task(0);
+		} catch (...) {
+			errors.at(0) = std::current_exception();
+		}
+
+		lock.lock();
+		done.wait(lock, [this]() { return n_running == 0; });
+		current_task = nullptr;
+		for (const auto& error : errors) {
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+	}
+
+	/// Number of threads started in addition to the calling thread
+	int get_number_of_threads() const { return threads.size(); }
+
+private:
+	std::vector<std::thread> threads;
+	std::mutex mtx;
+	// Signals a new task or stopping
+	std::condition_variable start;
+	// Signals that the last worker finished
+	std::condition_variable done;
+	// Task of the current run, valid while it runs
+	const std::function<void(const int)>* current_task = nullptr;
+	// Number of workers in the current run and
+	// the number of pool workers still running it
+	int n_active = 0;
+	int n_running = 0;
+	// Incremented with each run, so that each run is picked up once
+	unsigned long generation = 0;
+	std::vector<std::exception_ptr> errors;
+	bool stopping = false;
+
+	/// Loop of a pool thread - wait for a run, process its part if part of it
+	void wait_for_work(const int iw)
+	{
+		unsigned long last_generation = 0;
+		std::unique_lock<std::mutex> lock(mtx);
+		while (true) {
+			start.wait(lock, [&]() { return stopping || generation != last_generation; });
+			if (stopping) {
+				return;
+			}
+			last_generation = generation;
+			if (iw >= n_active) {
+				continue;
+			}
+			const std::function<void(const int)>* task = current_task;
+			lock.unlock();
+			std::exception_ptr error = nullptr;
+			try {
+				(*task)(iw);
+			} catch (...) {
+				error = std::current_exception();
+			}
+			lock.lock();
+			errors.at(iw) = error;
+			if (--n_running == 0) {
+				done.notify_one();
+			}
+		}
+	}
+};
+
+#endif
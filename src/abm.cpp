@@ -50,9 +50,14 @@ void ABM::initialize_data_collection()
 // Create the town, agents, infection properties, and introduce initially infected 
 void ABM::simulation_setup(const std::string filename, const int inf0, const bool custom_vac_offsets)
 {
-	// Load filenames - key is the tag, value is the actual file name
-	LoadParameters ldparam;
-	std::map<std::string, std::string> setup_files = ldparam.load_parameter_map<std::string>(filename);
+	simulation_setup_from_town(Town(filename, n_threads), inf0, custom_vac_offsets);
+}
+
+// Create agents, infection properties, and introduce initially infected in a loaded town 
+void ABM::simulation_setup_from_town(const Town& town, const int inf0, const bool custom_vac_offsets)
+{
+	// Key is the tag, value is the actual file name
+	const std::map<std::string, std::string>& setup_files = town.get_setup_files();
 	
 	// Load parameters
 	// Separately prepare a map for age-dependent parameters
@@ -62,7 +67,9 @@ void ABM::simulation_setup(const std::string filename, const int inf0, const boo
 		  {"ICU", setup_files.at("ICU")}, 
 		  {"mortality", setup_files.at("mortality")} 
 		};
-	load_infection_parameters(setup_files.at("Simulation parameters"));
+	infection_parameters = town.get_infection_parameters();
+	parameters = InfectionParameters(infection_parameters);
+	set_infection_distributions();
 	load_age_dependent_distributions(dfiles);
 	load_testing(setup_files.at("Testing manager"));
 
@@ -74,20 +81,21 @@ void ABM::simulation_setup(const std::string filename, const int inf0, const boo
 	} else {
 		load_vaccinations(setup_files.at("Vaccination parameters"), setup_files.at("Vaccination tables directory"));
 	}
-	// Setup the town and mobility components
-	create_households(setup_files.at("Household data"));
-	create_schools(setup_files.at("School data"));
-	create_workplaces(setup_files.at("Workplace data"));
-	create_hospitals(setup_files.at("Hospital data"));
-	create_retirement_homes(setup_files.at("Retirement home data"));
-	create_carpools(setup_files.at("Carpool data"));
-	create_public_transit(setup_files.at("Public transit data"));
-	create_leisure_locations(setup_files.at("Leisure location data"));
-	initialize_mobility();
-
-	// Create the agents, including initially infected
-	create_agents(setup_files.at("Agent data"), inf0);
-	
+	// Copy the places of the town and share its mobility component
+	households = town.get_households();
+	schools = town.get_schools();
+	workplaces = town.get_workplaces();
+	hospitals = town.get_hospitals();
+	retirement_homes = town.get_retirement_homes();
+	carpools = town.get_carpools();
+	public_transit = town.get_public_transit();
+	leisure_locations = town.get_leisure_locations();
+	set_outside_workplace_transmission();
+	set_outside_leisure_transmission();
+	mobility = town.get_mobility();
+
+	// Copy the agents, including initially infected
+	create_agents(town.get_agents(), inf0);
 }
 
 // Load infection parameters, store in a map
@@ -96,7 +104,22 @@ void ABM::load_infection_parameters(const std::string infile)
 	// Load parameters
 	LoadParameters ldparam;
 	infection_parameters = ldparam.load_parameter_map<double>(infile);
+	InfectionParameters::report_unknown(infection_parameters);
+	parameters = InfectionParameters(infection_parameters);
+	set_infection_distributions();
+}
+
+// Change a parameter in the map and in the resolved parameters
+void ABM::set_infection_parameter(const std::string& name, const double value)
+{
+	infection_parameters.at(name) = value;
+	parameters = InfectionParameters(infection_parameters);
+}
 
+// Set the distributions and probabilities of the Infection object
+void ABM::set_infection_distributions()
+{
+	worker_infections.clear();
 	// Set infection distributions
 	infection.set_latency_distribution(infection_parameters.at("latency log-normal mean"),
 					infection_parameters.at("latency log-normal standard deviation"));	
@@ -130,6 +153,7 @@ void ABM::load_age_dependent_distributions(const std::map<std::string, std::stri
 	}
 
 	// Send to Infection class for further processing 
+	worker_infections.clear();
 	infection.set_expN2sy_fractions(age_dependent_distributions.at("exposed never symptomatic"));
 	infection.set_mortality_rates(age_dependent_distributions.at("mortality"));
 	infection.set_hospitalized_fractions(age_dependent_distributions.at("hospitalization"));
@@ -142,8 +166,8 @@ void ABM::load_testing(const std::string fname)
 	// Regular properties
 	testing.initialize_testing(infection_parameters.at("start testing"),
 					infection_parameters.at("negative tests fraction"),
-					infection_parameters.at("fraction false negative"),
-					infection_parameters.at("fraction false positive"),
+					parameters.fraction_false_negative,
+					parameters.fraction_false_positive,
 					infection_parameters.at("fraction to get tested"),
 					infection_parameters.at("exposed fraction to get tested"));	
 	// Time-dependent test fractions
@@ -173,228 +197,109 @@ void ABM::load_vaccinations(const std::string& fname, const std::string& data_pa
 // Generate and store household objects
 void ABM::create_households(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One household per line
-	for (auto& house : file){
-		// Extract properties, add infection parameters
-		Household temp_house(std::stoi(house.at(0)), 
-			std::stod(house.at(1)), std::stod(house.at(2)),
-			infection_parameters.at("household scaling parameter"),
-			infection_parameters.at("severity correction"),
-			infection_parameters.at("household transmission rate"),
-			infection_parameters.at("transmission rate of home isolated"));
-		// Store 
-		households.push_back(temp_house);
-	}
+	const std::vector<Household> created = Town::create_households(read_object(fname), infection_parameters);
+	households.insert(households.end(), created.begin(), created.end());
 }
 
 // Generate and store retirement homes objects
 void ABM::create_retirement_homes(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One household per line
-	for (auto& rh : file){
-		// Extract properties, add infection parameters
-		RetirementHome temp_RH(std::stoi(rh.at(0)), 
-			std::stod(rh.at(1)), std::stod(rh.at(2)),
-			infection_parameters.at("severity correction"),
-			infection_parameters.at("RH employee absenteeism factor"),
-			infection_parameters.at("RH employee transmission rate"),
-			infection_parameters.at("RH resident transmission rate"),
-			infection_parameters.at("RH transmission rate of home isolated"));
-		// Store 
-		retirement_homes.push_back(temp_RH);
-	}
+	const std::vector<RetirementHome> created = Town::create_retirement_homes(read_object(fname), infection_parameters);
+	retirement_homes.insert(retirement_homes.end(), created.begin(), created.end());
 }
 
 // Generate and store school objects
 void ABM::create_schools(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One workplace per line
-	for (auto& school : file){
-		// Extract properties, add infection parameters
-		// School-type dependent absenteeism
-		double psi = 0.0;
-		std::string school_type = school.at(3);
-		if (school_type == "daycare")
- 			psi = infection_parameters.at("daycare absenteeism correction");
-		else if (school_type == "primary" || school_type == "middle")
- 			psi = infection_parameters.at("primary and middle school absenteeism correction");
-		else if (school_type == "high")
- 			psi = infection_parameters.at("high school absenteeism correction");
-		else if (school_type == "college")
- 			psi = infection_parameters.at("college absenteeism correction");
-		else
-			throw std::invalid_argument("Wrong school type: " + school_type);
-		School temp_school(std::stoi(school.at(0)), 
-			std::stod(school.at(1)), std::stod(school.at(2)),
-			infection_parameters.at("severity correction"),	
-			infection_parameters.at("school employee absenteeism correction"), psi,
-			infection_parameters.at("school employee transmission rate"), 
-			infection_parameters.at("school transmission rate"));
-		// Store 
-		schools.push_back(temp_school);
-	}
+	const std::vector<School> created = Town::create_schools(read_object(fname), infection_parameters);
+	schools.insert(schools.end(), created.begin(), created.end());
 }
 
 // Generate and store workplace objects
 void ABM::create_workplaces(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One workplace per line
-	for (auto& work : file){
-		// Get the occupation type of the workplace
-		std::string work_type = work.at(3);
-		std::string rate_by_type = "outside";
-		double work_rate = 0.0;	 
-		if (work_type == "A") { 
-			rate_by_type = "management science art transmission rate"; 
-		} else if (work_type == "B") { 
-			rate_by_type = "service occupation transmission rate";
-		} else if (work_type == "C") { 
-			rate_by_type = "sales office transmission rate"; 
-		} else if (work_type == "D") { 
-			rate_by_type = "construction maintenance transmission rate"; 
-		} else if (work_type == "E") { 
-			rate_by_type = "production transportation transmission rate"; 
-		} 
-		if (work_type != "outside") {
-		 	work_rate = infection_parameters.at(rate_by_type);
-		} else {
-			work_rate = 1.0;
-		}
-		// Extract properties, add infection parameters
-		Workplace temp_work(std::stoi(work.at(0)), 
-			std::stod(work.at(1)), std::stod(work.at(2)),
-			infection_parameters.at("severity correction"),
-			infection_parameters.at("work absenteeism correction"),
-			work_rate, work.at(3)); 
-		// Store 
-		workplaces.push_back(temp_work);
-	}
+	const std::vector<Workplace> created = Town::create_workplaces(read_object(fname), infection_parameters);
+	workplaces.insert(workplaces.end(), created.begin(), created.end());
 	set_outside_workplace_transmission();
 }
 
 // Create hospitals based on information in a file
 void ABM::create_hospitals(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One hospital per line
-	for (auto& hospital : file){
-		// Make a map of transmission rates for different 
-		// hospital-related categories
-		std::map<const std::string, const double> betas = 
-			{{"hospital employee", infection_parameters.at("healthcare employees transmission rate")}, 
-			 {"hospital non-COVID patient", infection_parameters.at("hospital patients transmission rate")},
-			 {"hospital testee", infection_parameters.at("hospital tested transmission rate")},
-			 {"hospitalized", infection_parameters.at("hospitalized transmission rate")}, 
-			 {"hospitalized ICU", infection_parameters.at("hospitalized ICU transmission rate")}};
-		Hospital temp_hospital(std::stoi(hospital.at(0)), 
-			std::stod(hospital.at(1)), std::stod(hospital.at(2)),
-			infection_parameters.at("severity correction"), betas);
-		// Store 
-		hospitals.push_back(temp_hospital);
-	}
+	const std::vector<Hospital> created = Town::create_hospitals(read_object(fname), infection_parameters);
+	hospitals.insert(hospitals.end(), created.begin(), created.end());
 }
 
 // Generate and store carpool objects
 void ABM::create_carpools(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One carpool per line
-	for (auto& cpl : file) {
-		// Extract properties, add infection parameters
-		Transit temp_transit(std::stoi(cpl.at(0)), 
-			infection_parameters.at("carpool transmission rate"),
-			infection_parameters.at("severity correction"),  
-			infection_parameters.at("work absenteeism correction"),
-			cpl.at(1));
-		// Store 
-		carpools.push_back(temp_transit);
-	}
+	const std::vector<Transit> created = Town::create_carpools(read_object(fname), infection_parameters);
+	carpools.insert(carpools.end(), created.begin(), created.end());
 }
 
 // Generate and store public transit objects
 void ABM::create_public_transit(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// Transmission rate based on current capacity
-	double beta_T = infection_parameters.at("public transit beta0") 
-					+ infection_parameters.at("public transit beta full")
-						*infection_parameters.at("public transit current capacity");
-	// One public transit per line
-	for (auto& pbt : file) {
-		// Extract properties, add infection parameters
-		Transit temp_transit(std::stoi(pbt.at(0)),
-			beta_T, infection_parameters.at("severity correction"),  
-			infection_parameters.at("work absenteeism correction"),  
-			pbt.at(1));
-		// Store 
-		public_transit.push_back(temp_transit);
-	}
+	const std::vector<Transit> created = Town::create_public_transit(read_object(fname), infection_parameters);
+	public_transit.insert(public_transit.end(), created.begin(), created.end());
 }
 
 // Generate and store leisure locations/weekend objects
 void ABM::create_leisure_locations(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One leisure location per line
-	for (auto& lsr : file) {
-		// Extract properties, add infection parameters
-		Leisure temp_lsr(std::stoi(lsr.at(0)), 
-			std::stod(lsr.at(1)), std::stod(lsr.at(2)),
-			infection_parameters.at("severity correction"), 
-			infection_parameters.at("leisure locations transmission rate"),	
-			lsr.at(3));
-		// Store 
-		leisure_locations.push_back(temp_lsr);
-	}
+	const std::vector<Leisure> created = Town::create_leisure_locations(read_object(fname), infection_parameters);
+	leisure_locations.insert(leisure_locations.end(), created.begin(), created.end());
 	set_outside_leisure_transmission();
 }
 
 // Initialize Mobility and assignment of leisure locations
-void ABM::initialize_mobility()
+void ABM::initialize_mobility(const std::string& cache_dir)
 {
-	mobility.set_probability_parameters(infection_parameters.at("leisure - dr0"), infection_parameters.at("leisure - beta"), infection_parameters.at("leisure - kappa"));
+	mobility.set_parameters(infection_parameters);
+	mobility.set_cache_directory(cache_dir);
 	mobility.construct_public_probabilities(households, leisure_locations);
 }
 
 // Create agents and assign them to appropriate places
 void ABM::create_agents(const std::string fname, const int ninf0)
 {
-	load_agents(fname, ninf0);
+	create_agents(Town::create_agents(read_object(fname), infection_parameters), ninf0);
+}
+
+// Copy agents created from the input and assign them to places
+void ABM::create_agents(const std::vector<Agent>& town_agents, const int ninf0)
+{
+	load_agents(town_agents, ninf0);
 	register_agents();
+	place_incidence.build(agents, households, retirement_homes, schools, workplaces, 
+				hospitals, carpools, public_transit, leisure_locations);
+	touched_places.invalidate();
+	leisure_tracked = false;
 	initialize_contact_tracing();
 }
 
 // Retrieve agent information from a file
 void ABM::load_agents(const std::string fname, const int ninf0)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
+	load_agents(Town::create_agents(read_object(fname), infection_parameters), ninf0);
+}
 
+// Copy agents created from the input, set the initially infected
+void ABM::load_agents(const std::vector<Agent>& town_agents, const int ninf0)
+{
 	// Flu settings
 	// Set fraction of flu (non-covid symptomatic)
 	flu.set_fraction(infection_parameters.at("fraction with flu"));
-	flu.set_fraction_tested_false_positive(infection_parameters.at("fraction false positive"));
+	flu.set_fraction_tested_false_positive(parameters.fraction_false_positive);
 	// Time interval for testing
-	flu.set_testing_duration(infection_parameters.at("flu testing duration"));
+	flu.set_testing_duration(parameters.flu_testing_duration);
 
 	// For custom generation of initially infected
 	std::vector<int> infected_IDs(ninf0);
 	bool not_unique = true;
 	int inf_ID = 0;
 	if (ninf0 != 0){
-		int nIDs = file.size();
+		int nIDs = town_agents.size();
 		// Random choice of IDs
 		for (int i=0; i<ninf0; ++i){
 			not_unique = true;
@@ -407,133 +312,27 @@ void ABM::load_agents(const std::string fname, const int ninf0)
 		}
 	}
 
-	// Counter for agent IDs
-	int agent_ID = 1;
-	
-	// One agent per line, with properties as defined in the line
-	for (auto agent : file){
-		// Agent status
-		bool student = false, works = false, livesRH = false, worksRH = false,  
-			 worksSch = false, patient = false, hospital_staff = false,
-			 works_from_home = false;
-		int house_ID = -1, workID = 0, cpID = 0, ptID = 0;
-		double work_travel_time = 0.0;
-		std::string work_travel_mode;
-				
-		// Household ID only if not hospitalized with condition
-		// different than COVID-19
-		if (std::stoi(agent.at(6)) == 1){
-			patient = true;
-			house_ID = 0;
-		}else{
-			house_ID = std::stoi(agent.at(5));
-		}
-
-		// No school or work if patient with condition other than COVID
-		if (std::stoi(agent.at(12)) == 1 && !patient){
-			hospital_staff = true;
-		}
-		if (std::stoi(agent.at(0)) == 1 && !patient){
-			student = true;
-		}
-	   	// No work flag if a hospital employee	
-		if (std::stoi(agent.at(1)) == 1 && !(patient || hospital_staff)){
-			works = true; 
-		}
-			
-		// Random or from the input file
-		bool infected = false;
+	for (const auto& town_agent : town_agents){
+		Agent agent(town_agent);
+		// Random or as in the input file
 		if (ninf0 != 0){
-			auto iter = std::find(infected_IDs.begin(), infected_IDs.end(), agent_ID); 
+			auto iter = std::find(infected_IDs.begin(), infected_IDs.end(), agent.get_ID()); 
+			agent.set_infected(iter != infected_IDs.end());
 			if (iter != infected_IDs.end()){
 				infected_IDs.erase(iter);
-				infected = true;
-				n_infected_tot++;
-			}
-		} else {
-			if (std::stoi(agent.at(14)) == 1){
-				infected = true;
-				n_infected_tot++;
 			}
 		}
-
-		// Retirement home resident
-		if (std::stoi(agent.at(8)) == 1){
-			 livesRH = true;
-		}
-		// Retirement home or school employee
-		if (std::stoi(agent.at(9)) == 1){
-			 worksRH = true;
-		}
-		if (std::stoi(agent.at(10)) == 1){
-			 worksSch = true;
-		}
-
-		// Select correct work ID for special employment types
-		// Hospital ID is set separately, but for consistency
-		if (worksRH || worksSch || hospital_staff) {
-			workID = std::stoi(agent.at(18));
-		} else if (works) {
-			workID = std::stoi(agent.at(11));
-		}
-
-		// Transit information
-		if (std::stoi(agent.at(15)) == 1) {
-			works_from_home = true;
-			work_travel_mode = agent.at(17);
-		} else {
-			if (!(works || hospital_staff)) {
-				work_travel_mode = "None";
-			} else {
-				work_travel_mode = agent.at(17);
-				if (work_travel_mode == "carpool") {
-					cpID = std::stoi(agent.at(19));
-				}
-				if (work_travel_mode == "public") {
-					ptID = std::stoi(agent.at(20));
-				}
-				work_travel_time = std::stod(agent.at(16));
-			}
-		}
-		Agent temp_agent(student, works, std::stoi(agent.at(2)), 
-			std::stod(agent.at(3)), std::stod(agent.at(4)), house_ID,
-			patient, std::stoi(agent.at(7)), livesRH, worksRH,
-		    worksSch, workID, hospital_staff, std::stoi(agent.at(13)), 
-			infected, work_travel_mode, work_travel_time, cpID, ptID, 
-			works_from_home);
-
-		// Set agent occupation
-		std::string work_type = agent.at(21);
-		std::string rate_by_type;
-		temp_agent.set_occupation(work_type);
-		// And the corresponding transmission rate
-		double work_rate = 0.0;	 
-		if (work_type != "none") {
-			if (work_type == "A") { 
-				rate_by_type = "management science art transmission rate";
-			} else if (work_type == "B") { 
-				rate_by_type = "service occupation transmission rate";
-			} else if (work_type == "C") { 
-				rate_by_type = "sales office transmission rate"; 
-			} else if (work_type == "D") { 
-				rate_by_type = "construction maintenance transmission rate"; 
-			} else if (work_type == "E") { 
-				rate_by_type = "production transportation transmission rate"; 
-			} 
-			temp_agent.set_occupation_transmission(infection_parameters.at(rate_by_type));
-		}
-
-		// Set Agent ID
-		temp_agent.set_ID(agent_ID++);
-		
 		// Set properties for exposed if initially infected
-		if (temp_agent.infected() == true){
-			initial_exposed(temp_agent);
-		}	
-		
+		if (agent.infected()){
+			n_infected_tot++;
+			initial_exposed(agent);
+		}
 		// Store
-		agents.push_back(temp_agent);
+		agents.push_back(agent);
 	}
+	population_states.recount(agents);
+	vaccinations.stop_tracking_eligibility();
+	vaccine_effects.invalidate();
 }
 
 // Assign agents to households, schools, and worplaces
@@ -593,12 +392,12 @@ void ABM::register_agents()
 		}
 
 		// Register transit if carpool or public
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			tr_ID = agent.get_carpool_ID();
 			Transit& carpool = carpools.at(tr_ID-1);
 			carpool.register_agent(agent_ID, infected);	
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			tr_ID = agent.get_public_transit_ID();
 			Transit& public_tr = public_transit.at(tr_ID-1);
 			public_tr.register_agent(agent_ID, infected);	
@@ -613,10 +412,10 @@ void ABM::initial_exposed(Agent& agent)
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(parameters.time_from_exposed_to_infectiousness, latency);
 	if (never_sy){
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -645,7 +444,7 @@ void ABM::initialize_vac_and_reopening(const bool dont_vac)
 	n_vaccinated = static_cast<int>(infection_parameters.at("initially vaccinated"));
 	random_vaccines = true;
 	// To invoke flu, testing, and vaccinations
-	infection_parameters.at("start testing") = 0.0;
+	set_infection_parameter("start testing", 0.0);
 	start_testing_flu_and_vaccination(dont_vac);
 	
 	// Schools - constant reduction
@@ -692,7 +491,7 @@ void ABM::initialize_vac_and_reopening(const bool dont_vac)
 	ini_frac_les = infection_parameters.at("leisure - fraction - initial");
 	del_frac_les = infection_parameters.at("leisure - fraction - final")
 					-infection_parameters.at("leisure - fraction - initial");
-	infection_parameters.at("leisure - fraction") = ini_frac_les;
+	set_infection_parameter("leisure - fraction", ini_frac_les);
 	for (auto& leisure_location : leisure_locations) {
 		if (leisure_location.outside_town()) {
 			leisure_location.set_outside_lambda(ini_beta_les*infection_parameters.at("fraction estimated infected"));
@@ -700,6 +499,38 @@ void ABM::initialize_vac_and_reopening(const bool dont_vac)
 			leisure_location.change_transmission_rate(ini_beta_les);
 		}
 	}
+	// Place contributions depend on the transmission rates
+	contribution_records.invalidate();
+}
+
+// Number of threads used for processing agents and mobility setup
+void ABM::set_number_of_threads(const int n)
+{
+	if (n < 1) {
+		throw std::invalid_argument("Number of threads needs to be at least 1, requested: "
+										+ std::to_string(n));
+	}
+	n_threads = n;
+	mobility.set_number_of_threads(n);
+}
+
+// Switch between precomputed and looked up routine places of agents
+void ABM::set_place_incidence(const bool on)
+{
+	use_place_incidence = on;
+}
+
+// Switch between incremental and full computation of place contributions
+void ABM::set_incremental_contributions(const bool on)
+{
+	// Full computation starts from zero
+	if (incremental_contributions && !on) {
+		contributions.reset_sums(households, schools, workplaces, hospitals, 
+						retirement_homes, carpools, public_transit, leisure_locations);
+	}
+	incremental_contributions = on;
+	contribution_records.invalidate();
+	touched_places.invalidate();
 }
 
 // Start with N_inf agents that have COVID-19 in various stages
@@ -731,7 +562,7 @@ void ABM::initialize_active_cases(const int N_inf, const bool vaccinate, const i
 	if (N_inf > can_have_covid.size()) {
 		std::cerr << "Requested number of agents to initially have covid "
 				  << "larger than number of available agents" << std::endl;
-		throw std::invalid_argument("Too many agents to have covid: " + N_inf);
+		throw std::invalid_argument("Too many agents to have covid: " + std::to_string(N_inf));
 	}
 	for (int i=0; i<N_inf; ++i) {
 		Agent& agent = agents.at(can_have_covid.at(i)-1);
@@ -744,6 +575,8 @@ void ABM::initialize_active_cases(const int N_inf, const bool vaccinate, const i
 			process_initial_symptomatic(agent);
 		}
 	}
+	population_states.recount(agents);
+	vaccinations.stop_tracking_eligibility();
 }
 
 // Initialize an asymptomatic agent, randomly in the course of disease
@@ -763,9 +596,9 @@ void ABM::process_initial_asymptomatic(Agent& agent)
 	// Total latency period offset with a random number from 0 to 1
 	double latency = infection.latency()*infection.get_uniform();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(parameters.time_from_exposed_to_infectiousness, latency);
 	// Set to total latency + infectiousness duration, also offset
-	double rec_time = infection_parameters.at("recovery time")*infection.get_uniform();
+	double rec_time = parameters.recovery_time*infection.get_uniform();
 	agent.set_latency_duration(latency + rec_time);
 	agent.set_latency_end_time(time);
 	agent.set_infectiousness_start_time(time, dt_ninf);
@@ -780,12 +613,12 @@ void ABM::process_initial_asymptomatic(Agent& agent)
 	if (testing.started(time)) {
 		if (agent.hospital_employee()) {
 			hsp_employee_transitions.set_testing_status(agent, infection, time, schools, 
-							hospitals, infection_parameters, testing);
+							hospitals, parameters, testing);
 		} else if (agent.hospital_non_covid_patient()) {
-			hsp_patient_transitions.set_testing_status(agent, infection, time, hospitals, infection_parameters, testing);
+			hsp_patient_transitions.set_testing_status(agent, infection, time, hospitals, parameters, testing);
 		} else {
     		regular_transitions.set_testing_status(agent, infection, time, schools,
-        		workplaces, hospitals, retirement_homes, carpools, public_transit, infection_parameters, testing);
+        		workplaces, hospitals, retirement_homes, carpools, public_transit, parameters, testing);
 		}
 
 		// If tested, randomly choose if pre-test, being tested now, or waiting for results
@@ -855,12 +688,12 @@ void ABM::process_initial_symptomatic(Agent& agent)
 		} else {
 			agent.set_dying(false);
 			agent.set_recovering(true);			
-			agent.set_recovery_duration(infection_parameters.at("recovery time")*infection.get_uniform());
+			agent.set_recovery_duration(parameters.recovery_time*infection.get_uniform());
 			agent.set_recovery_time(time);		
 		}
 		if (testing.started(time)) {
 			hsp_employee_transitions.set_testing_status(agent, infection, time, schools,
-                        hospitals, infection_parameters, testing);
+                        hospitals, parameters, testing);
 		}
 	} else if (agent.hospital_non_covid_patient()) {
 		// Removal settings
@@ -876,16 +709,16 @@ void ABM::process_initial_symptomatic(Agent& agent)
 		} else {
 			states_manager.set_recovering_symptomatic(agent);			
 			// This may change if treatment is ICU
-			agent.set_recovery_duration(infection_parameters.at("recovery time"));
+			agent.set_recovery_duration(parameters.recovery_time);
 			agent.set_recovery_time(time);		
 		}
 		if (testing.started(time)) {
-			hsp_patient_transitions.set_testing_status(agent, infection, time, hospitals, infection_parameters, testing);
+			hsp_patient_transitions.set_testing_status(agent, infection, time, hospitals, parameters, testing);
 		}
 	} else {
     	regular_transitions.untested_sy_setup(agent, infection, time, dt, households, 
                 schools, workplaces, hospitals, retirement_homes,
-                carpools, public_transit, infection_parameters, testing);
+                carpools, public_transit, parameters, testing);
 	}
 
 	// If tested, randomly choose if pre-test, being tested now, or waiting for results
@@ -946,8 +779,15 @@ void ABM::vaccinate_random()
 //		std::cout << "Requested number of agents to vaccinate exceeds" 
 //				  << " the maximum allowable count - reducing to " << n_vaccinated << std::endl; 
 	}
+	// Eligible agents are tracked with the changes, 
+	// rebuilt if the agents were modified outside of the model
+	synchronize_agent_records();
+	if (!vaccinations.tracking_eligibility()) {
+		vaccinations.track_eligibility(agents);
+	}
 	// Vaccinate if possible, update the counter
 	cur_vaccinated = vaccinations.vaccinate_random(agents, n_vaccinated, infection, time);	
+	vaccine_effects.invalidate();
 	total_vaccinated += cur_vaccinated;
 }
 
@@ -965,8 +805,15 @@ void ABM::vaccinate_random_time_offset()
 				  << " the maximum allowable count - reducing to " << n_vaccinated << std::endl; 
 	}
 
+	// Eligible agents are tracked with the changes, 
+	// rebuilt if the agents were modified outside of the model
+	synchronize_agent_records();
+	if (!vaccinations.tracking_eligibility()) {
+		vaccinations.track_eligibility(agents);
+	}
 	// Vaccinate if possible, update the counter
 	cur_vaccinated = vaccinations.vaccinate_random_time_offset(agents, n_vaccinated, infection, time);	
+	vaccine_effects.invalidate();
 	total_vaccinated += cur_vaccinated;		
 }
 
@@ -987,10 +834,17 @@ void ABM::vaccinate_group()
 	if (total_vaccinated >= infection_parameters.at("Maximum number to vaccinate")) {
 		return; 
 	}
+	// Eligible agents and group members are tracked with the changes, 
+	// rebuilt if the agents were modified outside of the model
+	synchronize_agent_records();
+	if (!vaccinations.tracking_eligibility()) {
+		vaccinations.track_eligibility(agents);
+	}
 	// Vaccinate all in the group
 	bool vac_all = true;
 	cur_vaccinated = vaccinations.vaccinate_group(agents, vaccine_group_name, n_vaccinated, 
 							infection, time, vac_all);	
+	vaccine_effects.invalidate();
 	if (vac_verbose){
 		std::cout << "Total number of vaccinated in the group " 
 				  << vaccine_group_name << " " << cur_vaccinated << std::endl;
@@ -1052,7 +906,9 @@ void ABM::reopen_leisure_locations()
 	double new_tr_rate = 0.0;
 	new_tr_rate = ini_beta_les + infection_parameters.at("leisure reopening rate")*del_beta_les*time;
 	new_tr_rate = std::min(new_tr_rate, infection_parameters.at("leisure locations transmission rate"));
-	// Increase transmission rate, or the (highest) normal rate 
+	// Increase transmission rate, or the (highest) normal rate; 
+	// contributions to leisure locations don't include it, so 
+	// the recorded contributions stay valid
 	for (auto& leisure_location : leisure_locations) {
 		leisure_location.change_transmission_rate(new_tr_rate);
 	}
@@ -1060,37 +916,49 @@ void ABM::reopen_leisure_locations()
 	double new_frac = 0.0;
 	new_frac = ini_frac_les + infection_parameters.at("leisure reopening rate")*del_frac_les*time;
 	new_frac = std::min(new_frac, infection_parameters.at("leisure - fraction - final"));
-	infection_parameters.at("leisure - fraction") = new_frac;
+	set_infection_parameter("leisure - fraction", new_frac);
 }
 
 // Assign leisure locations for this step
 void ABM::distribute_leisure()
 {
-	// Remove previous leisure assignments
-	// Reset the ID for all that had a location 
-	// This includes all agents, passed as well
+	// Remove previous leisure assignments - visitors of
+	// each location are all removed at once and only agents
+	// that had a location need the ID reset; the first time,
+	// and after the agents were modified outside of the model,
+	// all agents are checked, passed as well
+	synchronize_agent_records();
+	if (!leisure_tracked) {
+		leisure_agent_IDs.clear();
+		for (const auto& agent : agents) {
+			if (agent.get_leisure_ID() > 0) {
+				leisure_agent_IDs.push_back(agent.get_ID());
+			}
+		}
+		leisure_tracked = true;
+	}
 	int old_loc_ID = 0;
-	for (auto& agent : agents) {
+	for (const int aID : leisure_agent_IDs) {
+		Agent& agent = agents.at(aID-1);
 		old_loc_ID = agent.get_leisure_ID();
-		if (old_loc_ID > 0) {
-			if (agent.get_leisure_type() == "household") {
-				households.at(old_loc_ID - 1).remove_agent(agent.get_ID());
-			} else if (agent.get_leisure_type() == "public") {
-				// Only remove in-town leisure locations
-				if(!leisure_locations.at(old_loc_ID -1).outside_town()){
-					leisure_locations.at(old_loc_ID - 1).remove_agent(agent.get_ID());
-				}
-			} else {
-				throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
-			}
+		if (agent.get_leisure_location_type() == LeisureType::household) {
+			households.at(old_loc_ID - 1).clear_visitors();
+		} else if (agent.get_leisure_location_type() == LeisureType::public_location) {
+			// Outside of town locations have no visitors
+			leisure_locations.at(old_loc_ID - 1).clear_visitors();
+		} else {
+			throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
 		}
 		agent.set_leisure_ID(0);
 	}
+	leisure_agent_IDs.clear();
 
 	// One leisure location per household, or one per each more mobile agent
 	// Automatically excludes hospital patients (including non-COVID ones)
 	// and retirement home residents; also passed agents, alive and removed participate
 	int house_ID = 0;
+	// For agents that go alone
+	std::vector<int> one_agent(1, 0);
 	for (auto& house : households) {
 		house_ID = house.get_ID();
 		// Exclude fully isolated
@@ -1098,10 +966,11 @@ void ABM::distribute_leisure()
 			continue;
 		}
 		// Looping through households automatically excludes 
-		// agents that died and that are hospitalized
-		std::vector<int> agent_IDs = house.get_agent_IDs();
+		// agents that died and that are hospitalized; guests
+		// never go to their own household so this one doesn't change
+		const std::vector<int>& agent_IDs = house.get_agent_IDs();
 		// First check for the whole household
-		if (infection.get_uniform() > infection_parameters.at("leisure - fraction")) {
+		if (infection.get_uniform() > parameters.leisure_fraction) {
 			// Then if household as a whole is not going, check each vaccinated agent
 			for (auto& aID : agent_IDs) {
 				if (agents.at(aID-1).get_household_ID() != house_ID) {
@@ -1109,14 +978,13 @@ void ABM::distribute_leisure()
 				}
 				// Eligible and fully vaccinated at peak of effectiveness
 				if (agents.at(aID-1).more_active()) {
-					if (infection.get_uniform() > infection_parameters.at("leisure - fraction")
-							*infection_parameters.at("vaccinations - mobility increase factor")) {
+					if (infection.get_uniform() > parameters.leisure_fraction
+							*parameters.vaccinations_mobility_increase_factor) {
 						continue;
 					} else {
 						// Each gets a potentially different location if eligible
-						// Constructing a temporary in a pass by ref function is only 
-						// possible because the argument is actually a const reference
-						check_select_and_register_leisure_location(std::vector<int>{aID}, house_ID);
+						one_agent.at(0) = aID;
+						check_select_and_register_leisure_location(one_agent, house_ID);
 					}										
 				} 
 			}		
@@ -1180,19 +1048,20 @@ void ABM::check_select_and_register_leisure_location(const std::vector<int>& age
 		}
 		// Register an eligible agent at the leisure location
 		if (is_house) {
-			households.at(loc_ID-1).add_agent(aID);
-			agents.at(aID-1).set_leisure_type("household");
+			households.at(loc_ID-1).add_visitor(aID);
+			agents.at(aID-1).set_leisure_type(LeisureType::household);
 			agents.at(aID-1).set_leisure_ID(loc_ID);
 			// Record this visit
 			contact_tracing.add_household(aID, loc_ID, static_cast<int>(time));
 		} else if (is_public) {
 			// Only add if leisure location is within town
 			if(!leisure_locations.at(loc_ID-1).outside_town()){
-				leisure_locations.at(loc_ID-1).add_agent(aID);
+				leisure_locations.at(loc_ID-1).add_visitor(aID);
 			}
-			agents.at(aID-1).set_leisure_type("public");
+			agents.at(aID-1).set_leisure_type(LeisureType::public_location);
 			agents.at(aID-1).set_leisure_ID(loc_ID);
 		}
+		leisure_agent_IDs.push_back(aID);
 	}
 }
 
@@ -1206,6 +1075,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 
 	// Closures
 	if (equal_floats<double>(time, infection_parameters.at("school closure"), tol)){
+		// Place contributions depend on the transmission rates
+		contribution_records.invalidate();
 		new_tr_rate = 0.0;
 		for (auto& school : schools){
 			school.change_transmission_rate(new_tr_rate);
@@ -1213,6 +1084,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 		}
 	}
 	if (equal_floats<double>(time, infection_parameters.at("lockdown"), tol)){
+		// Place contributions depend on the transmission rates
+		contribution_records.invalidate();
 		new_tr_rate = infection_parameters.at("workplace transmission rate")*infection_parameters.at("fraction of ld businesses");
 		for (auto& workplace : workplaces){
 			if (workplace.outside_town()) {
@@ -1233,7 +1106,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 			}
 		}
 		// Fraction of people going to leisure locations
-		infection_parameters.at("leisure - fraction") *= infection_parameters.at("fraction of ld businesses");
+		set_infection_parameter("leisure - fraction", parameters.leisure_fraction
+								*infection_parameters.at("fraction of ld businesses"));
 		// Carpools
 		new_tr_rate = infection_parameters.at("carpool transmission rate")*infection_parameters.at("fraction of ld businesses");
 		for (auto& car  : carpools) {
@@ -1250,6 +1124,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 
 	// Reopening, phase 1
 	if (equal_floats<double>(time, infection_parameters.at("reopening phase 1"), tol)){
+		// Place contributions depend on the transmission rates
+		contribution_records.invalidate();
 		new_tr_rate = infection_parameters.at("workplace transmission rate") * 
 				infection_parameters.at("fraction of phase 1 businesses");
 		for (auto& workplace : workplaces){
@@ -1274,8 +1150,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 			}
 		}
 		// Fraction of people going to leisure locations
-		infection_parameters.at("leisure - fraction") 
-				*= (infection_parameters.at("fraction of phase 1 businesses")/infection_parameters.at("fraction of ld businesses"));
+		set_infection_parameter("leisure - fraction", parameters.leisure_fraction
+				*(infection_parameters.at("fraction of phase 1 businesses")/infection_parameters.at("fraction of ld businesses")));
 		// Carpools
 		new_tr_rate = infection_parameters.at("carpool transmission rate")*infection_parameters.at("fraction of phase 1 businesses");
 		for (auto& car  : carpools) {
@@ -1292,6 +1168,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 
 	// Reopening, phase 2
 	if (equal_floats<double>(time, infection_parameters.at("reopening phase 2"), tol)){
+		// Place contributions depend on the transmission rates
+		contribution_records.invalidate();
 		new_tr_rate = infection_parameters.at("workplace transmission rate") * 
 				infection_parameters.at("fraction of phase 2 businesses");
 		for (auto& workplace : workplaces){
@@ -1316,8 +1194,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 			}
 		}
 		// Fraction of people going to leisure locations
-		infection_parameters.at("leisure - fraction") 
-				*= (infection_parameters.at("fraction of phase 2 businesses")/infection_parameters.at("fraction of phase 1 businesses"));
+		set_infection_parameter("leisure - fraction", parameters.leisure_fraction
+				*(infection_parameters.at("fraction of phase 2 businesses")/infection_parameters.at("fraction of phase 1 businesses")));
 		// Carpools
 		new_tr_rate = infection_parameters.at("carpool transmission rate")*infection_parameters.at("fraction of phase 2 businesses");
 		for (auto& car  : carpools) {
@@ -1334,6 +1212,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 
 	// Reopening, phase 3
 	if (equal_floats<double>(time, infection_parameters.at("reopening phase 3"), tol)){
+		// Place contributions depend on the transmission rates
+		contribution_records.invalidate();
 		new_tr_rate = infection_parameters.at("workplace transmission rate") * 
 				infection_parameters.at("fraction of phase 3 businesses");
 		for (auto& workplace : workplaces){
@@ -1358,8 +1238,8 @@ void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& wor
 			}
 		}
 		// Fraction of people going to leisure locations
-		infection_parameters.at("leisure - fraction") 
-				*= (infection_parameters.at("fraction of phase 3 businesses")/infection_parameters.at("fraction of phase 2 businesses"));
+		set_infection_parameter("leisure - fraction", parameters.leisure_fraction
+				*(infection_parameters.at("fraction of phase 3 businesses")/infection_parameters.at("fraction of phase 2 businesses")));
 		// Carpools
 		new_tr_rate = infection_parameters.at("carpool transmission rate")*infection_parameters.at("fraction of phase 3 businesses");
 		for (auto& car  : carpools) {
@@ -1383,6 +1263,7 @@ void ABM::set_outside_workplace_transmission()
 			workplace.set_outside_lambda(infection_parameters.at("fraction estimated infected"));
 		}
 	}
+	contribution_records.invalidate();
 }
 
 // Update transmission dynamics in leisure locations outside of the town
@@ -1393,13 +1274,151 @@ void ABM::set_outside_leisure_transmission()
 			leisure_location.set_outside_lambda(infection_parameters.at("out-of-town leisure transmission"));
 		}
 	}
+	contribution_records.invalidate();
 }
 
 
 // Count contributions of all infectious agents in each place
 void ABM::compute_place_contributions()
 {
-	for (const auto& agent : agents){
+	check_place_storage();
+	if (incremental_contributions) {
+		update_place_contributions();
+		return;
+	}
+	// In order of IDs, same as if all agents were processed
+	const std::vector<int>& contributing_IDs = current_population_states().get_contributing_IDs();
+	const std::vector<DeferredUpdates> updates = compute_contributions_in_parallel(contributing_IDs);
+	if (touched_places.valid()) {
+		// All other places have no contributions
+		touched_places.add(updates);
+		for (Place* place : touched_places.get_places()) {
+			place->compute_infected_contribution();
+		}
+	} else {
+		contributions.total_place_contributions(households, schools, 
+											workplaces, hospitals, retirement_homes,
+											carpools, public_transit, leisure_locations);
+	}
+}
+
+// Contributions of agents from a list computed and added to the places in parallel
+std::vector<DeferredUpdates> ABM::compute_contributions_in_parallel(const std::vector<int>& agent_IDs)
+{
+	const std::size_t n_workers = number_of_workers(agent_IDs.size());
+
+	// Places are numbered over all the types, in order of storage,
+	// and each thread owns a contiguous range of these numbers
+	const std::vector<std::size_t> n_places = {households.size(), schools.size(), 
+				workplaces.size(), hospitals.size(), retirement_homes.size(), 
+				carpools.size(), public_transit.size(), leisure_locations.size()};
+	std::vector<std::size_t> offsets(1, 0);
+	for (const auto& n : n_places) {
+		offsets.push_back(offsets.back() + n);
+	}
+	const std::less<const Place*> before;
+	auto owner = [&](const Place* place) -> std::size_t {
+		for (std::size_t k = 0; k < n_places.size(); ++k) {
+			if (!before(place, place_storage.at(2*k)) && before(place, place_storage.at(2*k+1))) {
+				const std::size_t ip = offsets.at(k) + place->get_ID() - 1;
+				return std::min(ip*n_workers/offsets.back(), n_workers - 1);
+			}
+		}
+		throw std::runtime_error("Contribution recorded for a place not stored in the model");
+	};
+
+	// Records of each thread, split by the thread that owns the place
+	std::vector<std::vector<DeferredUpdates>> by_owner(n_workers, 
+					std::vector<DeferredUpdates>(n_workers));
+	std::vector<DeferredUpdates> updates = process_in_parallel(agent_IDs.size(),
+			[&](const int iw, const int first, const int last, DeferredUpdates& recorded) 
+			{
+				compute_agent_contributions(agent_IDs, first, last);
+				for (const auto& upd : recorded.get_updates()) {
+					by_owner.at(iw).at(owner(upd.place)).record(upd.type, upd.ID, upd.place, upd.value);
+				}
+			});
+
+	// Each thread adds the records for its places, in order of agents, 
+	// so the sums don't depend on the number of threads
+	process_in_parallel(n_workers, 
+			[&](const int, const int first, const int last, DeferredUpdates&)
+			{
+				// No other thread modifies these places
+				DeferredUpdates::stop_recording();
+				for (int io = first; io < last; ++io) {
+					for (const auto& worker_records : by_owner) {
+						for (const auto& upd : worker_records.at(io).get_updates()) {
+							if (upd.type == DeferredUpdates::Type::place_contribution) {
+								upd.place->add_contribution(upd.value, upd.ID);
+							} else if (upd.type == DeferredUpdates::Type::hospital_tested) {
+								static_cast<Hospital*>(upd.place)->increase_total_tested(upd.ID);
+							}
+						}
+					}
+				}
+			});
+	return updates;
+}
+
+// Set the lambda factors to 0.0, unless contributions are updated incrementally
+void ABM::reset_contributions()
+{
+	if (incremental_contributions) {
+		return;
+	}
+	check_place_storage();
+	if (touched_places.valid()) {
+		for (Place* place : touched_places.get_places()) {
+			place->reset_contributions();
+		}
+		touched_places.clear();
+		return;
+	}
+	contributions.reset_sums(households, schools, workplaces, hospitals, 
+				retirement_homes, carpools, public_transit, leisure_locations);
+	// Outside of town places have contributions without agents
+	std::vector<Place*> outside;
+	for (auto& workplace : workplaces) {
+		if (workplace.outside_town()) {
+			outside.push_back(&workplace);
+		}
+	}
+	for (auto& leisure_location : leisure_locations) {
+		if (leisure_location.outside_town()) {
+			outside.push_back(&leisure_location);
+		}
+	}
+	touched_places.reset(outside);
+}
+
+// Invalidate records of places if any vector of places was replaced or could have been modified
+void ABM::check_place_storage()
+{
+	std::vector<const Place*> current;
+	auto add_storage = [&current](const Place* first, const Place* last)
+		{ current.push_back(first); current.push_back(last); };
+	add_storage(households.data(), households.data() + households.size());
+	add_storage(schools.data(), schools.data() + schools.size());
+	add_storage(workplaces.data(), workplaces.data() + workplaces.size());
+	add_storage(hospitals.data(), hospitals.data() + hospitals.size());
+	add_storage(retirement_homes.data(), retirement_homes.data() + retirement_homes.size());
+	add_storage(carpools.data(), carpools.data() + carpools.size());
+	add_storage(public_transit.data(), public_transit.data() + public_transit.size());
+	add_storage(leisure_locations.data(), leisure_locations.data() + leisure_locations.size());
+	if (places_modifiable || current != place_storage) {
+		touched_places.invalidate();
+		contribution_records.invalidate();
+		place_storage = current;
+		places_modifiable = false;
+	}
+}
+
+// Contributions of a contiguous group of agents from a list
+void ABM::compute_agent_contributions(const std::vector<int>& agent_IDs, const int first, const int last)
+{
+	for (int ia = first; ia < last; ++ia) {
+		const Agent& agent = agents.at(agent_IDs.at(ia)-1);
 
 		// Only removed - dead don't contribute
 		if (agent.removed_dead() == true) {
@@ -1432,27 +1451,67 @@ void ABM::compute_place_contributions()
 			throw std::runtime_error("Agent does not have any state");
 		}
 	}
-	contributions.total_place_contributions(households, schools, 
+}
+
+// Add changes in contributions of agents since the last step
+void ABM::update_place_contributions()
+{
+	const std::vector<int>& contributing_IDs = current_population_states().get_contributing_IDs();
+	const bool rebuild = !contribution_records.valid();
+	if (rebuild) {
+		++n_contribution_rebuilds;
+		contributions.reset_sums(households, schools, workplaces, hospitals, 
+						retirement_homes, carpools, public_transit, leisure_locations);
+		contribution_records.reset(agents.size());
+		recorded_IDs.clear();
+	}
+
+	// Agents that contribute now or did before, in order of IDs
+	std::vector<int> candidate_IDs;
+	std::set_union(contributing_IDs.begin(), contributing_IDs.end(), 
+					recorded_IDs.begin(), recorded_IDs.end(), std::back_inserter(candidate_IDs));
+	std::vector<int> one_agent(1, 0);
+	DeferredUpdates agent_updates;
+	for (const auto& aID : candidate_IDs) {
+		const bool contributing = std::binary_search(contributing_IDs.begin(), 
+									contributing_IDs.end(), aID);
+		const ContributionRecords::Key key = ContributionRecords::key_of(agents.at(aID-1), 
+													contributing, time);
+		if (!contribution_records.changed(aID, key)) {
+			continue;
+		}
+		// Record the new contributions instead of adding them
+		agent_updates.clear();
+		if (contributing) {
+			one_agent.at(0) = aID;
+			agent_updates.start_recording();
+			try {
+				compute_agent_contributions(one_agent, 0, 1);
+			} catch (...) {
+				DeferredUpdates::stop_recording();
+				throw;
+			}
+			DeferredUpdates::stop_recording();
+		}
+		contribution_records.replace(aID, key, agent_updates.get_updates());
+	}
+	recorded_IDs = contributing_IDs;
+
+	if (rebuild) {
+		contributions.total_place_contributions(households, schools, 
 											workplaces, hospitals, retirement_homes,
 											carpools, public_transit, leisure_locations);
+	} else {
+		for (Place* place : contribution_records.places_to_update()) {
+			place->compute_infected_contribution();
+		}
+	}
 }
 
 // Determine infection propagation and
 // state changes 
 void ABM::compute_state_transitions()
 {
-	int newly_infected = 0, is_recovered = 0;
-	bool re_vac = false;
-	// Infected state change flags: 
-	// recovered - healthy, recovered - dead, tested at this step,
-	// tested positive at this step, tested false negative
-	std::vector<int> state_changes = {0, 0, 0, 0, 0};
-	// Susceptible state changes
-	// infected, tested, tested negative, tested false positive
-	std::vector<int> s_state_changes = {0, 0, 0, 0};
-	// First entry is one if agent recovered, second if agent died
-	std::vector<int> removed = {0,0};
-
 	// Store information for that day
 	n_infected_day.push_back(0);
 	tested_day.push_back(0);
@@ -1461,7 +1520,104 @@ void ABM::compute_state_transitions()
 	tested_false_pos_day.push_back(0);
 	tested_false_neg_day.push_back(0);
 
-	for (auto& agent : agents){
+	const int n_workers = number_of_workers();
+	const int step = static_cast<int>(std::round(time/dt));
+
+	// Each worker has its own generator and statistics, generators 
+	// are kept between steps and copied only if infection could change
+	if (infection_modifiable || static_cast<int>(worker_infections.size()) != n_workers) {
+		Infection worker_infection(infection);
+		worker_infection.set_rng_purpose(RNGPurpose::transitions);
+		worker_infections.assign(n_workers, worker_infection);
+	}
+	std::vector<TransitionCounts> counts(n_workers);
+	// Agents with states different than counted
+	std::vector<std::vector<int>> changed_IDs(n_workers);
+
+	// Routine places are used only if on and built for the current agents
+	const PlaceIncidence* incidence = nullptr;
+	if (use_place_incidence 
+			&& (place_incidence.get_number_of_agents() == static_cast<int>(agents.size()))) {
+		place_incidence.update_lambdas(households, retirement_homes, schools, workplaces,
+				hospitals, carpools, public_transit, leisure_locations);
+		incidence = &place_incidence;
+	}
+	// Effectiveness of all the vaccinated agents at once
+	synchronize_agent_records();
+	vaccine_effects.update(agents, time);
+
+	std::vector<DeferredUpdates> updates = process_agents_in_parallel(
+			[&](const int iw, const int first, const int last, DeferredUpdates& worker_updates) {
+				compute_agent_transitions(first, last, step, worker_infections.at(iw), 
+											counts.at(iw), worker_updates, changed_IDs.at(iw), 
+											incidence, &vaccine_effects); });
+
+	for (const auto& worker_IDs : changed_IDs) {
+		for (const auto& aID : worker_IDs) {
+			update_agent_records(agents.at(aID-1));
+		}
+	}
+
+	for (const auto& cnt : counts) {
+		n_infected_tot += cnt.infected;
+		// True infected by timestep, from the first time step
+		n_infected_day.back() += cnt.infected;
+		n_recovering_exposed += cnt.recovering_exposed;
+		n_recovered_tot += cnt.recovered;
+		n_dead_tested += cnt.dead_tested;
+		n_dead_not_tested += cnt.dead_not_tested;
+		n_dead_tot += cnt.dead_tested + cnt.dead_not_tested;
+		tested_day.back() += cnt.tested;
+		tot_tested += cnt.tested;
+		tested_pos_day.back() += cnt.tested_pos;
+		tot_tested_pos += cnt.tested_pos;
+		tested_neg_day.back() += cnt.tested_neg;
+		tot_tested_neg += cnt.tested_neg;
+		tested_false_pos_day.back() += cnt.tested_false_pos;
+		tot_tested_false_pos += cnt.tested_false_pos;
+		tested_false_neg_day.back() += cnt.tested_false_neg;
+		tot_tested_false_neg += cnt.tested_false_neg;
+		// Subtract from total since re-vaccinating (to not count twice)
+		total_vaccinated -= cnt.re_vaccinated;
+	}
+
+	apply_deferred_updates(updates);
+}
+
+// Rebuild records of the agents if they were modified outside of the model
+void ABM::synchronize_agent_records()
+{
+	// Recounted only if not already done since the changes
+	current_population_states();
+	if (!agents_changed) {
+		return;
+	}
+	if (vaccinations.tracking_eligibility()) {
+		vaccinations.track_eligibility(agents);
+	}
+	vaccine_effects.invalidate();
+	leisure_tracked = false;
+	agents_changed = false;
+}
+
+// State transitions of a contiguous group of agents
+void ABM::compute_agent_transitions(const int first, const int last, const int step,
+					Infection& local_infection, TransitionCounts& counts, 
+					DeferredUpdates& updates, std::vector<int>& changed_IDs,
+					const PlaceIncidence* incidence, const VaccineEffects* vac_effects)
+{
+	// Infected state change flags: 
+	// recovered - healthy, recovered - dead, tested at this step,
+	// tested positive at this step, tested false negative
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
+	// Susceptible state changes
+	// infected, tested, tested negative, tested false positive
+	SusceptibleStateChanges s_state_changes = {0, 0, 0, 0};
+	// Collect only after a specified time
+	const bool collect_data = time >= parameters.time_to_start_data_collection;
+
+	for (int ia = first; ia < last; ++ia) {
+		Agent& agent = agents.at(ia);
 
 		// Skip the removed - dead 
 		if (agent.removed_dead() == true){
@@ -1470,49 +1626,43 @@ void ABM::compute_state_transitions()
 
 		std::fill(state_changes.begin(), state_changes.end(), 0);
 		std::fill(s_state_changes.begin(), s_state_changes.end(), 0);
+		local_infection.set_rng_stream(agent.get_ID(), step);
+		// Counted states and eligibility for vaccination depend only on the flags
+		const std::uint64_t flags_before = agent.get_state_flags();
 
-		re_vac = transitions.common_transitions(agent, time, 
+		if (transitions.common_transitions(agent, time, 
 								schools, workplaces, hospitals, 
-								retirement_homes, carpools, public_transit, contact_tracing);
-		if (re_vac == true) {
-			// Subtract from total since re-vaccinating (to not count twice)
-			--total_vaccinated;
+								retirement_homes, carpools, public_transit, contact_tracing)) {
+			++counts.re_vaccinated;
 		}
 
 		if (agent.infected() == false){
 			s_state_changes = transitions.susceptible_transitions(agent, time,
-							dt, infection, households, schools, workplaces, 
+							dt, local_infection, households, schools, workplaces, 
 							hospitals, retirement_homes, carpools, public_transit,
-						   	leisure_locations, infection_parameters, 
-							agents, flu, testing);
-			n_infected_tot += s_state_changes.at(0);
-			// True infected by timestep, from the first time step
-			if (s_state_changes.at(0) == 1){
-				++n_infected_day.back();
-			}
+						   	leisure_locations, parameters, 
+							agents, flu, testing, incidence, vac_effects);
+			counts.infected += s_state_changes.at(0);
 		}else if (agent.exposed() == true){
-			state_changes = transitions.exposed_transitions(agent, infection, time, dt, 
+			state_changes = transitions.exposed_transitions(agent, local_infection, time, dt, 
 										households, schools, workplaces, hospitals,
 										retirement_homes, carpools, public_transit,
-						   				infection_parameters, testing);
-			n_recovering_exposed += state_changes.at(0);
-			n_recovered_tot += state_changes.at(0);
+						   				parameters, testing);
+			counts.recovering_exposed += state_changes.at(0);
+			counts.recovered += state_changes.at(0);
 		}else if (agent.symptomatic() == true){
 			state_changes = transitions.symptomatic_transitions(agent, time, dt,
-						infection, households, schools, workplaces, hospitals,
+						local_infection, households, schools, workplaces, hospitals,
 							retirement_homes, carpools, public_transit,
-						   	infection_parameters);
-			n_recovered_tot += state_changes.at(0);
-			// Collect only after a specified time
-			if (time >= infection_parameters.at("time to start data collection")){
+						   	parameters);
+			counts.recovered += state_changes.at(0);
+			if (collect_data){
 				if (state_changes.at(1) == 1){
 					// Dead after testing
-					++n_dead_tested;
-					++n_dead_tot;
+					++counts.dead_tested;
 				} else if (state_changes.at(1) == 2){
 					// Dead with no testing
-					++n_dead_not_tested;
-					++n_dead_tot;
+					++counts.dead_not_tested;
 				}
 			}
 		}else{
@@ -1520,43 +1670,117 @@ void ABM::compute_state_transitions()
 		}
 
 		// Recording testing changes for this agent
-		if (time >= infection_parameters.at("time to start data collection")){
+		if (collect_data){
 			if (agent.exposed() || agent.symptomatic()){
 				if (state_changes.at(2) == 1){
-					++tested_day.back();
-					++tot_tested;
+					++counts.tested;
 				}
 				if (state_changes.at(3) == 1){
-					++tested_pos_day.back();
-					++tot_tested_pos;
+					++counts.tested_pos;
 					// Confirmed positive - initiate contact tracing
-					contact_trace_agent(agent);
+					updates.record(DeferredUpdates::Type::contact_tracing, agent.get_ID());
 				}
 				if (state_changes.at(4) == 1){
-					++tested_false_neg_day.back();
-					++tot_tested_false_neg;
+					++counts.tested_false_neg;
 				}
 			} else {
 				// Susceptible
 				if (s_state_changes.at(1) == 1){
-					++tested_day.back();
-					++tot_tested;
+					++counts.tested;
 				}
 				if (s_state_changes.at(2) == 1){
-					++tested_neg_day.back();
-					++tot_tested_neg;
+					++counts.tested_neg;
 				}
 				if (s_state_changes.at(3) == 1){
-					++tested_false_pos_day.back();
-					++tot_tested_false_pos;
+					++counts.tested_false_pos;
 					// False positive - initiate contact tracing
-					contact_trace_agent(agent);
+					updates.record(DeferredUpdates::Type::contact_tracing, agent.get_ID());
 				}
 			}
 		}
+
+		// Only this agent could change, counts and eligibility 
+		// for vaccination are updated once all finish
+		if (agent.get_state_flags() != flags_before) {
+			changed_IDs.push_back(agent.get_ID());
+		}
 	}
 }
 
+// Apply changes of shared objects recorded while processing agents in parallel
+void ABM::apply_deferred_updates(const std::vector<DeferredUpdates>& updates)
+{
+	// Memberships first so that new flu agents are chosen 
+	// only among agents still susceptible after this step
+	for (const auto& worker_updates : updates) {
+		for (const auto& upd : worker_updates.get_updates()) {
+			switch (upd.type) {
+				case DeferredUpdates::Type::place_add:
+					upd.place->add_agent(upd.ID);
+					break;
+				case DeferredUpdates::Type::place_remove:
+					upd.place->remove_agent(upd.ID);
+					break;
+				case DeferredUpdates::Type::place_contribution:
+					upd.place->add_contribution(upd.value, upd.ID);
+					break;
+				case DeferredUpdates::Type::hospital_tested:
+					static_cast<Hospital*>(upd.place)->increase_total_tested(upd.ID);
+					break;
+				case DeferredUpdates::Type::flu_susceptible_removal:
+					flu.remove_susceptible_agent(upd.ID);
+					break;
+				case DeferredUpdates::Type::house_isolation_reset:
+					contact_tracing.reset_house_isolation(upd.ID);
+					break;
+				default:
+					break;
+			}
+		}
+	}
+	// Changes that involve other agents
+	const int n_hospitals = hospitals.size();
+	for (const auto& worker_updates : updates) {
+		for (const auto& upd : worker_updates.get_updates()) {
+			if (upd.type == DeferredUpdates::Type::flu_swap) {
+				const int new_flu = flu.swap_flu_agent(upd.ID);
+				// If still available
+				if (new_flu != -1) {
+					transitions.process_new_flu(agents.at(new_flu-1), n_hospitals, time,
+					   		 schools, workplaces, retirement_homes,
+							 carpools, public_transit, infection, 
+							 parameters, flu, testing);
+					update_agent_records(agents.at(new_flu-1));
+				}
+			} else if (upd.type == DeferredUpdates::Type::contact_tracing) {
+				contact_trace_agent(agents.at(upd.ID-1));
+			}
+		}
+	}
+}
+
+// Split items among the threads and process them recording deferred updates
+std::vector<DeferredUpdates> ABM::process_in_parallel(const int n_items,
+		const std::function<void(const int, const int, const int, DeferredUpdates&)>& process)
+{
+	const int n_workers = number_of_workers(n_items);
+	const int n_per_worker = (n_items + n_workers - 1)/n_workers;
+	std::vector<DeferredUpdates> updates(n_workers);
+
+	// The calling thread processes the first block, threads of the pool the rest
+	workers.run(n_workers, [&](const int iw) {
+		updates.at(iw).start_recording();
+		try {
+			process(iw, iw*n_per_worker, std::min(n_items, (iw+1)*n_per_worker), updates.at(iw));
+		} catch (...) {
+			DeferredUpdates::stop_recording();
+			throw;
+		}
+		DeferredUpdates::stop_recording();
+	});
+	return updates;
+}
+
 // Initiate contact tracing of an agent
 void ABM::contact_trace_agent(Agent& agent)
 {
@@ -1576,7 +1800,7 @@ void ABM::contact_trace_agent(Agent& agent)
 	if (agent.student()) {
 		traced = contact_tracing.isolate_school(aID, agents, 
 					schools.at(agent.get_school_ID()-1), 
-					static_cast<int>(infection_parameters.at("max contacts at school")), 
+					static_cast<int>(parameters.max_contacts_at_school), 
 					infection);
 		all_traced.insert(traced.begin(), traced.end());
 	}
@@ -1584,20 +1808,20 @@ void ABM::contact_trace_agent(Agent& agent)
 		if (agent.retirement_home_employee()) {
 			traced = contact_tracing.isolate_retirement_home(aID, agents, 
 					retirement_homes.at(agent.get_work_ID()-1), 
-					static_cast<int>(infection_parameters.at("max contacts at RH")),
-					static_cast<int>(infection_parameters.at("max contacts residents at RH")),
+					static_cast<int>(parameters.max_contacts_at_RH),
+					static_cast<int>(parameters.max_contacts_residents_at_RH),
 					infection);
 			all_traced.insert(traced.begin(), traced.end());
 		} else if (agent.school_employee()) {
 			traced = contact_tracing.isolate_school(aID, agents, 
 					schools.at(agent.get_work_ID()-1), 
-					static_cast<int>(infection_parameters.at("max contacts at school")), 
+					static_cast<int>(parameters.max_contacts_at_school), 
 					infection);
 			all_traced.insert(traced.begin(), traced.end());
 		} else {
 			traced = contact_tracing.isolate_workplace(aID, agents, 
 				workplaces.at(agent.get_work_ID()-1), 
-				static_cast<int>(infection_parameters.at("max contacts at workplace")),
+				static_cast<int>(parameters.max_contacts_at_workplace),
 				infection);
 			all_traced.insert(traced.begin(), traced.end());
 		}
@@ -1605,11 +1829,11 @@ void ABM::contact_trace_agent(Agent& agent)
 	if (agent.hospital_employee()) {
 		traced = contact_tracing.isolate_hospital(aID, agents, 
 				hospitals.at(agent.get_hospital_ID()-1), 
-				static_cast<int>(infection_parameters.at("max contacts at hospital")),
+				static_cast<int>(parameters.max_contacts_at_hospital),
 				infection);
 		all_traced.insert(traced.begin(), traced.end());	
 	}
- 	if (agent.get_work_travel_mode() == "carpool") {
+ 	if (agent.get_travel_mode() == TravelMode::carpool) {
 		traced = contact_tracing.isolate_carpools(aID, agents, 
 				carpools.at(agent.get_carpool_ID()-1)); 
 		all_traced.insert(traced.begin(), traced.end());
@@ -1617,14 +1841,14 @@ void ABM::contact_trace_agent(Agent& agent)
 	if (agent.retirement_home_resident()) { 
 			traced = contact_tracing.isolate_retirement_home(aID, agents, 
 						retirement_homes.at(agent.get_household_ID()-1), 
-						static_cast<int>(infection_parameters.at("max contacts at RH")),
-						static_cast<int>(infection_parameters.at("max contacts residents at RH")),
+						static_cast<int>(parameters.max_contacts_at_RH),
+						static_cast<int>(parameters.max_contacts_residents_at_RH),
 						infection);
 		all_traced.insert(traced.begin(), traced.end());
 	} else {
 		// Private visits
 		traced = contact_tracing.isolate_visited_households(aID, households,
-					infection_parameters.at("contact tracing compliance"), infection,
+					parameters.contact_tracing_compliance, infection,
 					static_cast<int>(time), dt);
 		all_traced.insert(traced.begin(), traced.end());
 		// Agent's household
@@ -1642,7 +1866,8 @@ void ABM::setup_traced_isolation(const std::unordered_set<int>& traced_IDs)
 		if (!agents.at(aID-1).contact_traced()) {
 			transitions.new_quarantined(agents.at(aID-1), time, dt, 
     	            infection, households, schools, workplaces, hospitals, retirement_homes,
-    	            carpools, public_transit, infection_parameters);
+    	            carpools, public_transit, parameters);
+			update_agent_records(agents.at(aID-1));
 		}
 	}
 }
@@ -1682,7 +1907,8 @@ void ABM::start_testing_flu_and_vaccination(const bool dont_vac)
 			transitions.process_new_flu(agent, n_hospitals, time,
 					   		 schools, workplaces, retirement_homes,
 							 carpools, public_transit, infection, 
-							 infection_parameters, flu, testing);
+							 parameters, flu, testing);
+			update_agent_records(agent);
 		}
 	}
 }
@@ -1702,19 +1928,19 @@ double ABM::get_average_contacts()
 			if (agent.student()) {
 				if (time < infection_parameters.at("school closure")) { 
 					n_tot += std::min(schools.at(agent.get_school_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at school")));
+									static_cast<int>(parameters.max_contacts_at_school));
 				}
 			}
 
 			n_tot += std::min(hospitals.at(agent.get_hospital_ID()-1).get_number_of_agents(),
-								static_cast<int>(infection_parameters.at("max contacts at hospital")));
+								static_cast<int>(parameters.max_contacts_at_hospital));
 		} else if (agent.hospital_non_covid_patient()) {
 			n_tot += std::min(hospitals.at(agent.get_hospital_ID()-1).get_number_of_agents(),
-								static_cast<int>(infection_parameters.at("max contacts at hospital")));
+								static_cast<int>(parameters.max_contacts_at_hospital));
 		} else {
 			if (agent.retirement_home_resident()) {
 				n_tot += std::min(retirement_homes.at(agent.get_household_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at RH")));
+									static_cast<int>(parameters.max_contacts_at_RH));
 			} else {
 				n_tot += households.at(agent.get_household_ID()-1).get_number_of_agents();
 			}
@@ -1722,39 +1948,39 @@ double ABM::get_average_contacts()
 			if (agent.student()) {
 				if (time < infection_parameters.at("school closure")) {
 					n_tot += std::min(schools.at(agent.get_school_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at school")));
+									static_cast<int>(parameters.max_contacts_at_school));
 				}
 			}
 
 			if (agent.works()) {
 				if (agent.retirement_home_employee()) {
 					n_tot +=  std::min(retirement_homes.at(agent.get_work_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at RH")));
+									static_cast<int>(parameters.max_contacts_at_RH));
 				} else if (agent.school_employee()) {
 					if (time < infection_parameters.at("school closure")) {
 						n_tot += std::min(schools.at(agent.get_work_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at school")));
+									static_cast<int>(parameters.max_contacts_at_school));
 					}
 				} else {
 					if (!agent.works_from_home()) {
 						n_tot +=  std::min(workplaces.at(agent.get_work_ID()-1).get_number_of_agents(),
-							static_cast<int>(infection_parameters.at("max contacts at workplace")));
+							static_cast<int>(parameters.max_contacts_at_workplace));
 					}
 				}
 			}
 		}
 
 		// Transit
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			n_tot +=  carpools.at(agent.get_carpool_ID()-1).get_number_of_agents();
-		} else if (agent.get_work_travel_mode() == "public") {
+		} else if (agent.get_travel_mode() == TravelMode::public_transit) {
 			n_tot +=  public_transit.at(agent.get_public_transit_ID()-1).get_number_of_agents();
 		}
 
 		// Leisure locations
 		les_loc = agent.get_leisure_ID();	
 		if (les_loc > 0) {
-			if (agent.get_leisure_type() == "public") {
+			if (agent.get_leisure_location_type() == LeisureType::public_location) {
 				n_tot += leisure_locations.at(les_loc - 1).get_number_of_agents();
 			} else {
 				n_tot += households.at(les_loc - 1).get_number_of_agents();
@@ -14,12 +14,12 @@
 // Print Agent information 
 void Agent::print_basic(std::ostream& where) const
 {
-	where << ID << " " << is_student << " " << is_working  
+	where << ID << " " << student() << " " << works()  
 		  << " " << age << " " << x << " " << y << " "
-		  << house_ID << " " << is_non_covid_patient << " " << school_ID 
-		  << " " << work_ID << " " << works_at_hospital 
-		  << " " << hospital_ID << " " << worksRH 
-		  << " " << worksSch << " " << livesRH << " "<< is_infected;	
+		  << house_ID << " " << hospital_non_covid_patient() << " " << school_ID 
+		  << " " << work_ID << " " << hospital_employee() 
+		  << " " << hospital_ID << " " << retirement_home_employee() 
+		  << " " << school_employee() << " " << retirement_home_resident() << " "<< infected();	
 }
 
 //
@@ -29,9 +29,12 @@ void Contact_tracing::add_household(const int aID, const int hID, const int time
 std::vector<int> Contact_tracing::isolate_household(const int aID, const Household& household)
 {
 	std::vector<int> traced;
-	for (const auto& ag : household.get_agent_IDs()) {
-		if (ag != aID) {
-			traced.push_back(ag);
+	// Residents, then guests at this step
+	for (const auto* IDs : {&household.get_agent_IDs(), &household.get_visitor_IDs()}) {
+		for (const auto& ag : *IDs) {
+			if (ag != aID) {
+				traced.push_back(ag);
+			}
 		}
 	}
 	is_isolated.at(household.get_ID()-1) = true;
@@ -59,10 +62,13 @@ std::vector<int> Contact_tracing::isolate_visited_households(const int aID,
 		}
  		// Check if guest household will isolate (if not already isolated)
 		if (!is_isolated.at(hsID-1) && infection.get_uniform() <= compliance) {
-			for (const auto& ag : households.at(hsID-1).get_agent_IDs()) {
-				if (ag != aID) {
-					// In case a guest at this step
-					traced.push_back(ag);
+			const Household& house = households.at(hsID-1);
+			for (const auto* IDs : {&house.get_agent_IDs(), &house.get_visitor_IDs()}) {
+				for (const auto& ag : *IDs) {
+					if (ag != aID) {
+						// In case a guest at this step
+						traced.push_back(ag);
+					}
 				}
 			}
 			is_isolated.at(hsID-1) = true;		
@@ -79,6 +85,7 @@ std::vector<int> Contact_tracing::isolate_workplace(const int aID, const std::ve
 						Infection& infection)
 {
 	std::vector<int> traced;
+	// Copy, shuffled
 	std::vector<int> coworkers = workplace.get_agent_IDs();
 	if (!coworkers.empty()) {
 		infection.vector_shuffle(coworkers);
@@ -100,6 +107,7 @@ std::vector<int> Contact_tracing::isolate_hospital(const int aID, const std::vec
 							Infection& infection)
 {
 	std::vector<int> traced;
+	// Copy, shuffled
 	std::vector<int> everyone = hospital.get_agent_IDs();
 	if (!everyone.empty()) {
 		infection.vector_shuffle(everyone);
@@ -126,6 +134,7 @@ std::vector<int> Contact_tracing::isolate_retirement_home(const int aID, const s
 							const double num_res, Infection& infection)
 {
 	std::vector<int> traced;
+	// Copy, shuffled
 	std::vector<int> everyone = retirement_home.get_agent_IDs();
 	if (!everyone.empty()) {
 		infection.vector_shuffle(everyone);
@@ -161,7 +170,7 @@ std::vector<int> Contact_tracing::isolate_school(const int aID, std::vector<Agen
 	const Agent& agent = agents.at(aID-1);
 	bool is_student = (agent.student() && (agent.get_school_ID() == school.get_ID()));
 	// Students and staff
- 	std::vector<int> everyone = school.get_agent_IDs();
+ 	const std::vector<int>& everyone = school.get_agent_IDs();
 	if (everyone.size() <= 1) {
 		return traced;
 	}
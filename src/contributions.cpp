@@ -62,22 +62,22 @@ void Contributions::compute_exposed_contributions(const Agent& agent, const doub
 					school.add_exposed(inf_var);	
 				}
 				// Transit
-				if (agent.get_work_travel_mode() == "carpool") {
+				if (agent.get_travel_mode() == TravelMode::carpool) {
 					Transit& carpool = carpools.at(agent.get_carpool_ID()-1);
 					carpool.add_exposed(inf_var);
 				}
-				if (agent.get_work_travel_mode() == "public") {
+				if (agent.get_travel_mode() == TravelMode::public_transit) {
 					Transit& bus = public_transit.at(agent.get_public_transit_ID()-1);
 					bus.add_exposed(inf_var);
 				}
 				// Leisure
 				if (agent.get_leisure_ID() > 0) {
-					if (agent.get_leisure_type() == "public") {
+					if (agent.get_leisure_location_type() == LeisureType::public_location) {
 						Leisure& les_loc = leisure_locations.at(agent.get_leisure_ID()-1); 
 						if (!les_loc.outside_town()){
 							les_loc.add_exposed(inf_var);
 						}
-					} else if (agent.get_leisure_type() == "household") {
+					} else if (agent.get_leisure_location_type() == LeisureType::household) {
 						Household& household = households.at(agent.get_leisure_ID()-1);
 						household.add_exposed(inf_var);
 					} else {
@@ -135,22 +135,22 @@ void Contributions::compute_exposed_contributions(const Agent& agent, const doub
 			hospital.add_exposed(inf_var);
 		}
 		// Transit
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			Transit& carpool = carpools.at(agent.get_carpool_ID()-1);
 			carpool.add_exposed(inf_var);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			Transit& bus = public_transit.at(agent.get_public_transit_ID()-1);
 			bus.add_exposed(inf_var);
 		}
 		// Leisure
 		if (agent.get_leisure_ID() > 0) {
-			if (agent.get_leisure_type() == "public") {
+			if (agent.get_leisure_location_type() == LeisureType::public_location) {
 				Leisure& les_loc = leisure_locations.at(agent.get_leisure_ID()-1); 
 				if (!les_loc.outside_town()){
 					les_loc.add_exposed(inf_var);
 				}
-			} else if (agent.get_leisure_type() == "household") {
+			} else if (agent.get_leisure_location_type() == LeisureType::household) {
 				Household& household = households.at(agent.get_leisure_ID()-1);
 				household.add_exposed(inf_var);
 			} else {
@@ -278,7 +278,7 @@ void Contributions::compute_regular_symptomatic_contributions(const Agent& agent
 		}
 	}
 	// Transit
-	if (agent.get_work_travel_mode() == "carpool") {
+	if (agent.get_travel_mode() == TravelMode::carpool) {
 		Transit& carpool = carpools.at(agent.get_carpool_ID()-1);
 		if (agent.retirement_home_employee() || agent.school_employee()) {
 			carpool.add_special_symptomatic(inf_var, psi_s);
@@ -286,7 +286,7 @@ void Contributions::compute_regular_symptomatic_contributions(const Agent& agent
 			carpool.add_symptomatic(inf_var);
 		}
 	}
-	if (agent.get_work_travel_mode() == "public") {
+	if (agent.get_travel_mode() == TravelMode::public_transit) {
 		Transit& bus = public_transit.at(agent.get_public_transit_ID()-1);
 		if (agent.retirement_home_employee() || agent.school_employee()) {
 			bus.add_special_symptomatic(inf_var, psi_s);
@@ -296,12 +296,12 @@ void Contributions::compute_regular_symptomatic_contributions(const Agent& agent
 	}
 	// Leisure
 	if (agent.get_leisure_ID() > 0) {
-		if (agent.get_leisure_type() == "public") {
+		if (agent.get_leisure_location_type() == LeisureType::public_location) {
 			Leisure& les_loc = leisure_locations.at(agent.get_leisure_ID()-1);
 			if (!les_loc.outside_town()){
 				les_loc.add_symptomatic(inf_var);
 			}
-		} else if (agent.get_leisure_type() == "household") {
+		} else if (agent.get_leisure_location_type() == LeisureType::household) {
 			Household& household = households.at(agent.get_leisure_ID()-1);
 			household.add_symptomatic(inf_var);
 		} else {
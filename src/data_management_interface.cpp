@@ -24,54 +24,26 @@
 // Retrieve number of infected agents at this time step
 int DataManagementInterface::get_num_infected() const
 {
-	int infected_count = 0;
-	for (const auto& agent : agents){
-		if (agent.infected())
-			++infected_count;
-	}
-	return infected_count;
+	return current_population_states().get_num_infected();
 }
 
 // Retrieve number of exposed agents at this time step
 int DataManagementInterface::get_num_exposed() const
 {
-	int exposed_count = 0;
-	for (const auto& agent : agents){
-		if (agent.exposed())
-			++exposed_count;
-	}
-	return exposed_count;
+	return current_population_states().get_num_exposed();
 }
 
 // Number of infected - confirmed
 int DataManagementInterface::get_num_active_cases() const
 {
-	int active_count = 0;
-	for (const auto& agent : agents){
-		if ((agent.infected() && agent.tested_covid_positive())
-			 || (agent.symptomatic_non_covid() && agent.home_isolated()
-					 && agent.tested_false_positive())){
-			++active_count;
-		}
-	}
-	return active_count;
+	return current_population_states().get_num_active_cases();
 }
 
 // Number of agents currently undergoing each treatment 
 std::vector<int> DataManagementInterface::get_treatment_data() const
 {
 	// IH, HN, ICU
-	std::vector<int> treatments(3,0);
-	for (const auto& agent : agents){
-		if (agent.home_isolated()){
-			++treatments.at(0);
-		}else if (agent.hospitalized()){
-			++treatments.at(1);
-		}else if (agent.hospitalized_ICU()){
-			++treatments.at(2);
-		}
-	}
-	return treatments;
+	return current_population_states().get_treatment_data();
 }
 
 //
@@ -0,0 +1,79 @@
+#include "../include/ensemble.h"
+
+/*****************************************************
+ * class: Ensemble
+ *
+ * Runs multiple independent replicates of the same
+ * simulation setup within a single process
+ *
+ ******************************************************/
+
+// Run the replicates
+std::vector<ReplicateResults> Ensemble::run(const int n_replicates, const int n_threads)
+{
+	if (n_replicates < 0) {
+		throw std::invalid_argument("Number of replicates needs to be non-negative, requested: "
+										+ std::to_string(n_replicates));
+	}
+	if (n_threads < 1) {
+		throw std::invalid_argument("Number of threads needs to be at least 1, requested: "
+										+ std::to_string(n_threads));
+	}
+
+	std::vector<ReplicateResults> results(n_replicates);
+	// Next replicate to process
+	std::atomic<int> next_rep(0);
+	// First exception thrown in any of the workers
+	std::exception_ptr error = nullptr;
+	std::mutex error_mutex;
+
+	auto worker = [&]() {
+		int irep = 0;
+		while ((irep = next_rep++) < n_replicates) {
+			try {
+				run_replicate(results.at(irep), irep);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(error_mutex);
+				if (!error) {
+					error = std::current_exception();
+				}
+				// Stop handing out new replicates
+				next_rep = n_replicates;
+			}
+		}
+	};
+
+	const int n_workers = std::min(n_threads, std::max(n_replicates, 1));
+	std::vector<std::thread> workers;
+	for (int i = 0; i < n_workers; ++i) {
+		workers.emplace_back(worker);
+	}
+	for (auto& thr : workers) {
+		thr.join();
+	}
+
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	return results;
+}
+
+// Setup and run a single replicate
+void Ensemble::run_replicate(ReplicateResults& res, const int irep) const
+{
+	ABM abm = seeded ? ABM(dt, base_seed + irep) : ABM(dt);
+	abm.simulation_setup_from_town(town, inf0, vac_offsets);
+	abm.initialize_vac_and_reopening(dont_vac);
+	abm.initialize_active_cases(N_active, vaccinate, N_vac);
+
+	res.active_count.assign(tmax+1, 0);
+	res.infected_count.assign(tmax+1, 0);
+	res.total_dead.assign(tmax+1, 0);
+
+	for (int ti = 0; ti<=tmax; ++ti) {
+		res.active_count.at(ti) = abm.get_num_infected();
+		res.infected_count.at(ti) = abm.get_total_infected();
+		res.total_dead.at(ti) = abm.get_total_dead();
+		abm.transmit_with_vac();
+	}
+}
@@ -11,24 +11,21 @@
 // Remove a susceptible agent 
 void Flu::remove_susceptible_agent(const int index)
 {
-	std::vector<int> new_agent_IDs = {};
-	std::remove_copy(susceptible_agent_IDs.begin(), susceptible_agent_IDs.end(),
-					std::back_insert_iterator<std::vector<int>>(new_agent_IDs), index);
-	std::swap(new_agent_IDs, susceptible_agent_IDs);	
-}
-
-// Remove a flu agent 
-void Flu::remove_flu_agent(const int index)
-{
-	std::vector<int> new_agent_IDs = {};
-	std::remove_copy(flu_agent_IDs.begin(), flu_agent_IDs.end(),
-					std::back_insert_iterator<std::vector<int>>(new_agent_IDs), index);
-	std::swap(new_agent_IDs, flu_agent_IDs);	
+	if (DeferredUpdates* rec = DeferredUpdates::recorder()) {
+		rec->record(DeferredUpdates::Type::flu_susceptible_removal, index);
+		return;
+	}
+	susceptible_agent_IDs.remove(index);
 }
 
 // Remove recovered from flu, add new chosen randomly
 int Flu::swap_flu_agent(const int index)
 {
+	// Deferred - the new flu agent is chosen and processed later
+	if (DeferredUpdates* rec = DeferredUpdates::recorder()) {
+		rec->record(DeferredUpdates::Type::flu_swap, index);
+		return -1;
+	}
 	remove_flu_agent(index);
 	int n_susceptible = susceptible_agent_IDs.size();
 	if (n_susceptible == 0){
@@ -40,7 +37,7 @@ int Flu::swap_flu_agent(const int index)
 	int ind = rng.get_random_int(0, n_susceptible - 1);
 	int agent_ind = susceptible_agent_IDs.at(ind);
 	remove_susceptible_agent(agent_ind);
-	flu_agent_IDs.push_back(agent_ind);
+	flu_agent_IDs.insert(agent_ind);
 	// Actual agent ID
 	return agent_ind;
 }
@@ -53,9 +50,9 @@ std::vector<int> Flu::generate_flu()
 		int ind = rng.get_random_int(0, susceptible_agent_IDs.size() - 1);
 		int agent_ind = susceptible_agent_IDs.at(ind);
 		remove_susceptible_agent(agent_ind);
-		flu_agent_IDs.push_back(agent_ind);
+		flu_agent_IDs.insert(agent_ind);
 	}
-	return flu_agent_IDs;
+	return flu_agent_IDs.get_IDs();
 }
 
 
@@ -39,3 +39,31 @@ double FourPartFunction::y_value(const double t) const
 		return y2;
 	}
 }
+
+// Copy of the function with all ts moved by an offset
+FourPartFunction FourPartFunction::shifted(const double offset) const
+{
+	// Constant functions have all ts at 0
+	if (t0 == t1) {
+		return *this;
+	}
+	return FourPartFunction({{t0, y0}, {t1, y1}, {t2, y2}, {t3, y3}, {t4, y4}}, offset);
+}
+
+// Values at one time of copies of the function started at different times
+void FourPartFunction::evaluate(const std::vector<double>& starts, const double time, 
+									std::vector<double>& values) const
+{
+	const int n = starts.size();
+	values.resize(n);
+	const double* st = starts.data();
+	double* val = values.data();
+	for (int i = 0; i < n; ++i) {
+		const double t = time - st[i];
+		// All the regions, then select, same operations as y_value()
+		const double inc_1 = s_inc_1*t + i_inc_1;
+		const double inc_2 = s_inc_2*t + i_inc_2;
+		const double dec = std::max(0.0, (s_dec*t + i_dec));
+		val[i] = (t < t1) ? inc_1 : ((t < t2) ? inc_2 : ((t > t3) ? dec : y2));
+	}
+}
@@ -1,4 +1,14 @@
 #include "../include/mobility.h"
+#include <numeric>
+#include <thread>
+#include <exception>
+#include <cstring>
+#include <sstream>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 /***************************************************** 
  * class: Mobility 
@@ -21,24 +31,308 @@ void Mobility::construct_public_probabilities(const std::vector<Household>& hous
 		kappa = 400.0;
 		beta = 1.75;
 	}
-	// Compute the ditances and probabilities for all locations
-	double dij = 0.0, pij = 0.0;
-	for (const auto& house : households) {
-		std::vector<double> probs = {};
-		for (const auto& leisure : leisure_locations) {
-			dij = compute_distance(house, leisure);
-			pij = compute_probability(dij);
-			probs.push_back(pij);	
+	n_leisure = leisure_locations.size();
+
+	if (cache_dir.empty()) {
+		public_probabilities = compute_table(households, leisure_locations);
+		return;
+	}
+	// Reuse the table of the same town and parameters if already saved
+	const std::uint64_t key = compute_cache_key(households, leisure_locations);
+	const std::string fname = cache_file_name(key);
+	std::shared_ptr<const LeisureTable> table = load_table(fname, key, households.size());
+	if (table == nullptr) {
+		table = compute_table(households, leisure_locations);
+		save_table(fname, key, *table);
+	}
+	public_probabilities = table;
+}
+
+// Compute the table of all households
+std::shared_ptr<const Mobility::LeisureTable> Mobility::compute_table(const std::vector<Household>& households,
+									const std::vector<Leisure>& leisure_locations) const
+{
+	// Coordinates in radians, computed once for all the households
+	LeisureCoordinates coordinates;
+	for (const auto& leisure : leisure_locations) {
+		const double lat = leisure.get_x()*pi/180.0;
+		coordinates.lat.push_back(lat);
+		coordinates.lon.push_back(leisure.get_y()*pi/180.0);
+		coordinates.cos_lat.push_back(std::cos(lat));
+	}
+
+	// Every household stores the same number of locations
+	const int n_houses = households.size();
+	const bool truncate = (max_locations > 0) && (max_locations < n_leisure);
+	std::shared_ptr<LeisureTable> table = std::make_shared<LeisureTable>();
+	table->n_houses = n_houses;
+	table->n_stored = truncate ? max_locations : n_leisure;
+	const std::size_t n_stored = table->n_stored;
+	table->cdf_data.assign(n_houses*n_stored, 0.0);
+	if (truncate) {
+		table->ID_data.assign(n_houses*n_stored, 0);
+	}
+
+	// Households are independent - split among the threads
+	const int n_workers = std::max(1, std::min(n_threads, n_houses));
+	const int n_per_worker = (n_houses + n_workers - 1)/n_workers;
+	std::vector<std::exception_ptr> errors(n_workers, nullptr);
+
+	auto worker = [&](const int iw) {
+		try {
+			std::vector<double> probs(n_leisure, 0.0);
+			std::vector<int> order(n_leisure, 0);
+			for (int ih = iw*n_per_worker; ih < std::min(n_houses, (iw+1)*n_per_worker); ++ih) {
+				compute_probabilities(households.at(ih), coordinates, probs);
+				create_distribution(probs, order, table->cdf_data.data() + ih*n_stored,
+							truncate ? table->ID_data.data() + ih*n_stored : nullptr);
+			}
+		} catch (...) {
+			errors.at(iw) = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int iw = 1; iw < n_workers; ++iw) {
+		threads.emplace_back(worker, iw);
+	}
+	worker(0);
+	for (auto& thr : threads) {
+		thr.join();
+	}
+	for (const auto& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
 		}
+	}
+
+	table->cdf = table->cdf_data.data();
+	table->IDs = truncate ? table->ID_data.data() : nullptr;
+	return table;
+}
+
+// Visiting probabilities of all the locations from a single household
+void Mobility::compute_probabilities(const Place& house, const LeisureCoordinates& coordinates, 
+										std::vector<double>& probs) const
+{
+	// Same as compute_distance with the leisure 
+	// location terms computed in advance
+	const double radius = 6371.0; 
+	const double lat1 = house.get_x()*pi/180.0;
+	const double lon1 = house.get_y()*pi/180.0;
+	const double cos_lat1 = std::cos(lat1);
+	const double* lat2 = coordinates.lat.data();
+	const double* lon2 = coordinates.lon.data();
+	const double* cos_lat2 = coordinates.cos_lat.data();
+	double* pij = probs.data();
+
+	for (int j=0; j<n_leisure; ++j) {
+		const double sin_lat = std::sin((lat2[j] - lat1)/2.0);
+		const double sin_lon = std::sin((lon2[j] - lon1)/2.0);
+		const double a = sin_lat*sin_lat + cos_lat1*cos_lat2[j]*sin_lon*sin_lon;
+		const double c = 2.0*std::atan2(std::sqrt(a), std::sqrt(1-a));
+		const double dij = radius*c;
+		pij[j] = compute_probability(dij);
+	}
+}
+
+// Visiting distribution of a household from probabilities of all the locations
+void Mobility::create_distribution(const std::vector<double>& probs, std::vector<int>& order,
+									double* cdf, std::int32_t* IDs) const
+{
+	if (IDs != nullptr) {
+		// Most probable locations, stored in order of their IDs
+		std::iota(order.begin(), order.end(), 0);
+		std::nth_element(order.begin(), order.begin() + max_locations, order.end(),
+					[&probs](const int i, const int j) { return probs.at(i) > probs.at(j); });
+		std::sort(order.begin(), order.begin() + max_locations);
+		const double total = std::accumulate(probs.begin(), probs.end(), 0.0);
+		double cumulative = 0.0;
+		for (int i=0; i<max_locations; ++i) {
+			cumulative += probs.at(order.at(i));
+			IDs[i] = order.at(i) + 1;
+			cdf[i] = total > 0.0 ? cumulative/total : 0.0;
+		}
+	} else {
 		// Cumulative sum for the CDF
-		std::partial_sum(probs.begin(), probs.end(), probs.begin());
+		std::partial_sum(probs.begin(), probs.end(), cdf);
 		// Normalize
-		double max_p = probs.back();
+		double max_p = cdf[n_leisure-1];
 		if (max_p > 0.0){
-			std::for_each(probs.begin(), probs.end(), [&max_p](double &x) { x /= max_p; });
+			std::for_each(cdf, cdf + n_leisure, [&max_p](double &x) { x /= max_p; });
 		}
-		public_probabilities.push_back(probs);
-	}	
+	}
+}
+
+// Cache key - FNV-1a hash of everything the table depends on
+std::uint64_t Mobility::compute_cache_key(const std::vector<Household>& households,
+								const std::vector<Leisure>& leisure_locations) const
+{
+	std::uint64_t key = 14695981039346656037ULL;
+	auto hash = [&key](const void* data, const std::size_t n_bytes) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (std::size_t i = 0; i < n_bytes; ++i) {
+			key = (key ^ bytes[i])*1099511628211ULL;
+		}
+	};
+	auto hash_value = [&hash](const double x) { hash(&x, sizeof(x)); };
+
+	const int n_locations = leisure_locations.size();
+	const int n_stored = ((max_locations > 0) && (max_locations < n_locations)) ? max_locations : n_locations;
+	for (const double x : {static_cast<double>(households.size()), static_cast<double>(n_locations), 
+							static_cast<double>(n_stored), dr0, beta, kappa}) {
+		hash_value(x);
+	}
+	for (const auto& house : households) {
+		hash_value(house.get_x());
+		hash_value(house.get_y());
+	}
+	for (const auto& leisure : leisure_locations) {
+		hash_value(leisure.get_x());
+		hash_value(leisure.get_y());
+	}
+	return key;
+}
+
+// Path of the cache file for a key
+std::string Mobility::cache_file_name(const std::uint64_t key) const
+{
+	if (cache_dir.empty()) {
+		return "";
+	}
+	std::ostringstream fname;
+	fname << cache_dir << (cache_dir.back() == '/' ? "" : "/") 
+		  << "mobility_" << std::hex << key << ".bin";
+	return fname.str();
+}
+
+// Path of the cache file for these locations and the current settings
+std::string Mobility::get_cache_file_name(const std::vector<Household>& households,
+				   					const std::vector<Leisure>& leisure_locations) const
+{
+	return cache_file_name(compute_cache_key(households, leisure_locations));
+}
+
+// Map the table from a cache file
+std::shared_ptr<const Mobility::LeisureTable> Mobility::load_table(const std::string& fname, 
+										const std::uint64_t key, const int n_houses) const
+{
+	const int fd = open(fname.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return nullptr;
+	}
+	struct stat info;
+	if ((fstat(fd, &info) != 0) || (info.st_size < static_cast<off_t>(sizeof(CacheHeader)))) {
+		close(fd);
+		return nullptr;
+	}
+	const std::size_t file_size = info.st_size;
+	void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+	// The mapping stays valid after the file is closed
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		return nullptr;
+	}
+
+	std::shared_ptr<LeisureTable> table = std::make_shared<LeisureTable>();
+	table->mapping = mapping;
+	table->mapping_size = file_size;
+
+	// Discard files of other inputs and incomplete files
+	CacheHeader header;
+	std::memcpy(&header, mapping, sizeof(header));
+	const bool truncated = header.n_stored < n_leisure;
+	const std::size_t n_entries = n_houses*header.n_stored;
+	const std::size_t expected_size = sizeof(CacheHeader) + n_entries*sizeof(double) 
+									+ (truncated ? n_entries*sizeof(std::int32_t) : 0);
+	if ((std::memcmp(header.magic, cache_magic.data(), sizeof(header.magic)) != 0) 
+			|| (header.key != key) || (header.n_houses != n_houses) 
+			|| (header.n_leisure != n_leisure) || (file_size != expected_size)) {
+		return nullptr;
+	}
+
+	const char* data = static_cast<const char*>(mapping);
+	table->n_houses = n_houses;
+	table->n_stored = header.n_stored;
+	table->cdf = reinterpret_cast<const double*>(data + sizeof(CacheHeader));
+	if (truncated) {
+		table->IDs = reinterpret_cast<const std::int32_t*>(data + sizeof(CacheHeader) + n_entries*sizeof(double));
+	}
+	return table;
+}
+
+// Unmap the table if loaded from a cache file
+Mobility::LeisureTable::~LeisureTable()
+{
+	if (mapping != nullptr) {
+		munmap(mapping, mapping_size);
+	}
+}
+
+// Save the table to a cache file, warn and skip if not possible
+void Mobility::save_table(const std::string& fname, const std::uint64_t key, const LeisureTable& table) const
+{
+	CacheHeader header;
+	std::memcpy(header.magic, cache_magic.data(), sizeof(header.magic));
+	header.key = key;
+	header.n_houses = table.n_houses;
+	header.n_leisure = n_leisure;
+	header.n_stored = table.n_stored;
+	const std::size_t n_entries = static_cast<std::size_t>(table.n_houses)*table.n_stored;
+
+	// Written under a temporary name and renamed so that 
+	// simultaneous runs never map an incomplete file
+	const std::string tmp_name = fname + ".tmp" + std::to_string(getpid());
+	std::ofstream out(tmp_name, std::ios::binary);
+	if (!out) {
+		std::cout << "Mobility: unable to write the cache file " << tmp_name 
+				  << ", continuing without caching" << std::endl;
+		return;
+	}
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(table.cdf), n_entries*sizeof(double));
+	if (table.IDs != nullptr) {
+		out.write(reinterpret_cast<const char*>(table.IDs), n_entries*sizeof(std::int32_t));
+	}
+	out.close();
+	if (!out || (std::rename(tmp_name.c_str(), fname.c_str()) != 0)) {
+		std::remove(tmp_name.c_str());
+		std::cout << "Mobility: unable to write the cache file " << fname 
+				  << ", continuing without caching" << std::endl;
+	}
+}
+
+// Number of threads used for computing the probabilities
+void Mobility::set_number_of_threads(const int n)
+{
+	if (n < 1) {
+		throw std::invalid_argument("Number of threads needs to be at least 1, requested: "
+										+ std::to_string(n));
+	}
+	n_threads = n;
+}
+
+// Set the probability parameters and the optional limit of stored locations
+void Mobility::set_parameters(const std::map<std::string, double>& infection_parameters)
+{
+	set_probability_parameters(infection_parameters.at("leisure - dr0"), 
+			infection_parameters.at("leisure - beta"), infection_parameters.at("leisure - kappa"));
+	// Opt-in, all the locations are stored without a limit -
+	// a limit changes the visiting distribution, see the header
+	const auto& n_max = infection_parameters.find("leisure - max locations");
+	if (n_max != infection_parameters.end()) {
+		set_max_locations(static_cast<int>(n_max->second));
+	}
+}
+
+// Limit the number of locations stored for each household
+void Mobility::set_max_locations(const int n_max)
+{
+	if (n_max < 0) {
+		throw std::invalid_argument("Maximum number of leisure locations per household "
+							"needs to be non-negative, requested: " + std::to_string(n_max));
+	}
+	max_locations = n_max;
 }
 
 // Computes distances between two locations based
@@ -67,7 +361,7 @@ double Mobility::compute_distance(const Place& loc1, const Place& loc2)
 }
 
 // Computes and returns probabilities based on distance
-double Mobility::compute_probability(const double dist)
+double Mobility::compute_probability(const double dist) const
 {
 	const double pdij = std::pow((dist + dr0), -beta)*std::exp(-dist/kappa); 
 	return pdij;
@@ -79,36 +373,95 @@ int Mobility::assign_leisure_location(Infection& infection, const int& house_ID,
 {
 	in_household = false;
 	in_public = false;
-	int pub_ID = 0, guest_ID = 0;
+	int guest_ID = 0;
 
 	// Determine if the location will be private of public
 	if (household_prob <= infection.get_uniform()) {	
 		// If a household, randomly select the ID that is not one of current agents
 		guest_ID = house_ID;
 		while (guest_ID == house_ID) {
-			guest_ID = infection.get_random_household_ID(public_probabilities.size());
+			guest_ID = infection.get_random_household_ID(public_probabilities->n_houses);
 		}	
 		in_household = true;
 		return guest_ID;
 	} else {
 		// If a public location - assign based on the probabilities
-		int pub_ID = 0;
 		in_public = true;
 		const double prob = infection.get_uniform();
-		const std::vector<double>& a_house = public_probabilities.at(house_ID-1);
-			
-		// Iterator to the first element with probability >= to prob, 
-		// or one past last if no such element
-		const auto& iter = std::find_if(a_house.cbegin(), a_house.cend(), 
-						[&prob](const double x) { return x >= prob; });
-		// Find and return the ID
-		pub_ID = std::distance(a_house.cbegin(), iter) + 1;
-		in_public = true;
-		return pub_ID;
+		return sample_location(house_ID, prob);
 	}
 	return 0;
 }
 
+// Throws if there is no household with this ID in the table
+void Mobility::check_household_ID(const int house_ID) const
+{
+	if ((house_ID < 1) || (house_ID > public_probabilities->n_houses)) {
+		throw std::out_of_range("Mobility: no visiting probabilities for household " 
+									+ std::to_string(house_ID));
+	}
+}
+
+// ID of the location selected by a uniform random number
+int Mobility::sample_location(const int house_ID, const double prob) const
+{
+	check_household_ID(house_ID);
+	const LeisureTable& table = *public_probabilities;
+	const double* cdf = table.cdf + static_cast<std::size_t>(house_ID-1)*table.n_stored;
+	const double* cdf_end = cdf + table.n_stored;
+
+	// First stored location with cumulative probability >= prob
+	const double* iter = std::lower_bound(cdf, cdf_end, prob);
+	const int ind = iter - cdf;
+	if (table.IDs == nullptr) {
+		return ind + 1;
+	}
+	const std::int32_t* IDs = table.IDs + static_cast<std::size_t>(house_ID-1)*table.n_stored;
+	if (iter != cdf_end) {
+		return IDs[ind];
+	}
+	// In the tail - position among the locations that are not stored
+	const double stored = cdf_end[-1];
+	const int n_tail = n_leisure - table.n_stored;
+	const int k = std::min(static_cast<int>((prob - stored)/(1.0 - stored)*n_tail), n_tail - 1);
+	// Skip the stored IDs below the k-th one that is not stored
+	int lo = 0, hi = table.n_stored;
+	while (lo < hi) {
+		const int mid = (lo + hi)/2;
+		if (IDs[mid] - mid - 1 <= k) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return k + 1 + lo;
+}
+
+// Cumulative visiting probabilities of all the locations
+std::vector<std::vector<double>> Mobility::get_public_probabilities() const
+{
+	const LeisureTable& table = *public_probabilities;
+	std::vector<std::vector<double>> all_probs;
+	for (int ih=0; ih<table.n_houses; ++ih) {
+		const double* cdf = table.cdf + static_cast<std::size_t>(ih)*table.n_stored;
+		if (table.IDs == nullptr) {
+			all_probs.emplace_back(cdf, cdf + table.n_stored);
+			continue;
+		}
+		// Tail is uniform
+		const std::int32_t* IDs = table.IDs + static_cast<std::size_t>(ih)*table.n_stored;
+		std::vector<double> probs(n_leisure, (1.0 - cdf[table.n_stored-1])/(n_leisure - table.n_stored));
+		double previous = 0.0;
+		for (int i=0; i<table.n_stored; ++i) {
+			probs.at(IDs[i]-1) = cdf[i] - previous;
+			previous = cdf[i];
+		}
+		std::partial_sum(probs.begin(), probs.end(), probs.begin());
+		all_probs.push_back(probs);
+	}
+	return all_probs;
+}
+
 // Save the matrix of probabilities to file	
 void Mobility::print_probabilities(const std::string fname)
 {
@@ -119,5 +472,5 @@ void Mobility::print_probabilities(const std::string fname)
 
 	// Write data to file
 	AbmIO abm_io(fname, delim, sflag, dims);
-	abm_io.write_vector<double>(public_probabilities);
+	abm_io.write_vector<double>(get_public_probabilities());
 }
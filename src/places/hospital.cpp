@@ -31,7 +31,7 @@ void Hospital::compute_infected_contribution()
 void Hospital::print_basic(std::ostream& where) const
 {
 	where << ID << " " << x << " " << y << " "
-		  << num_tot << " " << num_infected << " "
+		  << agent_IDs.size() + n_tested << " " << num_infected << " "
 		  << ck << " " << beta_employee << " "
 		  << beta_non_covid_patient << " " 
 		  << beta_testee << " " << beta_hospitalized 
@@ -21,7 +21,7 @@ void Household::print_basic(std::ostream& where) const
 // Calculates and stores fraction of infected agents if any 
 void Household::compute_infected_contribution()
 {
-	num_tot = agent_IDs.size();
+	num_tot = get_number_of_agents();
 	
 	if (num_tot == 0)
 		lambda_tot = 0.0;
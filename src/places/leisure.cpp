@@ -20,7 +20,9 @@ void Leisure::compute_infected_contribution()
 	if (type == "outside") {
 		lambda_tot = lam_tot_out;
 	} else {
+		// Sum of the contributions is without the transmission rate
 		Place::compute_infected_contribution();
+		lambda_tot *= beta_j;
 	}
 }
 
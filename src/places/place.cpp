@@ -15,7 +15,7 @@
 void Place::register_agent(const int agent_ID, const bool is_infected)
 {
 	// Store ID
-	agent_IDs.push_back(agent_ID);
+	insert_agent_ID(agent_ID);
 	// Update total
 	++num_tot;
 	// Update infected if agent is infected
@@ -32,7 +32,7 @@ void Place::register_agent(const int agent_ID, const bool is_infected)
 // from exposed and symptoamtic agents if any 
 void Place::compute_infected_contribution()
 {
-	num_tot = agent_IDs.size();
+	num_tot = get_number_of_agents();
 	
 	if (num_tot == 0){
 		lambda_tot = 0.0;
@@ -49,7 +49,7 @@ void Place::compute_infected_contribution()
 void Place::print_basic(std::ostream& where) const
 {
 	where << ID << " " << x << " " << y << " "
-		  << num_tot << " " << num_infected << " "
+		  << get_number_of_agents() << " " << num_infected << " "
 		  << ck << " " << beta_j;	
 }
 
@@ -57,13 +57,96 @@ void Place::print_basic(std::ostream& where) const
 // Initialization and update
 //
 
+// Add to the sum of contributions and the number of infected
+void Place::add_contribution(const double lambda, const int n_inf)
+{
+	if (DeferredUpdates* rec = DeferredUpdates::recorder()) {
+		rec->record(DeferredUpdates::Type::place_contribution, n_inf, this, lambda);
+		return;
+	}
+	lambda_sum += lambda;
+	num_infected += n_inf;
+}
+
+// Add a new agent to this place
+void Place::add_agent(const int index)
+{
+	if (DeferredUpdates* rec = DeferredUpdates::recorder()) {
+		rec->record(DeferredUpdates::Type::place_add, index, this);
+		return;
+	}
+	insert_agent_ID(index);
+}
+
 // Remove an agent from this place
 void Place::remove_agent(const int index)
 {
-	std::vector<int> new_agent_IDs = {};
-	std::remove_copy(agent_IDs.begin(), agent_IDs.end(),
-					std::back_insert_iterator<std::vector<int>>(new_agent_IDs), index);
-	std::swap(new_agent_IDs, agent_IDs);
+	if (DeferredUpdates* rec = DeferredUpdates::recorder()) {
+		rec->record(DeferredUpdates::Type::place_remove, index, this);
+		return;
+	}
+	int pos = agent_position(index);
+	while (pos >= 0) {
+		// Move the last agent to the freed position
+		const int last = agent_IDs.size() - 1;
+		const int moved = agent_IDs.at(last);
+		if (!agent_slots.empty()) {
+			erase_slot(index, pos);
+			if (pos != last) {
+				erase_slot(moved, last);
+				agent_slots.emplace(moved, pos);
+			}
+		}
+		agent_IDs.at(pos) = moved;
+		agent_IDs.pop_back();
+		pos = agent_position(index);
+	}
+	// Index is rebuilt if the place grows again
+	if (static_cast<int>(agent_IDs.size()) <= slot_index_min/2) {
+		agent_slots.clear();
+	}
+}
+
+// Store agent ID with its position
+void Place::insert_agent_ID(const int index)
+{
+	agent_IDs.push_back(index);
+	if (!agent_slots.empty()) {
+		agent_slots.emplace(index, agent_IDs.size() - 1);
+	} else if (static_cast<int>(agent_IDs.size()) > slot_index_min) {
+		for (int pos = 0; pos < static_cast<int>(agent_IDs.size()); ++pos) {
+			agent_slots.emplace(agent_IDs.at(pos), pos);
+		}
+	}
+}
+
+// Lowest position of an agent, -1 if not in this place
+int Place::agent_position(const int index) const
+{
+	if (agent_slots.empty()) {
+		auto iter = std::find(agent_IDs.begin(), agent_IDs.end(), index);
+		return (iter == agent_IDs.end()) ? -1 : static_cast<int>(iter - agent_IDs.begin());
+	}
+	int pos = -1;
+	auto range = agent_slots.equal_range(index);
+	for (auto iter = range.first; iter != range.second; ++iter) {
+		if ((pos < 0) || (iter->second < pos)) {
+			pos = iter->second;
+		}
+	}
+	return pos;
+}
+
+// Remove one stored position of an agent
+void Place::erase_slot(const int index, const int pos)
+{
+	auto range = agent_slots.equal_range(index);
+	for (auto iter = range.first; iter != range.second; ++iter) {
+		if (iter->second == pos) {
+			agent_slots.erase(iter);
+			return;
+		}
+	}
 }
 
 //
@@ -33,3 +33,30 @@ double ThreePartFunction::y_value(const double t) const
 		return y1;
 	}
 }
+
+// Copy of the function with all ts moved by an offset
+ThreePartFunction ThreePartFunction::shifted(const double offset) const
+{
+	// Constant functions have all ts at 0
+	if (t0 == t1) {
+		return *this;
+	}
+	return ThreePartFunction({{t0, y0}, {t1, y1}, {t2, y2}, {t3, y3}}, offset);
+}
+
+// Values at one time of copies of the function started at different times
+void ThreePartFunction::evaluate(const std::vector<double>& starts, const double time, 
+									std::vector<double>& values) const
+{
+	const int n = starts.size();
+	values.resize(n);
+	const double* st = starts.data();
+	double* val = values.data();
+	for (int i = 0; i < n; ++i) {
+		const double t = time - st[i];
+		// All the regions, then select, same operations as y_value()
+		const double inc = s_inc*t + i_inc;
+		const double dec = std::max(0.0, (s_dec*t + i_dec));
+		val[i] = (t < t1) ? inc : ((t > t2) ? dec : y1);
+	}
+}
@@ -0,0 +1,372 @@
+#include "../include/town.h"
+
+/*****************************************************
+ * class: Town
+ *
+ * Read-only input of a simulation that does not
+ * change after setup
+ *
+ ******************************************************/
+
+// Load all the input and compute mobility probabilities
+Town::Town(const std::string& filename, const int n_threads)
+{
+	LoadParameters ldparam;
+	setup_files = ldparam.load_parameter_map<std::string>(filename);
+	infection_parameters = ldparam.load_parameter_map<double>(setup_files.at("Simulation parameters"));
+	InfectionParameters::report_unknown(infection_parameters);
+
+	// Places and agents, file content is not kept
+	households = create_households(read_object(setup_files.at("Household data")), infection_parameters);
+	schools = create_schools(read_object(setup_files.at("School data")), infection_parameters);
+	workplaces = create_workplaces(read_object(setup_files.at("Workplace data")), infection_parameters);
+	hospitals = create_hospitals(read_object(setup_files.at("Hospital data")), infection_parameters);
+	retirement_homes = create_retirement_homes(read_object(setup_files.at("Retirement home data")), 
+								infection_parameters);
+	carpools = create_carpools(read_object(setup_files.at("Carpool data")), infection_parameters);
+	public_transit = create_public_transit(read_object(setup_files.at("Public transit data")), 
+								infection_parameters);
+	leisure_locations = create_leisure_locations(read_object(setup_files.at("Leisure location data")), 
+								infection_parameters);
+	agents = create_agents(read_object(setup_files.at("Agent data")), infection_parameters);
+
+	initialize_mobility(n_threads);
+}
+
+// Create households from loaded file content
+std::vector<Household> Town::create_households(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<Household> households;
+	// One household per line
+	for (auto& house : file){
+		// Extract properties, add infection parameters
+		Household temp_house(std::stoi(house.at(0)), 
+			std::stod(house.at(1)), std::stod(house.at(2)),
+			infection_parameters.at("household scaling parameter"),
+			infection_parameters.at("severity correction"),
+			infection_parameters.at("household transmission rate"),
+			infection_parameters.at("transmission rate of home isolated"));
+		// Store 
+		households.push_back(temp_house);
+	}
+	return households;
+}
+
+// Create retirement homes from loaded file content
+std::vector<RetirementHome> Town::create_retirement_homes(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<RetirementHome> retirement_homes;
+	// One household per line
+	for (auto& rh : file){
+		// Extract properties, add infection parameters
+		RetirementHome temp_RH(std::stoi(rh.at(0)), 
+			std::stod(rh.at(1)), std::stod(rh.at(2)),
+			infection_parameters.at("severity correction"),
+			infection_parameters.at("RH employee absenteeism factor"),
+			infection_parameters.at("RH employee transmission rate"),
+			infection_parameters.at("RH resident transmission rate"),
+			infection_parameters.at("RH transmission rate of home isolated"));
+		// Store 
+		retirement_homes.push_back(temp_RH);
+	}
+	return retirement_homes;
+}
+
+// Create schools from loaded file content
+std::vector<School> Town::create_schools(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<School> schools;
+	// One workplace per line
+	for (auto& school : file){
+		// Extract properties, add infection parameters
+		// School-type dependent absenteeism
+		double psi = 0.0;
+		std::string school_type = school.at(3);
+		if (school_type == "daycare")
+ 			psi = infection_parameters.at("daycare absenteeism correction");
+		else if (school_type == "primary" || school_type == "middle")
+ 			psi = infection_parameters.at("primary and middle school absenteeism correction");
+		else if (school_type == "high")
+ 			psi = infection_parameters.at("high school absenteeism correction");
+		else if (school_type == "college")
+ 			psi = infection_parameters.at("college absenteeism correction");
+		else
+			throw std::invalid_argument("Wrong school type: " + school_type);
+		School temp_school(std::stoi(school.at(0)), 
+			std::stod(school.at(1)), std::stod(school.at(2)),
+			infection_parameters.at("severity correction"),	
+			infection_parameters.at("school employee absenteeism correction"), psi,
+			infection_parameters.at("school employee transmission rate"), 
+			infection_parameters.at("school transmission rate"));
+		// Store 
+		schools.push_back(temp_school);
+	}
+	return schools;
+}
+
+// Create workplaces from loaded file content
+std::vector<Workplace> Town::create_workplaces(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<Workplace> workplaces;
+	// One workplace per line
+	for (auto& work : file){
+		// Get the occupation type of the workplace
+		std::string work_type = work.at(3);
+		std::string rate_by_type = "outside";
+		double work_rate = 0.0;	 
+		if (work_type == "A") { 
+			rate_by_type = "management science art transmission rate"; 
+		} else if (work_type == "B") { 
+			rate_by_type = "service occupation transmission rate";
+		} else if (work_type == "C") { 
+			rate_by_type = "sales office transmission rate"; 
+		} else if (work_type == "D") { 
+			rate_by_type = "construction maintenance transmission rate"; 
+		} else if (work_type == "E") { 
+			rate_by_type = "production transportation transmission rate"; 
+		} 
+		if (work_type != "outside") {
+		 	work_rate = infection_parameters.at(rate_by_type);
+		} else {
+			work_rate = 1.0;
+		}
+		// Extract properties, add infection parameters
+		Workplace temp_work(std::stoi(work.at(0)), 
+			std::stod(work.at(1)), std::stod(work.at(2)),
+			infection_parameters.at("severity correction"),
+			infection_parameters.at("work absenteeism correction"),
+			work_rate, work.at(3)); 
+		// Store 
+		workplaces.push_back(temp_work);
+	}
+	return workplaces;
+}
+
+// Create hospitals from loaded file content
+std::vector<Hospital> Town::create_hospitals(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<Hospital> hospitals;
+	// One hospital per line
+	for (auto& hospital : file){
+		// Make a map of transmission rates for different 
+		// hospital-related categories
+		std::map<const std::string, const double> betas = 
+			{{"hospital employee", infection_parameters.at("healthcare employees transmission rate")}, 
+			 {"hospital non-COVID patient", infection_parameters.at("hospital patients transmission rate")},
+			 {"hospital testee", infection_parameters.at("hospital tested transmission rate")},
+			 {"hospitalized", infection_parameters.at("hospitalized transmission rate")}, 
+			 {"hospitalized ICU", infection_parameters.at("hospitalized ICU transmission rate")}};
+		Hospital temp_hospital(std::stoi(hospital.at(0)), 
+			std::stod(hospital.at(1)), std::stod(hospital.at(2)),
+			infection_parameters.at("severity correction"), betas);
+		// Store 
+		hospitals.push_back(temp_hospital);
+	}
+	return hospitals;
+}
+
+// Create carpools from loaded file content
+std::vector<Transit> Town::create_carpools(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<Transit> carpools;
+	// One carpool per line
+	for (auto& cpl : file) {
+		// Extract properties, add infection parameters
+		Transit temp_transit(std::stoi(cpl.at(0)), 
+			infection_parameters.at("carpool transmission rate"),
+			infection_parameters.at("severity correction"),  
+			infection_parameters.at("work absenteeism correction"),
+			cpl.at(1));
+		// Store 
+		carpools.push_back(temp_transit);
+	}
+	return carpools;
+}
+
+// Create public transit from loaded file content
+std::vector<Transit> Town::create_public_transit(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<Transit> public_transit;
+	// Transmission rate based on current capacity
+	double beta_T = infection_parameters.at("public transit beta0") 
+					+ infection_parameters.at("public transit beta full")
+						*infection_parameters.at("public transit current capacity");
+	// One public transit per line
+	for (auto& pbt : file) {
+		// Extract properties, add infection parameters
+		Transit temp_transit(std::stoi(pbt.at(0)),
+			beta_T, infection_parameters.at("severity correction"),  
+			infection_parameters.at("work absenteeism correction"),  
+			pbt.at(1));
+		// Store 
+		public_transit.push_back(temp_transit);
+	}
+	return public_transit;
+}
+
+// Create leisure locations from loaded file content
+std::vector<Leisure> Town::create_leisure_locations(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<Leisure> leisure_locations;
+	// One leisure location per line
+	for (auto& lsr : file) {
+		// Extract properties, add infection parameters
+		Leisure temp_lsr(std::stoi(lsr.at(0)), 
+			std::stod(lsr.at(1)), std::stod(lsr.at(2)),
+			infection_parameters.at("severity correction"), 
+			infection_parameters.at("leisure locations transmission rate"),	
+			lsr.at(3));
+		// Store 
+		leisure_locations.push_back(temp_lsr);
+	}
+	return leisure_locations;
+}
+
+// Create agents from loaded file content
+std::vector<Agent> Town::create_agents(const std::vector<std::vector<std::string>>& file, 
+								const std::map<std::string, double>& infection_parameters)
+{
+	std::vector<Agent> agents;
+	// Counter for agent IDs
+	int agent_ID = 1;
+	
+	// One agent per line, with properties as defined in the line
+	for (const auto& agent : file){
+		// Agent status
+		bool student = false, works = false, livesRH = false, worksRH = false,  
+			 worksSch = false, patient = false, hospital_staff = false,
+			 works_from_home = false;
+		int house_ID = -1, workID = 0, cpID = 0, ptID = 0;
+		double work_travel_time = 0.0;
+		std::string work_travel_mode;
+				
+		// Household ID only if not hospitalized with condition
+		// different than COVID-19
+		if (std::stoi(agent.at(6)) == 1){
+			patient = true;
+			house_ID = 0;
+		}else{
+			house_ID = std::stoi(agent.at(5));
+		}
+
+		// No school or work if patient with condition other than COVID
+		if (std::stoi(agent.at(12)) == 1 && !patient){
+			hospital_staff = true;
+		}
+		if (std::stoi(agent.at(0)) == 1 && !patient){
+			student = true;
+		}
+	   	// No work flag if a hospital employee	
+		if (std::stoi(agent.at(1)) == 1 && !(patient || hospital_staff)){
+			works = true; 
+		}
+			
+		// As in the input file
+		const bool infected = (std::stoi(agent.at(14)) == 1);
+
+		// Retirement home resident
+		if (std::stoi(agent.at(8)) == 1){
+			 livesRH = true;
+		}
+		// Retirement home or school employee
+		if (std::stoi(agent.at(9)) == 1){
+			 worksRH = true;
+		}
+		if (std::stoi(agent.at(10)) == 1){
+			 worksSch = true;
+		}
+
+		// Select correct work ID for special employment types
+		// Hospital ID is set separately, but for consistency
+		if (worksRH || worksSch || hospital_staff) {
+			workID = std::stoi(agent.at(18));
+		} else if (works) {
+			workID = std::stoi(agent.at(11));
+		}
+
+		// Transit information
+		if (std::stoi(agent.at(15)) == 1) {
+			works_from_home = true;
+			work_travel_mode = agent.at(17);
+		} else {
+			if (!(works || hospital_staff)) {
+				work_travel_mode = "None";
+			} else {
+				work_travel_mode = agent.at(17);
+				if (work_travel_mode == "carpool") {
+					cpID = std::stoi(agent.at(19));
+				}
+				if (work_travel_mode == "public") {
+					ptID = std::stoi(agent.at(20));
+				}
+				work_travel_time = std::stod(agent.at(16));
+			}
+		}
+		Agent temp_agent(student, works, std::stoi(agent.at(2)), 
+			std::stod(agent.at(3)), std::stod(agent.at(4)), house_ID,
+			patient, std::stoi(agent.at(7)), livesRH, worksRH,
+		    worksSch, workID, hospital_staff, std::stoi(agent.at(13)), 
+			infected, work_travel_mode, work_travel_time, cpID, ptID, 
+			works_from_home);
+
+		// Set agent occupation
+		std::string work_type = agent.at(21);
+		std::string rate_by_type;
+		temp_agent.set_occupation(work_type);
+		// And the corresponding transmission rate
+		if (work_type != "none") {
+			if (work_type == "A") { 
+				rate_by_type = "management science art transmission rate";
+			} else if (work_type == "B") { 
+				rate_by_type = "service occupation transmission rate";
+			} else if (work_type == "C") { 
+				rate_by_type = "sales office transmission rate"; 
+			} else if (work_type == "D") { 
+				rate_by_type = "construction maintenance transmission rate"; 
+			} else if (work_type == "E") { 
+				rate_by_type = "production transportation transmission rate"; 
+			} 
+			temp_agent.set_occupation_transmission(infection_parameters.at(rate_by_type));
+		}
+
+		// Set Agent ID
+		temp_agent.set_ID(agent_ID++);
+		
+		// Store
+		agents.push_back(temp_agent);
+	}
+	return agents;
+}
+
+// Read object information from a file
+std::vector<std::vector<std::string>> Town::read_object(const std::string& fname)
+{
+	// AbmIO settings
+	std::string delim(" ");
+	bool sflag = true;
+	std::vector<size_t> dims = {0,0,0};
+
+	AbmIO abm_io(fname, delim, sflag, dims);
+	return abm_io.read_vector<std::string>();
+}
+
+// Compute the leisure probabilities
+void Town::initialize_mobility(const int n_threads)
+{
+	mobility.set_parameters(infection_parameters);
+	mobility.set_number_of_threads(n_threads);
+	// Optional, tables are always computed without it
+	const auto& cache_dir = setup_files.find("Mobility cache directory");
+	if (cache_dir != setup_files.end()) {
+		mobility.set_cache_directory(cache_dir->second);
+	}
+	mobility.construct_public_probabilities(households, leisure_locations);
+}
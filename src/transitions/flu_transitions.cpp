@@ -10,22 +10,23 @@
  ******************************************************/
 
 // Implement transitions relevant to susceptible
-std::vector<int> FluTransitions::susceptible_transitions(Agent& agent, const double time, Infection& infection,	
+SusceptibleStateChanges FluTransitions::susceptible_transitions(Agent& agent, const double time, Infection& infection,	
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, Flu& flu, const Testing& testing, const double dt)
+				const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, Flu& flu, const Testing& testing, const double dt,
+				const PlaceIncidence* incidence, const VaccineEffects* vac_effects)
 {
 	double lambda_tot = 0.0;
 	// Infected, tested, negative, false positive
-	std::vector<int> state_changes(4,0);
+	SusceptibleStateChanges state_changes = {0, 0, 0, 0};
 
 	lambda_tot = compute_susceptible_lambda(agent, time, households, schools, workplaces, 
-					hospitals, retirement_homes, carpools, public_transit, leisure_locations);
-	if (infection.infected(lambda_tot, agent.vaccine_effectiveness(time)) == true) {
+					hospitals, retirement_homes, carpools, public_transit, leisure_locations, incidence);
+	if (infection.infected(lambda_tot, vaccine_effectiveness(agent, time, vac_effects)) == true) {
 		state_changes.at(0) = 1;
 		int new_flu = flu.swap_flu_agent(agent.get_ID());
 		// If still available
@@ -85,7 +86,7 @@ std::vector<int> FluTransitions::susceptible_transitions(Agent& agent, const dou
 				// Set the time when they can get a vaccine based on ficticious 
 				// recovery from COVID-19
 				agent.set_time_recovered_can_vaccinate(time+
-							infection_parameters.at("Post-infection vaccination lag"));
+							infection_parameters.post_infection_vaccination_lag);
 				agent.set_suspected_can_vaccinate(false);
 				agent.set_former_suspected(true);
 			}
@@ -106,14 +107,14 @@ void FluTransitions::process_new_flu(Agent& agent, const int n_hospitals, const
 			   		std::vector<School>& schools, std::vector<Workplace>& workplaces,
 					std::vector<RetirementHome>& retirement_homes, std::vector<Transit>& carpools,
 					std::vector<Transit>& public_transit, Infection& infection, 
-					const std::map<std::string, double>& infection_parameters, 
+					const InfectionParameters& infection_parameters, 
 					Flu& flu, const Testing& testing)
 {
 	double test_time = 0.0;
 	agent.set_symptomatic_non_covid(true);
 	// Testing properties
 	if (flu.getting_tested(testing) || agent.contact_traced()){
-		if (infection.tested_in_hospital(infection_parameters.at("fraction tested in hospitals"))){
+		if (infection.tested_in_hospital(infection_parameters.fraction_tested_in_hospitals)){
 			states_manager.set_waiting_for_test_in_hospital(agent);
 			int hsp_ID = infection.get_random_hospital_ID(n_hospitals);
 			// Registration will happen only upon testing time step
@@ -122,13 +123,13 @@ void FluTransitions::process_new_flu(Agent& agent, const int n_hospitals, const
 			states_manager.set_waiting_for_test_in_car(agent);
 		}
 		// Set testing times
-		test_time = infection.wait_time_for_test(infection_parameters.at("flu testing duration"));
+		test_time = infection.wait_time_for_test(infection_parameters.flu_testing_duration);
 		agent.set_time_to_test(test_time);
 		agent.set_time_of_test(time);
 		// Delay home isolation until fixed number of days before test
 		agent.set_home_isolated(false);
 		// Time to start isolation 
-		agent.set_flu_isolation(infection_parameters.at("time from decision to test"));
+		agent.set_flu_isolation(infection_parameters.time_from_decision_to_test);
 	}
 }
 
@@ -139,7 +140,7 @@ double FluTransitions::compute_susceptible_lambda(const Agent& agent, const doub
 					const std::vector<RetirementHome>& retirement_homes, 
 					const std::vector<Transit>& carpools, 
 					const std::vector<Transit>& public_transit,
-					const std::vector<Leisure>& leisure_locations)			
+					const std::vector<Leisure>& leisure_locations, const PlaceIncidence* incidence)			
 {
 	double lambda_tot = 0.0;
 
@@ -167,6 +168,48 @@ double FluTransitions::compute_susceptible_lambda(const Agent& agent, const doub
 		lambda_tot = house.get_infected_contribution();
 		return lambda_tot;
 	}
+	// Household, school, work, and transit
+	if (incidence != nullptr) {
+		lambda_tot = incidence->routine_lambda(agent.get_ID());
+	} else {
+		lambda_tot = compute_routine_lambda(agent, households, schools, workplaces, 
+							retirement_homes, carpools, public_transit);
+	}
+
+	// Leisure
+	if (agent.get_leisure_ID() > 0) {
+		if (agent.get_leisure_location_type() == LeisureType::public_location) {
+			lambda_tot += leisure_locations.at(agent.get_leisure_ID()-1).get_infected_contribution();
+		} else if (agent.get_leisure_location_type() == LeisureType::household) {
+			lambda_tot += households.at(agent.get_leisure_ID()-1).get_infected_contribution();
+		} else {
+			throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
+		}
+	}
+
+	// This part needs to be last	
+	// Overwrite if being tested or in home isolation
+	if ((agent.tested()) && (agent.tested_in_hospital()) 
+			&& (agent.get_time_of_test() <= time)
+			&& (agent.tested_awaiting_test() == true)){
+		const Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
+		lambda_tot = hospital.get_infected_contribution();
+	} else if (agent.home_isolated() == true){
+		// Otherwise if waiting for test or results - home isolation
+		lambda_tot =  house.get_infected_contribution();
+	}
+	return lambda_tot;
+}
+
+// Household, school, work, and transit part of lambda of susceptible agent 
+double FluTransitions::compute_routine_lambda(const Agent& agent, 
+					const std::vector<Household>& households, const std::vector<School>& schools,
+					const std::vector<Workplace>& workplaces, 
+					const std::vector<RetirementHome>& retirement_homes, 
+					const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit)
+{
+	double lambda_tot = 0.0;
+	const Household& house = households.at(agent.get_household_ID()-1);
 	if (agent.student() && agent.works() && !agent.works_from_home()){
 		const School& school = schools.at(agent.get_school_ID()-1);
 		if (agent.retirement_home_employee()){
@@ -221,41 +264,19 @@ double FluTransitions::compute_susceptible_lambda(const Agent& agent, const doub
 	}
 
 	// Transit
-	if (agent.get_work_travel_mode() == "carpool") {
+	if (agent.get_travel_mode() == TravelMode::carpool) {
 		lambda_tot += carpools.at(agent.get_carpool_ID()-1).get_infected_contribution();
 	}
-	if (agent.get_work_travel_mode() == "public") {
+	if (agent.get_travel_mode() == TravelMode::public_transit) {
 		lambda_tot += public_transit.at(agent.get_public_transit_ID()-1).get_infected_contribution();
 	}
 
-	// Leisure
-	if (agent.get_leisure_ID() > 0) {
-		if (agent.get_leisure_type() == "public") {
-			lambda_tot += leisure_locations.at(agent.get_leisure_ID()-1).get_infected_contribution();
-		} else if (agent.get_leisure_type() == "household") {
-			lambda_tot += households.at(agent.get_leisure_ID()-1).get_infected_contribution();
-		} else {
-			throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
-		}
-	}
-
-	// This part needs to be last	
-	// Overwrite if being tested or in home isolation
-	if ((agent.tested()) && (agent.tested_in_hospital()) 
-			&& (agent.get_time_of_test() <= time)
-			&& (agent.tested_awaiting_test() == true)){
-		const Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-		lambda_tot = hospital.get_infected_contribution();
-	} else if (agent.home_isolated() == true){
-		// Otherwise if waiting for test or results - home isolation
-		lambda_tot =  house.get_infected_contribution();
-	}
 	return lambda_tot;
 }
 
 // Compte and set agent properties related to recovery without symptoms and incubation 
 void FluTransitions::recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Determine if agent will recover without
 	// becoming symptomatic and update corresponding states
@@ -264,12 +285,12 @@ void FluTransitions::recovery_and_incubation(Agent& agent, Infection& infection,
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_parameters.time_from_exposed_to_infectiousness, latency);
 
 	if (never_sy){
 		states_manager.set_susceptible_to_exposed_never_symptomatic(agent);
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -287,7 +308,7 @@ void FluTransitions::set_testing_status(Agent& agent, Infection& infection, cons
 										std::vector<School>& schools, std::vector<Workplace>& workplaces, 
 										std::vector<Hospital>& hospitals, std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 	const int n_hospitals = hospitals.size();
@@ -300,7 +321,7 @@ void FluTransitions::set_testing_status(Agent& agent, Infection& infection, cons
 		if (will_be_tested == true || agent.contact_traced()) {
 			will_be_tested == true;
 			// Determine type of testing
-			if (infection.tested_in_hospital(infection_parameters.at("fraction tested in hospitals"))){
+			if (infection.tested_in_hospital(infection_parameters.fraction_tested_in_hospitals)){
 				states_manager.set_exposed_waiting_for_test_in_hospital(agent);
 				int hsp_ID = infection.get_random_hospital_ID(n_hospitals);
 				// Registration will happen only upon testing time step
@@ -312,7 +333,7 @@ void FluTransitions::set_testing_status(Agent& agent, Infection& infection, cons
 			remove_from_all_workplaces_and_schools(agent, schools, workplaces, retirement_homes,
 							carpools, public_transit);
 			// Time to test
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 		}
 	} 
@@ -320,10 +341,10 @@ void FluTransitions::set_testing_status(Agent& agent, Infection& infection, cons
 
 // Non-covid symptomatic testing changes
 void FluTransitions::testing_transitions_flu(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters)
+										const InfectionParameters& infection_parameters)
 {
 	// Determine the time agent gets results
-	agent.set_time_until_results(infection_parameters.at("time from test to results"));
+	agent.set_time_until_results(infection_parameters.time_from_test_to_results);
 	agent.set_time_of_results(time);
 	states_manager.set_tested_to_awaiting_results(agent);
 }
@@ -336,13 +357,13 @@ void FluTransitions::testing_results_transitions_flu(Agent& agent,
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters, const Testing& testing)
+			const InfectionParameters& infection_parameters, const Testing& testing)
 {
 	// If false positive, put under home isolation 
-	double fneg_prob = infection_parameters.at("fraction false positive");
+	double fneg_prob = infection_parameters.fraction_false_positive;
 	if (infection.false_positive_test_result(fneg_prob) == true){
 		states_manager.set_tested_false_positive(agent);
-		agent.set_recovery_duration(infection_parameters.at("recovery time"));
+		agent.set_recovery_duration(infection_parameters.recovery_time);
 		agent.set_recovery_time(time);	
 	} else { 		
 		// Quarantined agent, or agent in the post-quarantine period 
@@ -355,7 +376,7 @@ void FluTransitions::testing_results_transitions_flu(Agent& agent,
 												carpools, public_transit);
 			// Set the time when they can get a vaccine 		
 			agent.set_time_recovered_can_vaccinate(time+
-							infection_parameters.at("Post-infection vaccination lag"));
+							infection_parameters.post_infection_vaccination_lag);
 			agent.set_suspected_can_vaccinate(false);
 			agent.set_former_suspected(true);
 		} else {
@@ -400,10 +421,10 @@ void FluTransitions::remove_from_all_workplaces_and_schools(Agent& agent,
 		} else {
 			workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
 		}
 	}
@@ -430,10 +451,10 @@ void FluTransitions::add_to_all_workplaces_and_schools(Agent& agent,
 		} else {
 			workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
 		}
 	}
@@ -15,14 +15,15 @@ int HspEmployeeTransitions::susceptible_transitions(Agent& agent, const double t
 				std::vector<Hospital>& hospitals,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, const Testing& testing)
+				const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, const Testing& testing,
+				const PlaceIncidence* incidence, const VaccineEffects* vac_effects)
 {
 	double lambda_tot = 0.0;
 	int got_infected = 0;
 	lambda_tot = compute_susceptible_lambda(agent, time, households, schools, hospitals, 
-					carpools, public_transit, leisure_locations);
-	if (infection.infected(lambda_tot, agent.vaccine_effectiveness(time)) == true){
+					carpools, public_transit, leisure_locations, incidence);
+	if (infection.infected(lambda_tot, vaccine_effectiveness(agent, time, vac_effects)) == true){
 		got_infected = 1;
 		agent.set_inf_variability_factor(infection.inf_variability()*agent.transmission_correction(time));
 		// Infectiousness, latency, and possibility of never developing symptoms 
@@ -42,7 +43,7 @@ double HspEmployeeTransitions::compute_susceptible_lambda(const Agent& agent, co
 					const std::vector<Household>& households, const std::vector<School>& schools,
 					const std::vector<Hospital>& hospitals, 
 					const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit,
-					const std::vector<Leisure>& leisure_locations)			
+					const std::vector<Leisure>& leisure_locations, const PlaceIncidence* incidence)			
 {
 	double lambda_tot = 0.0;
 	// Count hospital instead of workplace
@@ -52,30 +53,36 @@ double HspEmployeeTransitions::compute_susceptible_lambda(const Agent& agent, co
 		lambda_tot = house.get_infected_contribution();
 		return lambda_tot;
 	}
-	const Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-	if (agent.student()){
-		const School& school = schools.at(agent.get_school_ID()-1);
-		lambda_tot = house.get_infected_contribution()+ 
-						hospital.get_infected_contribution()+
-						school.get_infected_contribution();
+
+	// Household, hospital, school, and transit
+	if (incidence != nullptr) {
+		lambda_tot = incidence->routine_lambda(agent.get_ID());
 	} else {
-		lambda_tot = house.get_infected_contribution()+ 
-			hospital.get_infected_contribution();	
-	}
+		const Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
+		if (agent.student()){
+			const School& school = schools.at(agent.get_school_ID()-1);
+			lambda_tot = house.get_infected_contribution()+ 
+							hospital.get_infected_contribution()+
+							school.get_infected_contribution();
+		} else {
+			lambda_tot = house.get_infected_contribution()+ 
+				hospital.get_infected_contribution();	
+		}
 
-	// Transit
-	if (agent.get_work_travel_mode() == "carpool") {
-		lambda_tot += carpools.at(agent.get_carpool_ID()-1).get_infected_contribution();
-	}
-	if (agent.get_work_travel_mode() == "public") {
-		lambda_tot += public_transit.at(agent.get_public_transit_ID()-1).get_infected_contribution();
+		// Transit
+		if (agent.get_travel_mode() == TravelMode::carpool) {
+			lambda_tot += carpools.at(agent.get_carpool_ID()-1).get_infected_contribution();
+		}
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
+			lambda_tot += public_transit.at(agent.get_public_transit_ID()-1).get_infected_contribution();
+		}
 	}
 
 	// Leisure
 	if (agent.get_leisure_ID() > 0) {
-		if (agent.get_leisure_type() == "public") {
+		if (agent.get_leisure_location_type() == LeisureType::public_location) {
 			lambda_tot += leisure_locations.at(agent.get_leisure_ID()-1).get_infected_contribution();
-		} else if (agent.get_leisure_type() == "household") {
+		} else if (agent.get_leisure_location_type() == LeisureType::household) {
 			lambda_tot += households.at(agent.get_leisure_ID()-1).get_infected_contribution();
 		} else {
 			throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
@@ -86,7 +93,7 @@ double HspEmployeeTransitions::compute_susceptible_lambda(const Agent& agent, co
 
 // Compte and set agent properties related to recovery without symptoms and incubation 
 void HspEmployeeTransitions::recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Determine if agent will recover without
 	// becoming symptomatic and update corresponding states
@@ -95,12 +102,12 @@ void HspEmployeeTransitions::recovery_and_incubation(Agent& agent, Infection& in
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_parameters.time_from_exposed_to_infectiousness, latency);
 
 	if (never_sy){
 		states_manager.set_susceptible_to_exposed_never_symptomatic(agent);
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -114,12 +121,12 @@ void HspEmployeeTransitions::recovery_and_incubation(Agent& agent, Infection& in
 }
 
 // Implement transitions relevant to exposed 
-std::vector<int> HspEmployeeTransitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
+InfectedStateChanges HspEmployeeTransitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 										std::vector<Household>& households, std::vector<School>& schools, std::vector<Hospital>& hospitals,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters, const Testing& testing)
+										const InfectionParameters& infection_parameters, const Testing& testing)
 {
-	std::vector<int> state_changes(5,0);
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 	// Modified mortality for hospital emloyees
 	const bool is_hsp = true; 
 
@@ -157,12 +164,12 @@ std::vector<int> HspEmployeeTransitions::exposed_transitions(Agent& agent, Infec
 				// In this case isolation is a sign of detection, wich is the
 				// only time when the lag applies for the asymptomatic
 				agent.set_time_recovered_can_vaccinate(time+
-						infection_parameters.at("Post-infection vaccination lag"));
+						infection_parameters.post_infection_vaccination_lag);
 			}
 			states_manager.set_exposed_never_symptomatic_to_removed(agent);
 			// Set up the time to transit back to susceptible
 			agent.set_time_recovered_to_susceptible(time+
-						infection_parameters.at("Post-infection immunity duration"));
+						infection_parameters.post_infection_immunity_duration);
 			agent.set_removed_recovered(true);
 			agent_recovered = 1;
 		} else {
@@ -184,7 +191,7 @@ std::vector<int> HspEmployeeTransitions::exposed_transitions(Agent& agent, Infec
 			} else {
 				states_manager.set_recovering_symptomatic(agent);			
 				// This may change if treatment is ICU
-				agent.set_recovery_duration(infection_parameters.at("recovery time"));
+				agent.set_recovery_duration(infection_parameters.recovery_time);
 				agent.set_recovery_time(time);		
 			}
 
@@ -221,7 +228,7 @@ std::vector<int> HspEmployeeTransitions::exposed_transitions(Agent& agent, Infec
 // Determine any testing related properties
 void HspEmployeeTransitions::set_testing_status(Agent& agent, Infection& infection, const double time, 
 										std::vector<School>& schools, std::vector<Hospital>& hospitals,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 	const int n_hospitals = hospitals.size();
@@ -235,7 +242,7 @@ void HspEmployeeTransitions::set_testing_status(Agent& agent, Infection& infecti
 			// Also - no home isolation until symptoms
 			states_manager.set_exposed_waiting_for_test_in_hospital(agent);
 			// Time to test
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 		}
 	} else if (agent.symptomatic()) {
@@ -243,23 +250,23 @@ void HspEmployeeTransitions::set_testing_status(Agent& agent, Infection& infecti
 		// with home isolation set elsewhere
 		states_manager.set_waiting_for_test_in_hospital(agent);
 		// Testing-related events - will be adjusted based on other time-dependent scenarios
-		agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+		agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 		agent.set_time_of_test(time);
 	}
 }
 
 // Transitions of a symptomatic agent 
-std::vector<int> HspEmployeeTransitions::symptomatic_transitions(Agent& agent, const double time, 
+InfectedStateChanges HspEmployeeTransitions::symptomatic_transitions(Agent& agent, const double time, 
 				   	const double dt, Infection& infection,
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Hospital>& hospitals,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-					const std::map<std::string, double>& infection_parameters)
+					const InfectionParameters& infection_parameters)
 {
-	std::vector<int> state_changes(5,0);
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 	int tested_pos = 0;
 	// First entry is one if agent recovered, second if agent died
-	std::vector<int> removed = {0,0};
+	RemovalStateChanges removed = {0, 0};
 	removed = check_agent_removal(agent, time, households, schools, hospitals,
 					carpools, public_transit);
 	state_changes.at(0) = removed.at(0);
@@ -275,11 +282,11 @@ std::vector<int> HspEmployeeTransitions::symptomatic_transitions(Agent& agent, c
 		if (agent.removed_recovered()) {
 			// Set up the time to transit back to susceptible
 			agent.set_time_recovered_to_susceptible(time+
-						infection_parameters.at("Post-infection immunity duration"));
+						infection_parameters.post_infection_immunity_duration);
 			if (!agent.contact_traced()) {
 				// And the time when the agent becomes eligible for vaccination			
 				agent.set_time_recovered_can_vaccinate(time+
-							infection_parameters.at("Post-infection vaccination lag"));
+							infection_parameters.post_infection_vaccination_lag);
 			}
 		} 
 		return state_changes;
@@ -309,13 +316,13 @@ std::vector<int> HspEmployeeTransitions::symptomatic_transitions(Agent& agent, c
 }
 
 // Verify if agent is to be removed at this step
-std::vector<int> HspEmployeeTransitions::check_agent_removal(Agent& agent, const double time,
+RemovalStateChanges HspEmployeeTransitions::check_agent_removal(Agent& agent, const double time,
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Hospital>& hospitals, std::vector<Transit>& carpools, 
 					std::vector<Transit>& public_transit)
 {
 	// First entry is one if agent recovered, second if agent died
-	std::vector<int> removed = {0,0};
+	RemovalStateChanges removed = {0, 0};
 	// If dying
 	if (agent.dying() == true){
 		if (agent.get_time_of_death() <= time){
@@ -354,10 +361,10 @@ std::vector<int> HspEmployeeTransitions::check_agent_removal(Agent& agent, const
 
 // Agent transitions related to testing time
 void HspEmployeeTransitions::testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters)
+										const InfectionParameters& infection_parameters)
 {
 	// Determine the time agent gets results
-	agent.set_time_until_results(infection_parameters.at("time from test to results"));
+	agent.set_time_until_results(infection_parameters.time_from_test_to_results);
 	agent.set_time_of_results(time);
 	states_manager.set_tested_to_awaiting_results(agent);
 }
@@ -368,11 +375,11 @@ int HspEmployeeTransitions::testing_results_transitions(Agent& agent,
 			std::vector<Household>& households, std::vector<School>& schools,
 			std::vector<Hospital>& hospitals,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// If false negative, remove testing, put back to exposed
 	// No false negative symptomatic
-	double fneg_prob = infection_parameters.at("fraction false negative");
+	double fneg_prob = infection_parameters.fraction_false_negative;
 	int tested_pos = 0;
 	if (infection.false_negative_test_result(fneg_prob) == true
 				&& agent.exposed() == true){
@@ -412,7 +419,7 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 			std::vector<Household>& households, std::vector<School>& schools,
 			std::vector<Hospital>& hospitals,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (infection.agent_hospitalized(agent.get_age(), agent.severe_correction(time)) == true){
       	if (agent.contact_traced()) {
@@ -438,8 +445,8 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 				// If recovering - set times and transitions
 				states_manager.set_icu_recovering(agent);
 				// Reset the recovery time to > ICU + hospitalization
-				double t_icu = infection_parameters.at("time in ICU");
-				double t_hsp_icu = infection_parameters.at("time in hospital after ICU");
+				double t_icu = infection_parameters.time_in_ICU;
+				double t_hsp_icu = infection_parameters.time_in_hospital_after_ICU;
 				agent.set_time_icu_to_hsp(time + t_icu);
 			   	agent.set_time_hsp_to_ih(time + t_icu + t_hsp_icu);	
 				agent.set_recovery_duration(t_icu + t_hsp_icu);
@@ -450,13 +457,13 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 			states_manager.set_hospitalized(agent);
 			// If dying, set transition to ICU
 			if (agent.dying() == true){
-				double dt_icu = infection_parameters.at("time before death to ICU");
+				double dt_icu = infection_parameters.time_before_death_to_ICU;
 				double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 				agent.set_time_hsp_to_icu(t_icu);	
 			}else{
 				// If recovering, set transition to home
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -472,7 +479,7 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 		states_manager.set_home_isolation(agent);
 		// If dying, set transition to ICU
 		if (agent.dying() == true){
-			double dt_icu = infection_parameters.at("time before death to ICU");
+			double dt_icu = infection_parameters.time_before_death_to_ICU;
 			double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 			agent.set_time_ih_to_icu(t_icu);	
 		}else{
@@ -495,7 +502,7 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 void HspEmployeeTransitions::treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// ICU - can only transition to hospitalization
 	// if not dying
@@ -552,7 +559,7 @@ void HspEmployeeTransitions::treatment_transitions(Agent& agent, const double ti
 				households.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
 				// Set transition back
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -585,10 +592,10 @@ void HspEmployeeTransitions::remove_agent_from_all_places(const Agent& agent,
 		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);
 	}
 	hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
-	if (agent.get_work_travel_mode() == "carpool") {
+	if (agent.get_travel_mode() == TravelMode::carpool) {
 		carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
 	}
-	if (agent.get_work_travel_mode() == "public") {
+	if (agent.get_travel_mode() == TravelMode::public_transit) {
 		public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
 	}
 }
@@ -614,10 +621,10 @@ void HspEmployeeTransitions::add_agent_to_all_places(const Agent& agent,
 		hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
 	}
 	hospitals.at(agent.get_hospital_ID()-1).add_agent(agent_ID);
-	if (agent.get_work_travel_mode() == "carpool") {
+	if (agent.get_travel_mode() == TravelMode::carpool) {
 		carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
 	}
-	if (agent.get_work_travel_mode() == "public") {
+	if (agent.get_travel_mode() == TravelMode::public_transit) {
 		public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
 	}
 }
@@ -632,10 +639,10 @@ void HspEmployeeTransitions::remove_from_hospitals_and_schools(const Agent& agen
 	if (agent.student()){
 		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);				
 	}
-	if (agent.get_work_travel_mode() == "carpool") {
+	if (agent.get_travel_mode() == TravelMode::carpool) {
 		carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
 	}
-	if (agent.get_work_travel_mode() == "public") {
+	if (agent.get_travel_mode() == TravelMode::public_transit) {
 		public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
 	}
 }
@@ -650,10 +657,10 @@ void HspEmployeeTransitions::add_to_hospitals_and_schools(const Agent& agent,
 		schools.at(agent.get_school_ID()-1).add_agent(agent_ID);
 	}
 	hospitals.at(agent.get_hospital_ID()-1).add_agent(agent_ID);
-	if (agent.get_work_travel_mode() == "carpool") {
+	if (agent.get_travel_mode() == TravelMode::carpool) {
 		carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
 	}
-	if (agent.get_work_travel_mode() == "public") {
+	if (agent.get_travel_mode() == TravelMode::public_transit) {
 		public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
 	}
 }
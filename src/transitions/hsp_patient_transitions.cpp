@@ -12,15 +12,16 @@
 
 // Implement transitions relevant to susceptible
 int HspPatientTransitions::susceptible_transitions(Agent& agent, const double time, Infection& infection,	
-				std::vector<Hospital>& hospitals, const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, const Testing& testing)
+				std::vector<Hospital>& hospitals, const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, const Testing& testing,
+				const VaccineEffects* vac_effects)
 {
 	double lambda_tot = 0.0;
 	int got_infected = 0;
 
 	lambda_tot = compute_susceptible_lambda(agent, time, hospitals);
 
-	if (infection.infected(lambda_tot, agent.vaccine_effectiveness(time)) == true){
+	if (infection.infected(lambda_tot, vaccine_effectiveness(agent, time, vac_effects)) == true){
 		got_infected = 1;
 		agent.set_inf_variability_factor(infection.inf_variability()*agent.transmission_correction(time));
 		// Infectiousness, latency, and possibility of never developing 
@@ -48,7 +49,7 @@ double HspPatientTransitions::compute_susceptible_lambda(const Agent& agent, con
 
 // Compte and set agent properties related to recovery without symptoms and incubation 
 void HspPatientTransitions::recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Determine if agent will recover without
 	// becoming symptomatic and update corresponding states
@@ -57,12 +58,12 @@ void HspPatientTransitions::recovery_and_incubation(Agent& agent, Infection& inf
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_parameters.time_from_exposed_to_infectiousness, latency);
 
 	if (never_sy){
 		states_manager.set_susceptible_to_exposed_never_symptomatic(agent);
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -76,11 +77,11 @@ void HspPatientTransitions::recovery_and_incubation(Agent& agent, Infection& inf
 }
 
 // Implement transitions relevant to exposed 
-std::vector<int> HspPatientTransitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
+InfectedStateChanges HspPatientTransitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 										std::vector<Household>& households, std::vector<Hospital>& hospitals, 
-										const std::map<std::string, double>& infection_parameters, const Testing& testing)
+										const InfectionParameters& infection_parameters, const Testing& testing)
 {
-	std::vector<int> state_changes(5,0);
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 	// Modified mortality rate for hospital patients
 	const bool is_hsp = true;
 
@@ -115,12 +116,12 @@ std::vector<int> HspPatientTransitions::exposed_transitions(Agent& agent, Infect
 				// In this case isolation is a sign of detection, wich is the
 				// only time when the lag applies for the asymptomatic
 				agent.set_time_recovered_can_vaccinate(time+
-						infection_parameters.at("Post-infection vaccination lag"));
+						infection_parameters.post_infection_vaccination_lag);
 			}
 			states_manager.set_exposed_never_symptomatic_to_removed(agent);
 			// Set up the time to transit back to susceptible
 			agent.set_time_recovered_to_susceptible(time+
-						infection_parameters.at("Post-infection immunity duration"));
+						infection_parameters.post_infection_immunity_duration);
 			agent.set_removed_recovered(true);
 			agent_recovered = 1;
 		} else {
@@ -139,7 +140,7 @@ std::vector<int> HspPatientTransitions::exposed_transitions(Agent& agent, Infect
 			} else {
 				states_manager.set_recovering_symptomatic(agent);			
 				// This may change if treatment is ICU
-				agent.set_recovery_duration(infection_parameters.at("recovery time"));
+				agent.set_recovery_duration(infection_parameters.recovery_time);
 				agent.set_recovery_time(time);		
 			}
 			// Determine testing time and set home isolation - if not yet confirmed and IH
@@ -163,7 +164,7 @@ std::vector<int> HspPatientTransitions::exposed_transitions(Agent& agent, Infect
 // Determine any testing related properties
 void HspPatientTransitions::set_testing_status(Agent& agent, Infection& infection, const double time, 
 										std::vector<Hospital>& hospitals, 
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 	const int n_hospitals = hospitals.size();
@@ -178,7 +179,7 @@ void HspPatientTransitions::set_testing_status(Agent& agent, Infection& infectio
 			// Also - no home isolation until symptoms
 			states_manager.set_exposed_waiting_for_test_in_hospital(agent);
 			// Time to test
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 		}
 	} else if (agent.symptomatic()) {
@@ -188,21 +189,21 @@ void HspPatientTransitions::set_testing_status(Agent& agent, Infection& infectio
 		// Will stay in the hospital
 		agent.set_home_isolated(false);
 		// Testing-related events - will be adjusted based on other time-dependent scenarios
-		agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+		agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 		agent.set_time_of_test(time);
 	}
 }
 
 // Transitions of a symptomatic agent 
-std::vector<int> HspPatientTransitions::symptomatic_transitions(Agent& agent, const double time, 
+InfectedStateChanges HspPatientTransitions::symptomatic_transitions(Agent& agent, const double time, 
 				   	const double dt, Infection& infection,
 					std::vector<Household>& households, std::vector<Hospital>& hospitals,
-					const std::map<std::string, double>& infection_parameters)
+					const InfectionParameters& infection_parameters)
 {
-	std::vector<int> state_changes(5,0);
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 	int tested_pos = 0;
 	// First entry is one if agent recovered, second if agent died
-	std::vector<int> removed = {0,0};
+	RemovalStateChanges removed = {0, 0};
 	removed = check_agent_removal(agent, time, households, hospitals);
 	state_changes.at(0) = removed.at(0);
 	state_changes.at(1) = removed.at(1);
@@ -217,10 +218,10 @@ std::vector<int> HspPatientTransitions::symptomatic_transitions(Agent& agent, co
 		if (agent.removed_recovered()) {
 			// Set up the time to transit back to susceptible
 			agent.set_time_recovered_to_susceptible(time+
-						infection_parameters.at("Post-infection immunity duration"));
+						infection_parameters.post_infection_immunity_duration);
 			// And the time when the agent becomes eligible for vaccination			
 			agent.set_time_recovered_can_vaccinate(time+
-						infection_parameters.at("Post-infection vaccination lag"));
+						infection_parameters.post_infection_vaccination_lag);
 		}
 		return state_changes;
 	}
@@ -254,12 +255,12 @@ std::vector<int> HspPatientTransitions::symptomatic_transitions(Agent& agent, co
 }
 
 // Verify if agent is to be removed at this step
-std::vector<int> HspPatientTransitions::check_agent_removal(Agent& agent, const double time,
+RemovalStateChanges HspPatientTransitions::check_agent_removal(Agent& agent, const double time,
 					std::vector<Household>& households, 
 					std::vector<Hospital>& hospitals)
 {
 	// First entry is one if agent recovered, second if agent died
-	std::vector<int> removed = {0,0};
+	RemovalStateChanges removed = {0, 0};
 	// If dying
 	if (agent.dying() == true){
 		if (agent.get_time_of_death() <= time){
@@ -284,10 +285,10 @@ std::vector<int> HspPatientTransitions::check_agent_removal(Agent& agent, const
 
 // Agent transitions related to testing time
 void HspPatientTransitions::testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters)
+										const InfectionParameters& infection_parameters)
 {
 	// Determine the time agent gets results
-	agent.set_time_until_results(infection_parameters.at("time from test to results"));
+	agent.set_time_until_results(infection_parameters.time_from_test_to_results);
 	agent.set_time_of_results(time);
 	states_manager.set_tested_to_awaiting_results(agent);
 }
@@ -296,11 +297,11 @@ void HspPatientTransitions::testing_transitions(Agent& agent, const double time,
 int HspPatientTransitions::testing_results_transitions(Agent& agent, 
 			const double time, const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// If false negative, remove testing, put back to exposed
 	// No false negative symptomatic
-	double fneg_prob = infection_parameters.at("fraction false negative");
+	double fneg_prob = infection_parameters.fraction_false_negative;
 	int tested_pos = 0;
 	if (infection.false_negative_test_result(fneg_prob) == true
 			&& agent.exposed() == true){
@@ -337,7 +338,7 @@ int HspPatientTransitions::testing_results_transitions(Agent& agent,
 void HspPatientTransitions::select_initial_treatment(Agent& agent, 
 			const double time, const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (infection.agent_hospitalized(agent.get_age(), agent.severe_correction(time)) == true){
 		// Remove agent from all places, then add to the  hospital for treatment
@@ -356,8 +357,8 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
 				// If recovering - set times and transitions
 				states_manager.set_icu_recovering(agent);
 				// Reset the recovery time to > ICU + hospitalization
-				double t_icu = infection_parameters.at("time in ICU");
-				double t_hsp_icu = infection_parameters.at("time in hospital after ICU");
+				double t_icu = infection_parameters.time_in_ICU;
+				double t_hsp_icu = infection_parameters.time_in_hospital_after_ICU;
 				agent.set_time_icu_to_hsp(time + t_icu);
 			   	agent.set_time_hsp_to_ih(time + t_icu + t_hsp_icu);	
 				agent.set_recovery_duration(t_icu + t_hsp_icu);
@@ -368,13 +369,13 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
 			states_manager.set_hospitalized(agent);
 			// If dying, set transition to ICU
 			if (agent.dying() == true){
-				double dt_icu = infection_parameters.at("time before death to ICU");
+				double dt_icu = infection_parameters.time_before_death_to_ICU;
 				double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 				agent.set_time_hsp_to_icu(t_icu);	
 			}else{
 				// If recovering, set transition to home
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -399,7 +400,7 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
 		}
 		// If dying, set transition to ICU
 		if (agent.dying() == true){
-			double dt_icu = infection_parameters.at("time before death to ICU");
+			double dt_icu = infection_parameters.time_before_death_to_ICU;
 			double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 			agent.set_time_ih_to_icu(t_icu);	
 		}else{
@@ -419,7 +420,7 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
 void HspPatientTransitions::treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// ICU - can only transition to hospitalization
 	// if not dying
@@ -478,7 +479,7 @@ void HspPatientTransitions::treatment_transitions(Agent& agent, const double tim
 				households.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
 				// Set transition back
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -16,14 +16,15 @@ int RegularTransitions::susceptible_transitions(Agent& agent, const double time,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, Flu& flu, const Testing& testing)
+				const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, Flu& flu, const Testing& testing,
+				const PlaceIncidence* incidence, const VaccineEffects* vac_effects)
 {
 	double lambda_tot = 0.0;
 	int got_infected = 0;
 	lambda_tot = compute_susceptible_lambda(agent, time, households, schools, workplaces, retirement_homes,
-					carpools, public_transit, leisure_locations);
-	if (infection.infected(lambda_tot, agent.vaccine_effectiveness(time)) == true){
+					carpools, public_transit, leisure_locations, incidence);
+	if (infection.infected(lambda_tot, vaccine_effectiveness(agent, time, vac_effects)) == true){
 		// Remove agent from potential flu population
 		flu.remove_susceptible_agent(agent.get_ID());
 		got_infected = 1;
@@ -47,7 +48,7 @@ double RegularTransitions::compute_susceptible_lambda(const Agent& agent, const
 					const std::vector<Workplace>& workplaces, 
 					const std::vector<RetirementHome>& retirement_homes, 
 					const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit,
-					const std::vector<Leisure>& leisure_locations)			
+					const std::vector<Leisure>& leisure_locations, const PlaceIncidence* incidence)			
 {
 	double lambda_tot = 0.0;
 
@@ -63,6 +64,37 @@ double RegularTransitions::compute_susceptible_lambda(const Agent& agent, const
 		lambda_tot = house.get_infected_contribution();
 		return lambda_tot;
 	}
+	// Household, school, work, and transit
+	if (incidence != nullptr) {
+		lambda_tot = incidence->routine_lambda(agent.get_ID());
+	} else {
+		lambda_tot = compute_routine_lambda(agent, households, schools, workplaces, 
+							retirement_homes, carpools, public_transit);
+	}
+
+	// Leisure
+	if (agent.get_leisure_ID() > 0) {
+		if (agent.get_leisure_location_type() == LeisureType::public_location) {
+			lambda_tot += leisure_locations.at(agent.get_leisure_ID()-1).get_infected_contribution();
+		} else if (agent.get_leisure_location_type() == LeisureType::household) {
+			lambda_tot += households.at(agent.get_leisure_ID()-1).get_infected_contribution();
+		} else {
+			throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
+		}
+	}
+
+	return lambda_tot;
+}
+
+// Household, school, work, and transit part of lambda of susceptible agent 
+double RegularTransitions::compute_routine_lambda(const Agent& agent, 
+					const std::vector<Household>& households, const std::vector<School>& schools,
+					const std::vector<Workplace>& workplaces, 
+					const std::vector<RetirementHome>& retirement_homes, 
+					const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit)
+{
+	double lambda_tot = 0.0;
+	const Household& house = households.at(agent.get_household_ID()-1);
 	if (agent.student() && agent.works() && !agent.works_from_home()){
 		const School& school = schools.at(agent.get_school_ID()-1);
 		if (agent.retirement_home_employee()){
@@ -117,30 +149,19 @@ double RegularTransitions::compute_susceptible_lambda(const Agent& agent, const
 	}	
 
 	// Transit
-	if (agent.get_work_travel_mode() == "carpool") {
+	if (agent.get_travel_mode() == TravelMode::carpool) {
 		lambda_tot += carpools.at(agent.get_carpool_ID()-1).get_infected_contribution();
 	}
-	if (agent.get_work_travel_mode() == "public") {
+	if (agent.get_travel_mode() == TravelMode::public_transit) {
 		lambda_tot += public_transit.at(agent.get_public_transit_ID()-1).get_infected_contribution();
 	}
 
-	// Leisure
-	if (agent.get_leisure_ID() > 0) {
-		if (agent.get_leisure_type() == "public") {
-			lambda_tot += leisure_locations.at(agent.get_leisure_ID()-1).get_infected_contribution();
-		} else if (agent.get_leisure_type() == "household") {
-			lambda_tot += households.at(agent.get_leisure_ID()-1).get_infected_contribution();
-		} else {
-			throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
-		}
-	}
-
 	return lambda_tot;
 }
 
 // Compute and set agent properties related to recovery without symptoms and incubation 
 void RegularTransitions::recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Determine if agent will recover without
 	// becoming symptomatic and update corresponding states
@@ -148,11 +169,11 @@ void RegularTransitions::recovery_and_incubation(Agent& agent, Infection& infect
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_parameters.time_from_exposed_to_infectiousness, latency);
 	if (never_sy){
 		states_manager.set_susceptible_to_exposed_never_symptomatic(agent);
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -166,15 +187,15 @@ void RegularTransitions::recovery_and_incubation(Agent& agent, Infection& infect
 }
 
 // Implement transitions relevant to exposed 
-std::vector<int> RegularTransitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
+InfectedStateChanges RegularTransitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 										std::vector<Household>& households, std::vector<School>& schools,
 										std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters, const Testing& testing)
+										const InfectionParameters& infection_parameters, const Testing& testing)
 {
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-	std::vector<int> state_changes(5,0);
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// First check for testing because that holds for transition changes too
 	// If being tested
@@ -214,12 +235,12 @@ std::vector<int> RegularTransitions::exposed_transitions(Agent& agent, Infection
 				// In this case isolation is a sign of detection, wich is the
 				// only time when the lag applies for the asymptomatic
 				agent.set_time_recovered_can_vaccinate(time+
-						infection_parameters.at("Post-infection vaccination lag"));
+						infection_parameters.post_infection_vaccination_lag);
 			}
 			states_manager.set_exposed_never_symptomatic_to_removed(agent);
 			// Set up the time to transit back to susceptible
 			agent.set_time_recovered_to_susceptible(time+
-						infection_parameters.at("Post-infection immunity duration"));
+						infection_parameters.post_infection_immunity_duration);
 			agent.set_removed_recovered(true);
 			agent_recovered = 1;
 		} else {
@@ -259,7 +280,7 @@ void RegularTransitions::untested_sy_setup(Agent& agent, Infection& infection, c
 										std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 		// Testing status
@@ -310,7 +331,7 @@ void RegularTransitions::untested_sy_setup(Agent& agent, Infection& infection, c
 
 // Determine if the agent is recovering or dying 
 void RegularTransitions::recovery_status(Agent& agent, Infection& infection, const double time,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	int agent_age = agent.get_age();
 	if (infection.will_die_non_icu(agent_age, 											 
@@ -322,14 +343,14 @@ void RegularTransitions::recovery_status(Agent& agent, Infection& infection, con
 		agent.set_death_time(time);
 	} else {
 		states_manager.set_recovering_symptomatic(agent);			
-		agent.set_recovery_duration(infection_parameters.at("recovery time"));
+		agent.set_recovery_duration(infection_parameters.recovery_time);
 		agent.set_recovery_time(time);		
 	}
 }
 
 // Determine if the agent is recovering or dying in ICU 
 void RegularTransitions::recovery_status_ICU(Agent& agent, Infection& infection, const double time,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (infection.will_die_ICU()){
 		states_manager.set_dying_symptomatic(agent);
@@ -337,7 +358,7 @@ void RegularTransitions::recovery_status_ICU(Agent& agent, Infection& infection,
 		agent.set_death_time(time);
 	} else {
 		states_manager.set_recovering_symptomatic(agent);			
-		agent.set_recovery_duration(infection_parameters.at("recovery time"));
+		agent.set_recovery_duration(infection_parameters.recovery_time);
 		agent.set_recovery_time(time);		
 	}
 }
@@ -348,7 +369,7 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
 										std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 	const int n_hospitals = hospitals.size();
@@ -359,7 +380,7 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
  		will_be_tested = infection.will_be_tested(testing.get_exp_tested_prob());
 		if (will_be_tested == true){
 			// Determine type of testing
-			if (infection.tested_in_hospital(infection_parameters.at("fraction tested in hospitals"))){
+			if (infection.tested_in_hospital(infection_parameters.fraction_tested_in_hospitals)){
 				states_manager.set_exposed_waiting_for_test_in_hospital(agent);
 				int hsp_ID = infection.get_random_hospital_ID(n_hospitals);
 				// Registration will happen only upon testing time step
@@ -371,7 +392,7 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
 			remove_from_all_workplaces_and_schools(agent, schools, workplaces, retirement_homes, 
 							carpools, public_transit);
 			// Time to test
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 		}
 	} else if (agent.symptomatic()) {
@@ -380,7 +401,7 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
 			// Set because this is actually checked (currently not for CT though)
 			will_be_tested = true;
 			// If agent is getting tested - determine type and properties of testing
-			if (infection.tested_in_hospital(infection_parameters.at("fraction tested in hospitals"))){
+			if (infection.tested_in_hospital(infection_parameters.fraction_tested_in_hospitals)){
 				states_manager.set_waiting_for_test_in_hospital(agent);
 				int hsp_ID = infection.get_random_hospital_ID(n_hospitals);
 				// Registration will happen only upon testing time step
@@ -390,7 +411,7 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
 			}
 
 			// Testing-related events - will be adjusted based on other time-dependent scenarios
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 	
 			// Home isolation - removal from all public places except hospitals for former
@@ -403,18 +424,18 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
 }
 
 // Transitions of a symptomatic agent 
-std::vector<int> RegularTransitions::symptomatic_transitions(Agent& agent, const double time, 
+InfectedStateChanges RegularTransitions::symptomatic_transitions(Agent& agent, const double time, 
 				   	const double dt, Infection& infection,
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 					std::vector<RetirementHome>& retirement_homes,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-					const std::map<std::string, double>& infection_parameters)
+					const InfectionParameters& infection_parameters)
 {
-	std::vector<int> state_changes(5,0);
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 	int tested_pos = 0;
 	// First entry is one if agent recovered, second if agent died
-	std::vector<int> removed = {0,0};
+	RemovalStateChanges removed = {0, 0};
 	removed = check_agent_removal(agent, time, households, schools, 
 					workplaces, hospitals, retirement_homes,
 					carpools, public_transit);
@@ -431,11 +452,11 @@ std::vector<int> RegularTransitions::symptomatic_transitions(Agent& agent, const
 		if (agent.removed_recovered()) {
 			// Set up the time to transit back to susceptible
 			agent.set_time_recovered_to_susceptible(time+
-						infection_parameters.at("Post-infection immunity duration"));
+						infection_parameters.post_infection_immunity_duration);
 			if (!agent.contact_traced()) {
 				// And the time when the agent becomes eligible for vaccination			
 				agent.set_time_recovered_can_vaccinate(time+
-							infection_parameters.at("Post-infection vaccination lag"));
+							infection_parameters.post_infection_vaccination_lag);
 			}
 		}
 		return state_changes;
@@ -470,14 +491,14 @@ std::vector<int> RegularTransitions::symptomatic_transitions(Agent& agent, const
 }
 
 // Verify if agent is to be removed at this step
-std::vector<int> RegularTransitions::check_agent_removal(Agent& agent, const double time,
+RemovalStateChanges RegularTransitions::check_agent_removal(Agent& agent, const double time,
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 					std::vector<RetirementHome>& retirement_homes,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit)
 {
 	// First entry is one if agent recovered, second if agent died
-	std::vector<int> removed = {0,0};
+	RemovalStateChanges removed = {0, 0};
 	// If dying
 	if (agent.dying() == true) {
 		if (agent.get_time_of_death() <= time) {
@@ -517,10 +538,10 @@ std::vector<int> RegularTransitions::check_agent_removal(Agent& agent, const dou
 
 // Agent transitions related to testing time
 void RegularTransitions::testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters)
+										const InfectionParameters& infection_parameters)
 {
 	// Determine the time agent gets results
-	agent.set_time_until_results(infection_parameters.at("time from test to results"));
+	agent.set_time_until_results(infection_parameters.time_from_test_to_results);
 	agent.set_time_of_results(time);
 	states_manager.set_tested_to_awaiting_results(agent);
 }
@@ -532,11 +553,11 @@ int RegularTransitions::testing_results_transitions(Agent& agent,
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// If false negative, remove testing, put back to exposed
 	// No false negative symptomatic 
-	double fneg_prob = infection_parameters.at("fraction false negative");
+	double fneg_prob = infection_parameters.fraction_false_negative;
 	int tested_pos = 0;
 	if (infection.false_negative_test_result(fneg_prob) == true
 		 && agent.exposed() == true){
@@ -587,7 +608,7 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (infection.agent_hospitalized(agent.get_age(), agent.severe_correction(time)) == true){
 		
@@ -615,8 +636,8 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 				// If recovering - set times and transitions
 				states_manager.set_icu_recovering(agent);
 				// Reset the recovery time to > ICU + hospitalization
-				double t_icu = infection_parameters.at("time in ICU");
-				double t_hsp_icu = infection_parameters.at("time in hospital after ICU");
+				double t_icu = infection_parameters.time_in_ICU;
+				double t_hsp_icu = infection_parameters.time_in_hospital_after_ICU;
 				agent.set_time_icu_to_hsp(time + t_icu);
 			   	agent.set_time_hsp_to_ih(time + t_icu + t_hsp_icu);	
 				agent.set_recovery_duration(t_icu + t_hsp_icu);
@@ -627,13 +648,13 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 			states_manager.set_hospitalized(agent);
 			// If dying, set transition to ICU
 			if (agent.dying() == true){
-				double dt_icu = infection_parameters.at("time before death to ICU");
+				double dt_icu = infection_parameters.time_before_death_to_ICU;
 				double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 				agent.set_time_hsp_to_icu(t_icu);	
 			}else{
 				// If recovering, set transition to home
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -650,7 +671,7 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 		states_manager.set_home_isolation(agent);
 		// If dying, set transition to ICU
 		if (agent.dying() == true){
-			double dt_icu = infection_parameters.at("time before death to ICU");
+			double dt_icu = infection_parameters.time_before_death_to_ICU;
 			double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 			agent.set_time_ih_to_icu(t_icu);	
 		}else{
@@ -676,7 +697,7 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (agent.get_will_be_hospitalized() || agent.get_will_be_hospitalized_ICU()){
 		if (agent.contact_traced()) {
@@ -697,8 +718,8 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 				// If recovering - set times and transitions
 				states_manager.set_icu_recovering(agent);
 				// Reset the recovery time to > ICU + hospitalization
-				double t_icu = infection_parameters.at("time in ICU");
-				double t_hsp_icu = infection_parameters.at("time in hospital after ICU");
+				double t_icu = infection_parameters.time_in_ICU;
+				double t_hsp_icu = infection_parameters.time_in_hospital_after_ICU;
 				agent.set_time_icu_to_hsp(time + t_icu);
 				agent.set_time_hsp_to_ih(time + t_icu + t_hsp_icu);	
 				agent.set_recovery_duration(t_icu + t_hsp_icu);
@@ -709,13 +730,13 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 			states_manager.set_hospitalized(agent);
 			// If dying, set transition to ICU
 			if (agent.dying() == true){
-				double dt_icu = infection_parameters.at("time before death to ICU");
+				double dt_icu = infection_parameters.time_before_death_to_ICU;
 				double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 				agent.set_time_hsp_to_icu(t_icu);	
 			}else{
 				// If recovering, set transition to home
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -732,7 +753,7 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 		states_manager.set_home_isolation(agent);
 		// If dying, set transition to ICU
 		if (agent.dying() == true){
-			double dt_icu = infection_parameters.at("time before death to ICU");
+			double dt_icu = infection_parameters.time_before_death_to_ICU;
 			double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 			agent.set_time_ih_to_icu(t_icu);	
 		}else{
@@ -758,7 +779,7 @@ void RegularTransitions::treatment_transitions(Agent& agent, const double time,
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// ICU - can only transition to hospitalization
 	// if not dying
@@ -828,7 +849,7 @@ void RegularTransitions::treatment_transitions(Agent& agent, const double time,
 				}
 				// Set transition back
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -878,10 +899,10 @@ void RegularTransitions::remove_agent_from_all_places(const Agent& agent,
 		} else {
 			workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
 		}
 	}
@@ -908,10 +929,10 @@ void RegularTransitions::add_to_all_workplaces_and_schools(const Agent& agent,
 		} else {
 			workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
 		}
 	}
@@ -938,10 +959,10 @@ void RegularTransitions::remove_from_all_workplaces_and_schools(const Agent& age
 		} else {
 			workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
 		}
 	}
@@ -975,10 +996,10 @@ void RegularTransitions::add_agent_to_all_places(const Agent& agent,
 		} else {
 			workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
 		}
 	}
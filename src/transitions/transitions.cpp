@@ -15,20 +15,20 @@ void Transitions::new_quarantined(Agent& agent, const double time,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Set a contact traced flag
 	agent.set_contact_traced(true);
-	agent.set_quarantine_duration(time + infection_parameters.at("quarantine duration"));
+	agent.set_quarantine_duration(time + infection_parameters.quarantine_duration);
 	// Set time to end memory of being quarantined
-	agent.set_memory_duration(time + infection_parameters.at("quarantine duration")
-						+ infection_parameters.at("quarantine memory"));	
+	agent.set_memory_duration(time + infection_parameters.quarantine_duration
+						+ infection_parameters.quarantine_memory);	
 	// Set vaccination lag
 	agent.set_suspected_can_vaccinate(false);
 	agent.set_former_suspected(true);
-	agent.set_time_recovered_can_vaccinate(time + infection_parameters.at("quarantine duration")					   
-  						+ infection_parameters.at("quarantine memory")
-						+ infection_parameters.at("Post-infection vaccination lag"));
+	agent.set_time_recovered_can_vaccinate(time + infection_parameters.quarantine_duration					   
+  						+ infection_parameters.quarantine_memory
+						+ infection_parameters.post_infection_vaccination_lag);
 	// Removal from all the public places (except leisure - in the next step anyway)
 	int agent_ID = agent.get_ID();
 	if (agent.student()) {
@@ -45,19 +45,19 @@ void Transitions::new_quarantined(Agent& agent, const double time,
 		} else {
 			workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
 		}
 	}
 	if (agent.hospital_employee()) {
 		hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
 		}
 	}
@@ -86,6 +86,11 @@ bool Transitions::common_transitions(Agent& agent, const double time,
 										std::vector<Transit>& public_transit, 
 										Contact_tracing& contact_tracing)
 {
+	// Nothing due yet 
+	if (agent.get_next_timed_transition() > time) {
+		return false;
+	}
+
 	bool re_vaccinating = false;
 	// Recovered becoming susceptible again
 	if (agent.removed_recovered() && agent.get_time_recovered_to_susceptible() <= time) {
@@ -160,74 +165,75 @@ void Transitions::return_from_quarantine(Agent& agent, std::vector<School>& scho
 		} else {
 			workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
 		}
 	}
 	if (agent.hospital_employee()) {
 		hospitals.at(agent.get_hospital_ID()-1).add_agent(agent_ID);
-		if (agent.get_work_travel_mode() == "carpool") {
+		if (agent.get_travel_mode() == TravelMode::carpool) {
 			carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
 		}
-		if (agent.get_work_travel_mode() == "public") {
+		if (agent.get_travel_mode() == TravelMode::public_transit) {
 			public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
 		}
 	}
 }
 
 // Implement transitions relevant to susceptible
-std::vector<int> Transitions::susceptible_transitions(Agent& agent, const double time, 
+SusceptibleStateChanges Transitions::susceptible_transitions(Agent& agent, const double time, 
 				const double dt, Infection& infection,	
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations, 
-				const std::map<std::string, double>& infection_parameters, 
-				std::vector<Agent>& agents, Flu& flu, const Testing& testing)
+				const InfectionParameters& infection_parameters, 
+				std::vector<Agent>& agents, Flu& flu, const Testing& testing,
+				const PlaceIncidence* incidence, const VaccineEffects* vac_effects)
 {
 	// Ingected, tested, negative, false positive 
-	std::vector<int> state_changes(4,0);
+	SusceptibleStateChanges state_changes = {0, 0, 0, 0};
 	int got_infected = 0;
 	if (agent.symptomatic_non_covid()){
 		// Currently only symptomatic non-COVID can reach all 4 states
 		state_changes = flu_tr.susceptible_transitions(agent, time, infection,
 				households, schools, workplaces, hospitals, retirement_homes,
 			    carpools, public_transit, leisure_locations, 
-				infection_parameters, agents, flu, testing, dt);
+				infection_parameters, agents, flu, testing, dt, incidence, vac_effects);
 	} else if (agent.hospital_employee()){
 		got_infected = hsp_emp_tr.susceptible_transitions(agent, time, infection,
 				households, schools, hospitals,
 			    carpools, public_transit, leisure_locations,
-				infection_parameters, agents, testing);
+				infection_parameters, agents, testing, incidence, vac_effects);
 		state_changes.at(0) = got_infected;
 	} else if (agent.hospital_non_covid_patient()){
 		got_infected = hsp_pt_tr.susceptible_transitions(agent, time, infection,
-				hospitals, infection_parameters, agents, testing);
+				hospitals, infection_parameters, agents, testing, vac_effects);
 		state_changes.at(0) = got_infected;
 	} else {
 		got_infected = regular_tr.susceptible_transitions(agent, time, infection,
 				households, schools, workplaces, hospitals, retirement_homes,
 			    carpools, public_transit, leisure_locations,
-				infection_parameters, agents, flu, testing);
+				infection_parameters, agents, flu, testing, incidence, vac_effects);
 		state_changes.at(0) = got_infected;
 	}
 	return state_changes;	
 }
 
 // Implement transitions relevant to exposed 
-std::vector<int> Transitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
+InfectedStateChanges Transitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 										std::vector<Household>& households, std::vector<School>& schools,
 										std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters, const Testing& testing)
+										const InfectionParameters& infection_parameters, const Testing& testing)
 {
 	// Recovered, dead, tested, tested positive, tested false negative
-	std::vector<int> state_changes(5,0);
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 	if (agent.hospital_employee()){
 		state_changes = hsp_emp_tr.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals,
@@ -244,16 +250,16 @@ std::vector<int> Transitions::exposed_transitions(Agent& agent, Infection& infec
 }
 
 // Transitions of a symptomatic agent 
-std::vector<int> Transitions::symptomatic_transitions(Agent& agent, const double time, 
+InfectedStateChanges Transitions::symptomatic_transitions(Agent& agent, const double time, 
 				   	const double dt, Infection& infection,
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 					std::vector<RetirementHome>& retirement_homes,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-					const std::map<std::string, double>& infection_parameters)
+					const InfectionParameters& infection_parameters)
 {
 	// Recovered, dead, tested, tested positive, false negative
-	std::vector<int> state_changes(5,0);
+	InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 	if (agent.hospital_employee()){
 		// Home isolated upon developing symptoms - no travel to work or leisure
 		// This holds for symptoms of anything flu-like, people will not go to
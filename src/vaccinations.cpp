@@ -1,11 +1,16 @@
 #include "../include/vaccinations.h"
 
+// Names of groups that can be vaccinated
+const std::vector<std::string> Vaccinations::group_names = {"hospital employees", 
+	"school employees", "retirement home employees", "retirement home residents"};
+
 // Load parameters related to vaccinations store in a map
 void Vaccinations::load_vaccination_parameters(const std::string& infile, const std::string& data_dir)
 {
 	// Collect and store the parameters
 	LoadParameters ldparam;
 	vaccination_parameters = ldparam.load_parameter_map<double>(infile);
+	min_vac_age = vaccination_parameters.at("Minimum vaccination age");
 
 	// Loading and storing of time, value pairs for creating the time dependencies
 	// All the one dose types 
@@ -15,6 +20,7 @@ void Vaccinations::load_vaccination_parameters(const std::string& infile, const
 		std::string tag = "one dose - type "+ std::to_string(i);
 		vac_types_properties[tag] = ldparam.load_table(file_name);
 		vac_types_probs["one dose CDF"].push_back(vaccination_parameters.at(tag + " probability vaccinated, CDF"));		
+		one_dose_profiles.push_back(create_subtype_profile(tag, VaccineType::one_dose));
 	}
 	// All the two dose types
 	int num_two_dose = static_cast<int>(vaccination_parameters.at("Number of two dose types"));
@@ -23,6 +29,7 @@ void Vaccinations::load_vaccination_parameters(const std::string& infile, const
 		std::string tag = "two dose - type "+ std::to_string(i);
 		vac_types_properties[tag] = ldparam.load_table(file_name);
 		vac_types_probs["two dose CDF"].push_back(vaccination_parameters.at(tag + " probability vaccinated, CDF"));		
+		two_dose_profiles.push_back(create_subtype_profile(tag, VaccineType::two_doses));
 	}
 }
 
@@ -60,27 +67,10 @@ int Vaccinations::vaccinate_random(std::vector<Agent>& agents, int n_vac,
 							Infection& infection, const double time)
 {
 	// Pick ones that can be vaccinated
-	std::vector<int> can_be_vaccinated = filter_general(agents);
-	if (can_be_vaccinated.empty()) {
-		std::cout << "No more agents eligible for random vaccination" << std::endl;
-		return 0;
-	}
-	// Reduce n_vac if larger than available
-	if (n_vac > can_be_vaccinated.size()) {
-		n_vac = can_be_vaccinated.size();
-		std::cout << "Requested number of agents for random vaccination"
-				  << " larger than currently eligible -- decreasing to " 
-				  << n_vac << std::endl;
-	}
-	// If not processing all avaiblable,
-	// randomly shuffle the indices, then vaccinate first n_vac
-	if (n_vac != can_be_vaccinated.size()) {
-		infection.vector_shuffle(can_be_vaccinated);
-		can_be_vaccinated.resize(n_vac);		
-	}	
+	std::vector<int> can_be_vaccinated = select_random(agents, n_vac, infection);
 	// Vaccinate and set agent properties
 	vaccinate_and_setup(agents, can_be_vaccinated, infection, time);
-	return n_vac;
+	return can_be_vaccinated.size();
 }
 
 // Randomly vaccinates requested number of agents with a negative time offset
@@ -88,27 +78,10 @@ int Vaccinations::vaccinate_random_time_offset(std::vector<Agent>& agents, int n
 							Infection& infection, const double time)
 {
 	// Pick ones that can be vaccinated
-	std::vector<int> can_be_vaccinated = filter_general(agents);
-	if (can_be_vaccinated.empty()) {
-		std::cout << "No more agents eligible for random vaccination" << std::endl;
-		return 0;
-	}
-	// Reduce n_vac if larger than available
-	if (n_vac > can_be_vaccinated.size()) {
-		n_vac = can_be_vaccinated.size();
-		std::cout << "Requested number of agents for random vaccination"
-				  << " larger than currently eligible -- decreasing to " 
-				  << n_vac << std::endl;
-	}
-	// If not processing all avaiblable,
-	// randomly shuffle the indices, then vaccinate first n_vac
-	if (n_vac != can_be_vaccinated.size()) {
-		infection.vector_shuffle(can_be_vaccinated);
-		can_be_vaccinated.resize(n_vac);		
-	}	
+	std::vector<int> can_be_vaccinated = select_random(agents, n_vac, infection);
 	// Vaccinate and set agent properties
 	vaccinate_and_setup_time_offset(agents, can_be_vaccinated, infection, time);
-	return n_vac;
+	return can_be_vaccinated.size();
 }
 
 // Randomly vaccinates requested number of agents
@@ -148,21 +121,90 @@ int Vaccinations::vaccinate_group(std::vector<Agent>& agents, const std::string&
 }
 
 // Returns maximum number of agents currently eligible for vaccination
-int Vaccinations::max_eligible_random(const std::vector<Agent>& agents)
+int Vaccinations::max_eligible_random(const std::vector<Agent>& agents) const
 {
-	std::vector<int> eligible_IDs = filter_general(agents);
-	return eligible_IDs.size();
+	if (tracking_eligible) {
+		return eligible_IDs.size();
+	}
+	return filter_general(agents).size();
 }
 
 // Returns maximum number of agents in a group currently eligible for vaccination
-int Vaccinations::max_eligible_group(const std::vector<Agent>& agents, const std::string& group_name)
+int Vaccinations::max_eligible_group(const std::vector<Agent>& agents, const std::string& group_name) const
+{
+	if (tracking_eligible) {
+		const int ig = group_index(group_name);
+		return ig < 0 ? 0 : eligible_bits.count_common(group_members.at(ig));
+	}
+	return filter_general_and_group(agents, group_name).size();
+}
+
+// Find all the agents eligible for random vaccination and keep track of them
+void Vaccinations::track_eligibility(const std::vector<Agent>& agents)
+{
+	eligible_IDs.reset(agents.size());
+	eligible_bits.reset(agents.size());
+	group_members.assign(group_names.size(), AgentBitmap());
+	for (auto& members : group_members) {
+		members.reset(agents.size());
+	}
+	for (const auto& agent : agents) {
+		set_eligible(agent.get_ID(), check_general(agent));
+		for (int ig = 0; ig < static_cast<int>(group_names.size()); ++ig) {
+			group_members.at(ig).set(agent.get_ID(), check_group(agent, group_names.at(ig)));
+		}
+	}
+	tracking_eligible = true;
+}
+
+// Record current eligibility of an agent, if tracked
+void Vaccinations::update_eligibility(const Agent& agent)
 {
-	std::vector<int> eligible_IDs = filter_general_and_group(agents, group_name);
-	return eligible_IDs.size();
+	if (!tracking_eligible) {
+		return;
+	}
+	set_eligible(agent.get_ID(), check_general(agent));
+}
+
+// Randomly choose agents eligible for vaccination based on criteria valid for all agents
+std::vector<int> Vaccinations::select_random(const std::vector<Agent>& agents, int n_vac, Infection& infection)
+{
+	std::vector<int> can_be_vaccinated;
+	if (!tracking_eligible) {
+		can_be_vaccinated = filter_general(agents);
+	}
+	const int n_eligible = tracking_eligible ? eligible_IDs.size() : can_be_vaccinated.size();
+	if (n_eligible == 0) {
+		std::cout << "No more agents eligible for random vaccination" << std::endl;
+		return {};
+	}
+	// Reduce n_vac if larger than available
+	if (n_vac > n_eligible) {
+		n_vac = n_eligible;
+		std::cout << "Requested number of agents for random vaccination"
+				  << " larger than currently eligible -- decreasing to " 
+				  << n_vac << std::endl;
+	}
+	if (tracking_eligible) {
+		// Chosen agents are removed, last one takes the place
+		std::vector<int> chosen;
+		for (int i = 0; i < n_vac; ++i) {
+			const int aID = eligible_IDs.at(infection.get_int(0, eligible_IDs.size() - 1));
+			set_eligible(aID, false);
+			chosen.push_back(aID);
+		}
+		return chosen;
+	}
+	// Partial Fisher-Yates shuffle, only the first n_vac are needed
+	for (int i = 0; i < n_vac; ++i) {
+		std::swap(can_be_vaccinated.at(i), can_be_vaccinated.at(infection.get_int(i, n_eligible - 1)));
+	}
+	can_be_vaccinated.resize(n_vac);
+	return can_be_vaccinated;
 }
 
 // Select agents eligible for vaccination based on criteria valid for all agents
-std::vector<int> Vaccinations::filter_general(const std::vector<Agent>& agents)
+std::vector<int> Vaccinations::filter_general(const std::vector<Agent>& agents) const
 {
 	std::vector<int> eligible_agents;
 	for (const auto& agent : agents) {
@@ -176,8 +218,13 @@ std::vector<int> Vaccinations::filter_general(const std::vector<Agent>& agents)
 
 // Select agents in a given group eligible for vaccination based on criteria valid for all agents
 std::vector<int> Vaccinations::filter_general_and_group(const std::vector<Agent>& agents, 
-									const std::string& group_name)
+									const std::string& group_name) const
 {
+	// Intersection of tracked group members and eligible agents, in the same order
+	if (tracking_eligible) {
+		const int ig = group_index(group_name);
+		return ig < 0 ? std::vector<int>() : eligible_bits.common_IDs(group_members.at(ig));
+	}
 	std::vector<int> eligible_agents;
 	for (const auto& agent : agents) {
 		// First check if the agent belongs to the target group
@@ -191,8 +238,15 @@ std::vector<int> Vaccinations::filter_general_and_group(const std::vector<Agent>
 	return eligible_agents;
 }
 
+// Index of a group in group_names, -1 if there is no such group
+int Vaccinations::group_index(const std::string& group_name)
+{
+	const auto it = std::find(group_names.begin(), group_names.end(), group_name);
+	return it == group_names.end() ? -1 : it - group_names.begin();
+}
+
 // True if agent meets core criteria for vaccination eligibility
-bool Vaccinations::check_general(const Agent& agent)
+bool Vaccinations::check_general(const Agent& agent) const
 {
 	if (agent.vaccinated() && !agent.needs_next_vaccination()) {
 		return false;
@@ -200,7 +254,7 @@ bool Vaccinations::check_general(const Agent& agent)
 	if (agent.removed_dead()) {
 		return false;
 	} 
-	if (agent.get_age() < vaccination_parameters.at("Minimum vaccination age")) {
+	if (agent.get_age() < min_vac_age) {
 		return false;	
 	}
 	if (agent.tested_covid_positive()) {
@@ -228,7 +282,7 @@ bool Vaccinations::check_general(const Agent& agent)
 }
 
 // True if agent is in the target vaccination group 
-bool Vaccinations::check_group(const Agent& agent, const std::string& vaccine_group_name)
+bool Vaccinations::check_group(const Agent& agent, const std::string& vaccine_group_name) const
 {
 	if (vaccine_group_name == "hospital employees"
 			&& agent.hospital_employee()) {
@@ -254,101 +308,18 @@ void Vaccinations::vaccinate_and_setup(std::vector<Agent>& agents, const std::ve
 		Agent& agent = agents.at(id-1);
 		// Third dose
 		if (agent.vaccinated() && agent.needs_next_vaccination()) {
-			double next_step = vaccination_parameters.at("Third dose max effects time");
-			double max_end = vaccination_parameters.at("Third dose max effects end time");
-			double tot_end = vaccination_parameters.at("Third dose no effects time");
-			std::string vac_type = agent.get_vaccine_type();
-			std::string tag = agent.get_vaccine_subtype();
-			// Construct for each benefit: this step, current value | next step, max value | then as usual
-			// 1) Effectiveness
-			std::vector<std::vector<double>> orig_props = vac_types_properties.at(tag).at("effectiveness");
-			double max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_eff{{0.0, agent.vaccine_effectiveness(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_vaccine_effectiveness(ThreePartFunction(new_eff, time));
-			// 2) Asymptomatic correction
-			orig_props = vac_types_properties.at(tag).at("asymptomatic");
-			max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_asm{{0.0, agent.asymptomatic_correction(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_asymptomatic_correction(ThreePartFunction(new_asm, time));
-			// 3) Transmission correction
-			orig_props = vac_types_properties.at(tag).at("transmission");
-			max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_tr{{0.0, agent.transmission_correction(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_transmission_correction(ThreePartFunction(new_tr, time));	
-			// 4) Severity correction
-			orig_props = vac_types_properties.at(tag).at("severe");
-			max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_sv{{0.0, agent.severe_correction(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_severe_correction(ThreePartFunction(new_sv, time));
-			// 5) Death correction
-			orig_props = vac_types_properties.at(tag).at("death");
-			max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_dth{{0.0, agent.death_correction(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_death_correction(ThreePartFunction(new_dth, time));
-			// Other properties
-			// Record the time when vaccine effects start dropping (assumes all these properties follow the same trend)
-			agent.set_time_vaccine_effects_reduction(time+max_end);
-			// and the time when mobility increases (at peak effectiveness)
-			agent.set_time_mobility_increase(time);
-			// To not keep on vaccinating
-			agent.set_needs_next_vaccination(false);
-			// Correct the type
-			agent.set_vaccine_type("one_dose");
-			agent.set_vaccine_subtype("former " + tag);
+			setup_third_dose(agent, time);
 			continue;
 		}
 
 		// First vaccination ever
 		agent.set_vaccinated(true);
 		agent.set_needs_next_vaccination(false);
-		if ( infection.get_uniform() <= vaccination_parameters.at("Fraction taking one dose vaccine")) {
-			agent.set_vaccine_type("one_dose");
-			// Select the type based on the iterator in the CDF
-			// This assumes all types are loaded sequentially
-			std::vector<double> one_dose_probs = vac_types_probs.at("one dose CDF");
-			double cur_prob = infection.get_uniform();
-			const auto& iter = std::find_if(one_dose_probs.cbegin(), one_dose_probs.cend(), 
-					[&cur_prob](const double x) { return x >= cur_prob; });
-			// Types start with 1
-			std::string tag = "one dose - type "+ std::to_string(std::distance(one_dose_probs.cbegin(), iter) + 1);
-			agent.set_vaccine_subtype(tag);
-			// Now access attributes for the three part functions and set-up agent properties		
-			agent.set_vaccine_effectiveness(ThreePartFunction(vac_types_properties.at(tag).at("effectiveness"), time));
-			agent.set_asymptomatic_correction(ThreePartFunction(vac_types_properties.at(tag).at("asymptomatic"), time));
-			agent.set_transmission_correction(ThreePartFunction(vac_types_properties.at(tag).at("transmission"), time));
-			agent.set_severe_correction(ThreePartFunction(vac_types_properties.at(tag).at("severe"), time));
-			agent.set_death_correction(ThreePartFunction(vac_types_properties.at(tag).at("death"), time));
-			// Record the time when vaccine effects start dropping (assumes all these properties follow the same trend)
-			agent.set_time_vaccine_effects_reduction(time+vac_types_properties.at(tag).at("effectiveness").at(2).at(0));
-			// and the time when mobility increases (at peak effectiveness)
-			agent.set_time_mobility_increase(time+vac_types_properties.at(tag).at("effectiveness").at(1).at(0));
-		} else {
-			agent.set_vaccine_type("two_doses");
-			// Select the type based on the iterator in the CDF
-			// This assumes all types are loaded sequentially
-			std::vector<double> two_dose_probs = vac_types_probs.at("two dose CDF");
-			double cur_prob = infection.get_uniform();
-			const auto& iter = std::find_if(two_dose_probs.cbegin(), two_dose_probs.cend(), 
-					[&cur_prob](const double x) { return x >= cur_prob; });
-			// Types start with 1
-			std::string tag = "two dose - type "+ std::to_string(std::distance(two_dose_probs.cbegin(), iter) + 1);
-			agent.set_vaccine_subtype(tag);
-			// Now access attributes for the four part functions and set-up agent properties		
-			agent.set_vaccine_effectiveness(FourPartFunction(vac_types_properties.at(tag).at("effectiveness"), time));
-			agent.set_asymptomatic_correction(FourPartFunction(vac_types_properties.at(tag).at("asymptomatic"), time));
-			agent.set_transmission_correction(FourPartFunction(vac_types_properties.at(tag).at("transmission"), time));
-			agent.set_severe_correction(FourPartFunction(vac_types_properties.at(tag).at("severe"), time));
-			agent.set_death_correction(FourPartFunction(vac_types_properties.at(tag).at("death"), time));
-			// Record the time when vaccine effects start dropping (assumes all these properties follow the same trend)
-			agent.set_time_vaccine_effects_reduction(time+vac_types_properties.at(tag).at("effectiveness").at(3).at(0));
-			// and the time when mobility increases (at peak effectiveness)
-			agent.set_time_mobility_increase(time+vac_types_properties.at(tag).at("effectiveness").at(2).at(0));
-		}
+		setup_first_vaccination(agent, infection, time);
+	}
+	// Vaccinated agents are no longer eligible
+	for (const auto& id : agent_IDs) {
+		update_eligibility(agents.at(id-1));
 	}
 }
 
@@ -363,52 +334,7 @@ void Vaccinations::vaccinate_and_setup_time_offset(std::vector<Agent>& agents, c
 		Agent& agent = agents.at(id-1);
 		// Third dose
 		if (agent.vaccinated() && agent.needs_next_vaccination()) {
-			double next_step = vaccination_parameters.at("Third dose max effects time");
-			double max_end = vaccination_parameters.at("Third dose max effects end time");
-			double tot_end = vaccination_parameters.at("Third dose no effects time");
-			std::string vac_type = agent.get_vaccine_type();
-			std::string tag = agent.get_vaccine_subtype();
-			// Construct for each benefit: this step, current value | next step, max value | then as usual
-			// 1) Effectiveness
-			std::vector<std::vector<double>> orig_props = vac_types_properties.at(tag).at("effectiveness");
-			double max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_eff{{0.0, agent.vaccine_effectiveness(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_vaccine_effectiveness(ThreePartFunction(new_eff, time));
-			// 2) Asymptomatic correction
-			orig_props = vac_types_properties.at(tag).at("asymptomatic");
-			max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_asm{{0.0, agent.asymptomatic_correction(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_asymptomatic_correction(ThreePartFunction(new_asm, time));
-			// 3) Transmission correction
-			orig_props = vac_types_properties.at(tag).at("transmission");
-			max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_tr{{0.0, agent.transmission_correction(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_transmission_correction(ThreePartFunction(new_tr, time));	
-			// 4) Severity correction
-			orig_props = vac_types_properties.at(tag).at("severe");
-			max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_sv{{0.0, agent.severe_correction(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_severe_correction(ThreePartFunction(new_sv, time));
-			// 5) Death correction
-			orig_props = vac_types_properties.at(tag).at("death");
-			max_benefit = orig_props.at(orig_props.size()-2).at(1);
-			std::vector<std::vector<double>> new_dth{{0.0, agent.death_correction(time)}, 
-												{next_step, max_benefit}, {max_end, max_benefit}, {tot_end, 0.0}};
-			agent.set_death_correction(ThreePartFunction(new_dth, time));
-			// Other properties
-			// Record the time when vaccine effects start dropping (assumes all these properties follow the same trend)
-			agent.set_time_vaccine_effects_reduction(time+max_end);
-			// and the time when mobility increases (at peak effectiveness)
-			agent.set_time_mobility_increase(time);
-			// To not keep on vaccinating
-			agent.set_needs_next_vaccination(false);
-			// Correct the type 
-			agent.set_vaccine_type("one_dose");
-			agent.set_vaccine_subtype("former " + tag);
+			setup_third_dose(agent, time);
 			continue;
 		}
 
@@ -424,48 +350,98 @@ void Vaccinations::vaccinate_and_setup_time_offset(std::vector<Agent>& agents, c
 			offset = -1.0*infection.get_uniform(t0, tf);
 		}
 		agent.set_vac_time_offset(offset);
-		if ( infection.get_uniform() <= vaccination_parameters.at("Fraction taking one dose vaccine")) {
-			agent.set_vaccine_type("one_dose");
-			// Select the type based on the iterator in the CDF
-			// This assumes all types are loaded sequentially
-			std::vector<double> one_dose_probs = vac_types_probs.at("one dose CDF");
-			double cur_prob = infection.get_uniform();
-			const auto& iter = std::find_if(one_dose_probs.cbegin(), one_dose_probs.cend(), 
-					[&cur_prob](const double x) { return x >= cur_prob; });
-			// Types start with 1
-			std::string tag = "one dose - type "+ std::to_string(std::distance(one_dose_probs.cbegin(), iter) + 1);
-			agent.set_vaccine_subtype(tag);
-			// Now access attributes for the three part functions and set-up agent properties		
-			agent.set_vaccine_effectiveness(ThreePartFunction(vac_types_properties.at(tag).at("effectiveness"), offset));
-			agent.set_asymptomatic_correction(ThreePartFunction(vac_types_properties.at(tag).at("asymptomatic"), offset));
-			agent.set_transmission_correction(ThreePartFunction(vac_types_properties.at(tag).at("transmission"), offset));
-			agent.set_severe_correction(ThreePartFunction(vac_types_properties.at(tag).at("severe"), offset));
-			agent.set_death_correction(ThreePartFunction(vac_types_properties.at(tag).at("death"), offset));
-			// Record the time when vaccine effects start dropping (assumes all these properties follow the same trend)
-			agent.set_time_vaccine_effects_reduction(offset+vac_types_properties.at(tag).at("effectiveness").at(2).at(0));
-			// and the time when mobility increases (at peak effectiveness)
-			agent.set_time_mobility_increase(offset+vac_types_properties.at(tag).at("effectiveness").at(1).at(0));
-		} else {
-			agent.set_vaccine_type("two_doses");
-			// Select the type based on the iterator in the CDF
-			// This assumes all types are loaded sequentially
-			std::vector<double> two_dose_probs = vac_types_probs.at("two dose CDF");
-			double cur_prob = infection.get_uniform();
-			const auto& iter = std::find_if(two_dose_probs.cbegin(), two_dose_probs.cend(), 
-					[&cur_prob](const double x) { return x >= cur_prob; });
-			// Types start with 1
-			std::string tag = "two dose - type "+ std::to_string(std::distance(two_dose_probs.cbegin(), iter) + 1);
-			agent.set_vaccine_subtype(tag);
-			// Now access attributes for the four part functions and set-up agent properties		
-			agent.set_vaccine_effectiveness(FourPartFunction(vac_types_properties.at(tag).at("effectiveness"), offset));
-			agent.set_asymptomatic_correction(FourPartFunction(vac_types_properties.at(tag).at("asymptomatic"), offset));
-			agent.set_transmission_correction(FourPartFunction(vac_types_properties.at(tag).at("transmission"), offset));
-			agent.set_severe_correction(FourPartFunction(vac_types_properties.at(tag).at("severe"), offset));
-			agent.set_death_correction(FourPartFunction(vac_types_properties.at(tag).at("death"), offset));
-			// Record the time when vaccine effects start dropping (assumes all these properties follow the same trend)
-			agent.set_time_vaccine_effects_reduction(offset+vac_types_properties.at(tag).at("effectiveness").at(3).at(0));
-			// and the time when mobility increases (at peak effectiveness)
-			agent.set_time_mobility_increase(offset+vac_types_properties.at(tag).at("effectiveness").at(2).at(0));
+		setup_first_vaccination(agent, infection, offset);
+	}
+	// Vaccinated agents are no longer eligible
+	for (const auto& id : agent_IDs) {
+		update_eligibility(agents.at(id-1));
+	}
+}
+
+// Randomly chooses the vaccine and sets the agent's response starting at a given time
+void Vaccinations::setup_first_vaccination(Agent& agent, Infection& infection, const double start)
+{
+	const bool one_dose = infection.get_uniform() <= vaccination_parameters.at("Fraction taking one dose vaccine");
+	agent.set_vaccine_type(one_dose ? VaccineType::one_dose : VaccineType::two_doses);
+	// Select the type based on the iterator in the CDF
+	// This assumes all types are loaded sequentially
+	const std::vector<double>& probs = vac_types_probs.at(one_dose ? "one dose CDF" : "two dose CDF");
+	double cur_prob = infection.get_uniform();
+	const auto& iter = std::find_if(probs.cbegin(), probs.cend(), 
+			[&cur_prob](const double x) { return x >= cur_prob; });
+	const SubtypeProfile& subtype = (one_dose ? one_dose_profiles : two_dose_profiles).at(std::distance(probs.cbegin(), iter));
+	agent.set_vaccine_subtype(subtype.subtype_ID);
+	agent.set_vaccine_profile(subtype.response, start);
+	// Record the time when vaccine effects start dropping (assumes all these properties follow the same trend)
+	agent.set_time_vaccine_effects_reduction(start + subtype.effects_reduction);
+	// and the time when mobility increases (at peak effectiveness)
+	agent.set_time_mobility_increase(start + subtype.mobility_increase);
+}
+
+// Sets the response of an already vaccinated agent to the third dose
+void Vaccinations::setup_third_dose(Agent& agent, const double time)
+{
+	const double next_step = vaccination_parameters.at("Third dose max effects time");
+	const double max_end = vaccination_parameters.at("Third dose max effects end time");
+	const double tot_end = vaccination_parameters.at("Third dose no effects time");
+	const SubtypeProfile& subtype = get_subtype_profile(agent.get_vaccine_subtype_ID());
+	// Current values, before any of them is replaced
+	const std::vector<double> current = {agent.vaccine_effectiveness(time), agent.asymptomatic_correction(time),
+		agent.transmission_correction(time), agent.severe_correction(time), agent.death_correction(time)};
+	// Construct for each benefit: this step, current value | next step, max value | then as usual
+	std::vector<ThreePartFunction> benefits;
+	for (int i = 0; i < static_cast<int>(current.size()); ++i) {
+		const double max_benefit = subtype.max_benefits.at(i);
+		benefits.push_back(ThreePartFunction({{0.0, current.at(i)}, {next_step, max_benefit}, 
+												{max_end, max_benefit}, {tot_end, 0.0}}, time));
+	}
+	agent.set_vaccine_effectiveness(benefits.at(0));
+	agent.set_asymptomatic_correction(benefits.at(1));
+	agent.set_transmission_correction(benefits.at(2));
+	agent.set_severe_correction(benefits.at(3));
+	agent.set_death_correction(benefits.at(4));
+	// Other properties
+	// Record the time when vaccine effects start dropping (assumes all these properties follow the same trend)
+	agent.set_time_vaccine_effects_reduction(time+max_end);
+	// and the time when mobility increases (at peak effectiveness)
+	agent.set_time_mobility_increase(time);
+	// To not keep on vaccinating
+	agent.set_needs_next_vaccination(false);
+	// Correct the type
+	agent.set_vaccine_type(VaccineType::one_dose);
+	agent.set_vaccine_subtype(subtype.former_ID);
+}
+
+// Shared response and timing of a loaded subtype
+Vaccinations::SubtypeProfile Vaccinations::create_subtype_profile(const std::string& tag, const VaccineType type)
+{
+	const std::map<std::string, std::vector<std::vector<double>>>& props = vac_types_properties.at(tag);
+	VaccineProfiles::Benefits benefits;
+	SubtypeProfile subtype;
+	for (const std::string name : {"effectiveness", "asymptomatic", "transmission", "severe", "death"}) {
+		const std::vector<std::vector<double>>& points = props.at(name);
+		benefits.push_back(points);
+		subtype.max_benefits.push_back(points.at(points.size()-2).at(1));
+	}
+	subtype.subtype_ID = subtypes.get_ID(tag);
+	subtype.former_ID = subtypes.get_ID("former " + tag);
+	subtype.response = profiles.get(type, benefits);
+	// Peak starts at the second to last increase point
+	const int i_peak = (type == VaccineType::one_dose) ? 1 : 2;
+	subtype.mobility_increase = benefits.at(0).at(i_peak).at(0);
+	subtype.effects_reduction = benefits.at(0).at(i_peak + 1).at(0);
+	return subtype;
+}
+
+// Shared response and timing of a subtype with given ID
+const Vaccinations::SubtypeProfile& Vaccinations::get_subtype_profile(const int subtype_ID) const
+{
+	for (const auto& profiles : {&one_dose_profiles, &two_dose_profiles}) {
+		for (const auto& subtype : *profiles) {
+			if (subtype.subtype_ID == subtype_ID) {
+				return subtype;
+			}
 		}
 	}
+	throw std::invalid_argument("Vaccine subtype not loaded: " + subtypes.get_name(subtype_ID));
 }
@@ -16,6 +16,7 @@ src_files += ' ' + path + 'data_management_interface.cpp'
 src_files += ' ' + path + 'agent.cpp' 
 src_files += ' ' + path + 'infection.cpp'
 src_files += ' ' + path + 'mobility.cpp'
+src_files += ' ' + path + 'town.cpp'
 src_files += ' ' + path + 'testing.cpp'
 src_files += ' ' + path + 'vaccinations.cpp'
 src_files += ' ' + path + 'contact_tracing.cpp'
@@ -67,7 +68,7 @@ for file_rm in const_files:
 exe_name = 'con_test'
 # Files needed only for this build
 spec_files = 'construction_test.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, '-pthread', '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
 
 # Test 2
@@ -76,7 +77,7 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'con_test_v2'
 # Files needed only for this build
 spec_files = 'sim_set_construction_test.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, '-pthread', '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
 
 # Test 3
@@ -85,7 +86,7 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'trans_inf_test'
 # Files needed only for this build
 spec_files = 'infection_transmission.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, '-pthread', '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
 
 # Test 4
@@ -94,5 +95,14 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'trans_inf_test_v2'
 # Files needed only for this build
 spec_files = 'sim_set_infection_transmission.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, '-pthread', '-o', exe_name, spec_files, tst_files, src_files])
+subprocess.call([compile_com], shell=True)
+
+# Test 5
+# Multiple replicates in a single process 
+# Name of the executable
+exe_name = 'ensemble_test'
+# Files needed only for this build
+spec_files = 'ensemble_test.cpp ' + path + 'ensemble.cpp '
+compile_com = ' '.join([cx, std, opt, '-pthread', '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
@@ -0,0 +1,312 @@
+#include "abm_tests.h"
+#include "../../include/ensemble.h"
+
+/*****************************************************
+ *
+ * Test suite for running multiple replicates
+ * in a single process
+ *
+******************************************************/
+
+// Tests
+bool town_setup_test();
+bool ensemble_output_test();
+bool ensemble_exception_test();
+bool ensemble_seeded_test();
+bool threaded_transitions_test();
+
+// Supporting functions
+bool check_replicate(const ReplicateResults& res, const int tmax, const int inf0);
+
+int main()
+{
+	test_pass(town_setup_test(), "Setup from a shared town");
+	test_pass(ensemble_output_test(), "Ensemble of replicates - output");
+	test_pass(ensemble_exception_test(), "Ensemble of replicates - exception handling");
+	test_pass(ensemble_seeded_test(), "Ensemble of replicates - reproducibility");
+	test_pass(threaded_transitions_test(), "Multi-threaded agent processing");
+}
+
+/// Models set up from one town match the setup from files
+bool town_setup_test()
+{
+	double dt = 0.25;
+	std::string fin("test_data/input_files_all_vac_reopen.txt");
+
+	Town town(fin);
+	ABM abm_file(dt), abm_town_1(dt), abm_town_2(dt);
+	abm_file.set_number_of_threads(2);
+	abm_file.simulation_setup(fin);
+	abm_town_1.simulation_setup_from_town(town);
+	abm_town_2.simulation_setup_from_town(town);
+
+	for (const ABM* abm : {&abm_town_1, &abm_town_2}) {
+		const std::vector<Household>& houses_file = abm_file.get_vector_of_households();
+		const std::vector<Household>& houses = abm->get_vector_of_households();
+		if (houses.size() != houses_file.size()) {
+			std::cerr << "Wrong number of households" << std::endl;
+			return false;
+		}
+		for (int i = 0; i < houses.size(); ++i) {
+			if ((houses.at(i).get_agent_IDs() != houses_file.at(i).get_agent_IDs())
+					|| !float_equality<double>(houses.at(i).get_x(), houses_file.at(i).get_x(), 1e-10)) {
+				std::cerr << "Household " << i+1 << " differs" << std::endl;
+				return false;
+			}
+		}
+		if ((abm->get_vector_of_schools().size() != abm_file.get_vector_of_schools().size())
+			|| (abm->get_vector_of_workplaces().size() != abm_file.get_vector_of_workplaces().size())
+			|| (abm->get_vector_of_hospitals().size() != abm_file.get_vector_of_hospitals().size())
+			|| (abm->get_vector_of_retirement_homes().size() != abm_file.get_vector_of_retirement_homes().size())
+			|| (abm->get_vector_of_carpools().size() != abm_file.get_vector_of_carpools().size())
+			|| (abm->get_vector_of_public_transit().size() != abm_file.get_vector_of_public_transit().size())
+			|| (abm->get_vector_of_leisure_locations().size() != abm_file.get_vector_of_leisure_locations().size())) {
+			std::cerr << "Wrong number of places" << std::endl;
+			return false;
+		}
+		const std::vector<Agent>& agents_file = abm_file.get_vector_of_agents();
+		const std::vector<Agent>& agents = abm->get_vector_of_agents();
+		if (agents.size() != agents_file.size()) {
+			std::cerr << "Wrong number of agents" << std::endl;
+			return false;
+		}
+		for (int i = 0; i < agents.size(); ++i) {
+			if ((agents.at(i).get_age() != agents_file.at(i).get_age()) 
+					|| (agents.at(i).get_household_ID() != agents_file.at(i).get_household_ID())
+					|| (agents.at(i).get_work_ID() != agents_file.at(i).get_work_ID())) {
+				std::cerr << "Agent " << i+1 << " differs" << std::endl;
+				return false;
+			}
+		}
+	}
+
+	// Mobility probabilities computed once
+	const std::vector<std::vector<double>> probs = town.get_mobility().get_public_probabilities();
+	if ((probs.size() != abm_file.get_vector_of_households().size()) 
+			|| (probs.at(0).size() != abm_file.get_vector_of_leisure_locations().size())) {
+		std::cerr << "Wrong dimensions of mobility probabilities" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Runs several replicates on multiple threads and checks the time series
+bool ensemble_output_test()
+{
+	double dt = 0.25;
+	int tmax = 3, inf0 = 1, N_active = 1000;
+	int n_rep = 3, n_threads = 2;
+	std::string fin("test_data/input_files_all_vac_reopen.txt");
+
+	Ensemble ensemble(dt, fin, tmax, inf0);
+	ensemble.set_initial_conditions(N_active);
+	std::vector<ReplicateResults> results = ensemble.run(n_rep, n_threads);
+
+	if (results.size() != n_rep) {
+		std::cerr << "Wrong number of replicates in the output" << std::endl;
+		return false;
+	}
+	for (const auto& res : results) {
+		if (!check_replicate(res, tmax, inf0)) {
+			return false;
+		}
+	}
+
+	// No replicates
+	if (!ensemble.run(0, n_threads).empty()) {
+		std::cerr << "Output should be empty when no replicates are requested" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Verifies that errors in replicates and invalid input are reported
+bool ensemble_exception_test()
+{
+	bool verbose = false;
+	const std::invalid_argument inv_arg("");
+	std::string fin("test_data/input_files_all_vac_reopen.txt");
+
+	// Non-existing input file
+	bool thrown = false;
+	try {
+		Ensemble ensemble(0.25, "test_data/no_such_file.txt", 1);
+	} catch (const std::exception& e) {
+		thrown = true;
+	}
+	if (!thrown) {
+		std::cerr << "Failed to throw when input is missing" << std::endl;
+		return false;
+	}
+
+	// Failure in a replicate (more active cases than agents)
+	Ensemble ensemble(0.25, fin, 1);
+	ensemble.set_initial_conditions(1000000);
+	thrown = false;
+	try {
+		ensemble.run(2, 2);
+	} catch (const std::exception& e) {
+		thrown = true;
+	}
+	if (!thrown) {
+		std::cerr << "Failed to throw when a replicate fails" << std::endl;
+		return false;
+	}
+	// Wrong settings
+	if (!exception_test(verbose, &inv_arg, &Ensemble::run, ensemble, -1, 1)) {
+		std::cerr << "Failed to throw for negative number of replicates" << std::endl;
+		return false;
+	}
+	if (!exception_test(verbose, &inv_arg, &Ensemble::run, ensemble, 1, 0)) {
+		std::cerr << "Failed to throw for zero threads" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Seeded replicates are identical regardless of number of threads
+bool ensemble_seeded_test()
+{
+	double dt = 0.25;
+	int tmax = 4, inf0 = 1, N_active = 1000;
+	std::string fin("test_data/input_files_all_vac_reopen.txt");
+
+	Ensemble ensemble(dt, fin, tmax, inf0, false, 2);
+	ensemble.set_initial_conditions(N_active);
+	ensemble.set_seed(1234);
+	std::vector<ReplicateResults> serial = ensemble.run(2, 1);
+	std::vector<ReplicateResults> parallel = ensemble.run(2, 2);
+
+	for (int i = 0; i < 2; ++i) {
+		if ((serial.at(i).active_count != parallel.at(i).active_count) 
+				|| (serial.at(i).infected_count != parallel.at(i).infected_count)
+				|| (serial.at(i).total_dead != parallel.at(i).total_dead)) {
+			std::cerr << "Replicate " << i << " is not reproducible" << std::endl;
+			return false;
+		}
+	}
+	if (serial.at(0).active_count == serial.at(1).active_count) {
+		std::cerr << "Replicates with different seeds are identical" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Seeded simulation has the same outcome for any number of threads
+bool threaded_transitions_test()
+{
+	bool verbose = false;
+	const std::invalid_argument inv_arg("");
+	double dt = 0.25;
+	int tmax = 8, N_active = 1000;
+	std::uint64_t seed = 42;
+	std::string fin("test_data/input_files_all_vac_reopen.txt");
+
+	Town town(fin);
+	std::vector<ABM> models;
+	for (const int n_threads : {1, 3}) {
+		ABM abm(dt, seed);
+		abm.set_number_of_threads(n_threads);
+		abm.simulation_setup_from_town(town);
+		abm.initialize_vac_and_reopening();
+		abm.initialize_active_cases(N_active);
+		for (int ti = 0; ti <= tmax; ++ti) {
+			abm.transmit_with_vac();
+		}
+		models.push_back(abm);
+	}
+	ABM& serial = models.at(0);
+	ABM& parallel = models.at(1);
+
+	if ((serial.get_num_infected() != parallel.get_num_infected())
+			|| (serial.get_total_infected() != parallel.get_total_infected())
+			|| (serial.get_total_dead() != parallel.get_total_dead())
+			|| (serial.get_total_recovered() != parallel.get_total_recovered())
+			|| (serial.get_total_tested() != parallel.get_total_tested())
+			|| (serial.get_infected_day() != parallel.get_infected_day())) {
+		std::cerr << "Population statistics depend on the number of threads" << std::endl;
+		return false;
+	}
+	const std::vector<Agent>& agents_s = serial.get_vector_of_agents();
+	const std::vector<Agent>& agents_p = parallel.get_vector_of_agents();
+	for (int i = 0; i < agents_s.size(); ++i) {
+		if ((agents_s.at(i).exposed() != agents_p.at(i).exposed()) 
+				|| (agents_s.at(i).symptomatic() != agents_p.at(i).symptomatic())
+				|| (agents_s.at(i).symptomatic_non_covid() != agents_p.at(i).symptomatic_non_covid())
+				|| (agents_s.at(i).home_isolated() != agents_p.at(i).home_isolated())
+				|| (agents_s.at(i).removed() != agents_p.at(i).removed())) {
+			std::cerr << "State of agent " << i+1 << " depends on the number of threads" << std::endl;
+			return false;
+		}
+	}
+	for (int i = 0; i < serial.get_vector_of_workplaces().size(); ++i) {
+		if (serial.get_vector_of_workplaces().at(i).get_agent_IDs() 
+				!= parallel.get_vector_of_workplaces().at(i).get_agent_IDs()) {
+			std::cerr << "Agents in workplace " << i+1 << " depend on the number of threads" << std::endl;
+			return false;
+		}
+	}
+	for (int i = 0; i < serial.get_vector_of_hospitals().size(); ++i) {
+		if (serial.get_vector_of_hospitals().at(i).get_agent_IDs() 
+				!= parallel.get_vector_of_hospitals().at(i).get_agent_IDs()) {
+			std::cerr << "Agents in hospital " << i+1 << " depend on the number of threads" << std::endl;
+			return false;
+		}
+	}
+
+	// Contributions are summed in the same order
+	serial.compute_place_contributions();
+	parallel.compute_place_contributions();
+	for (int i = 0; i < serial.get_vector_of_households().size(); ++i) {
+		const Household& house_s = serial.get_vector_of_households().at(i);
+		const Household& house_p = parallel.get_vector_of_households().at(i);
+		if ((house_s.get_infected_contribution() != house_p.get_infected_contribution())
+				|| (house_s.get_total_infected() != house_p.get_total_infected())) {
+			std::cerr << "Contribution in household " << i+1 << " depends on the number of threads" << std::endl;
+			return false;
+		}
+	}
+	for (int i = 0; i < serial.get_vector_of_hospitals().size(); ++i) {
+		const Hospital& hsp_s = serial.get_vector_of_hospitals().at(i);
+		const Hospital& hsp_p = parallel.get_vector_of_hospitals().at(i);
+		if ((hsp_s.get_infected_contribution() != hsp_p.get_infected_contribution())
+				|| (hsp_s.get_n_tested() != hsp_p.get_n_tested())) {
+			std::cerr << "Contribution in hospital " << i+1 << " depends on the number of threads" << std::endl;
+			return false;
+		}
+	}
+
+	// Wrong settings
+	ABM abm(dt);
+	if (!exception_test(verbose, &inv_arg, &ABM::set_number_of_threads, abm, 0)) {
+		std::cerr << "Failed to throw for zero threads" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Checks sizes and monotonicity of a single replicate
+bool check_replicate(const ReplicateResults& res, const int tmax, const int inf0)
+{
+	if ((res.active_count.size() != tmax+1) || (res.infected_count.size() != tmax+1)
+			|| (res.total_dead.size() != tmax+1)) {
+		std::cerr << "Wrong length of the replicate time series" << std::endl;
+		return false;
+	}
+	for (int ti = 1; ti <= tmax; ++ti) {
+		if ((res.infected_count.at(ti) < res.infected_count.at(ti-1))
+				|| (res.total_dead.at(ti) < res.total_dead.at(ti-1))) {
+			std::cerr << "Cumulative counts should not decrease" << std::endl;
+			return false;
+		}
+		if (res.active_count.at(ti) < 0) {
+			std::cerr << "Negative number of active cases" << std::endl;
+			return false;
+		}
+	}
+	if (res.active_count.at(0) < inf0) {
+		std::cerr << "Initially infected not included in the active cases" << std::endl;
+		return false;
+	}
+	return true;
+}
@@ -126,14 +126,14 @@ bool abm_leisure_dist_test()
 				} else {
 					// Should be properly removed
 					if (L_type0 == "household") {
-						std::vector<int> agent_IDs = households.at(L_ID0-1).get_agent_IDs();
+						std::vector<int> agent_IDs = households.at(L_ID0-1).get_visitor_IDs();
 						if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 										!= agent_IDs.end()) {
 							std::cerr << "Agent still registered in a household as a leisure location" << std::endl;
 							return false;	
 						}
 					} else if (L_type0 == "public") {
-						std::vector<int> agent_IDs = leisure_locations.at(L_ID0-1).get_agent_IDs();
+						std::vector<int> agent_IDs = leisure_locations.at(L_ID0-1).get_visitor_IDs();
 						if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 										!= agent_IDs.end()) {
 							std::cerr << "Agent still registered in the previous leisure location" << std::endl;
@@ -152,14 +152,14 @@ bool abm_leisure_dist_test()
 				// Should be added 
 				if (L_typeF == "household") {
 					++n_lhs;
-					std::vector<int> agent_IDs = households.at(L_IDF-1).get_agent_IDs();
+					std::vector<int> agent_IDs = households.at(L_IDF-1).get_visitor_IDs();
 					if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 									== agent_IDs.end()) {
 						std::cerr << "Agent not registered in a household as a leisure location" << std::endl;
 						return false;
 					}	
 				} else if (L_typeF == "public" && !leisure_locations.at(L_IDF-1).outside_town()) {
-					std::vector<int> agent_IDs = leisure_locations.at(L_IDF-1).get_agent_IDs();
+					std::vector<int> agent_IDs = leisure_locations.at(L_IDF-1).get_visitor_IDs();
 					if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 									== agent_IDs.end()) {
 						std::cerr << "Agent not registered in the leisure location" << std::endl;
@@ -244,7 +244,7 @@ bool abm_events_test()
 	abm.create_agents(fin);
 
 	// Contains event times and properties
-	std::map<std::string, double>& infection_parameters = abm.get_infection_parameters(); 
+	const std::map<std::string, double>& infection_parameters = abm.get_infection_parameters(); 
 	double tol = 1e-3;
 	double time = 0.0;
 	const double leisure_fraction =  infection_parameters.at("leisure - fraction");
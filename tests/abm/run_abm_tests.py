@@ -31,3 +31,7 @@ subprocess.call(['./trans_inf_test'], shell=True)
 # Test suite 3
 ut.msg('ABM interface - infection transmission test - collective simulation setup', CYAN)
 subprocess.call(['./trans_inf_test_v2'], shell=True)
+
+# Test suite 5
+ut.msg('ABM interface - ensemble of replicates', CYAN)
+subprocess.call(['./ensemble_test'], shell=True)
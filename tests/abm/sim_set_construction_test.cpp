@@ -123,7 +123,7 @@ bool wrong_school_type_test()
 	std::string ftest("test_data/schools_wrong_type.txt");
 
 	ABM abm(dt);
-	if (!exception_test(verbose, &invarg, &ABM::simulation_setup, abm, fin, n0)){
+	if (!exception_test(verbose, &invarg, &ABM::simulation_setup, abm, fin, n0, false)){
 		std::cerr << "Wrong school type not recognized as an error" << std::endl;
 		return false;
 	}
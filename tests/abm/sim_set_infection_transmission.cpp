@@ -1,4 +1,5 @@
 #include "abm_tests.h"
+#include "../common/abm_test_setup.h"
 
 /***************************************************** 
  *
@@ -15,12 +16,18 @@ bool abm_vaccination();
 bool abm_vac_reopening();
 bool abm_vac_reopening_seeded();
 bool abm_vac_reopening_seeded_with_vaccinated();
+bool population_counts_test();
+bool incremental_contributions_test();
+bool touched_places_test();
+bool reopening_contributions_test();
 
 // Supporting functions
 bool abm_vaccination_random();
 bool abm_vaccination_group();
 ABM create_abm(const double dt, int i0);
 bool vaccinated_flag_check(const Agent& agent, const int);
+bool check_population_counts(const ABM& abm);
+bool compare_place_contributions(const ABM& abm_1, const ABM& abm_2);
 
 int main()
 {
@@ -30,6 +37,10 @@ int main()
 	test_pass(abm_vaccination(), "Vaccination");
 	test_pass(abm_vac_reopening(), "Reopening and vaccination studies");
 	test_pass(abm_vac_reopening_seeded(), "Initializing with active COVID-19 cases");
+	test_pass(population_counts_test(), "Incrementally counted agent states");
+	test_pass(incremental_contributions_test(), "Incrementally updated place contributions");
+	test_pass(touched_places_test(), "Contributions finalized only in touched places");
+	test_pass(reopening_contributions_test(), "Incremental contributions during reopening");
 	test_pass(abm_vac_reopening_seeded_with_vaccinated(), "Initializing with active and vaccinated cases");
 }
 
@@ -87,14 +98,14 @@ bool abm_leisure_dist_test()
 				} else {
 					// Should be properly removed
 					if (L_type0 == "household") {
-						std::vector<int> agent_IDs = households.at(L_ID0-1).get_agent_IDs();
+						std::vector<int> agent_IDs = households.at(L_ID0-1).get_visitor_IDs();
 						if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 										!= agent_IDs.end()) {
 							std::cerr << "Agent still registered in a household as a leisure location" << std::endl;
 							return false;	
 						}
 					} else if (L_type0 == "public") {
-						std::vector<int> agent_IDs = leisure_locations.at(L_ID0-1).get_agent_IDs();
+						std::vector<int> agent_IDs = leisure_locations.at(L_ID0-1).get_visitor_IDs();
 						if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 										!= agent_IDs.end()) {
 							std::cerr << "Agent still registered in the previous leisure location" << std::endl;
@@ -114,14 +125,14 @@ bool abm_leisure_dist_test()
 				// Should be added 
 				if (L_typeF == "household") {
 					++n_lhs;
-					std::vector<int> agent_IDs = households.at(L_IDF-1).get_agent_IDs();
+					std::vector<int> agent_IDs = households.at(L_IDF-1).get_visitor_IDs();
 					if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 									== agent_IDs.end()) {
 						std::cerr << "Agent not registered in a household as a leisure location" << std::endl;
 						return false;	
 					}
 				} else if (L_typeF == "public" && !leisure_locations.at(L_IDF-1).outside_town()) {
-					std::vector<int> agent_IDs = leisure_locations.at(L_IDF-1).get_agent_IDs();
+					std::vector<int> agent_IDs = leisure_locations.at(L_IDF-1).get_visitor_IDs();
 					if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 									== agent_IDs.end()) {
 						std::cerr << "Agent not registered in the leisure location" << std::endl;
@@ -165,7 +176,7 @@ bool abm_events_test()
 	abm.simulation_setup(fin);
 	
 	// Contains event times and properties
-	std::map<std::string, double>& infection_parameters = abm.get_infection_parameters(); 
+	const std::map<std::string, double>& infection_parameters = abm.get_infection_parameters(); 
 	double tol = 1e-3;
 	double time = 0.0;
 	const double leisure_fraction =  infection_parameters.at("leisure - fraction");
@@ -1288,6 +1299,167 @@ bool abm_vac_reopening_seeded_with_vaccinated()
 	return true;
 }
 
+/// Counts maintained during the simulation match counts over all the agents
+bool population_counts_test()
+{
+	int tmax = 40;
+
+	ABM abm = vac_reopening_test_model(7);
+	abm.set_number_of_threads(2);
+	for (int ti = 0; ti <= tmax; ++ti) {
+		if (!check_population_counts(abm)) {
+			std::cerr << "Counts differ at step " << ti << std::endl;
+			return false;
+		}
+		abm.transmit_with_vac();
+	}
+
+	// Agents modified directly are recounted once marked as such, 
+	// also when changed through the same reference after more steps
+	std::vector<Agent>& agents = abm.vector_of_agents();
+	for (int round = 0; round < 2; ++round) {
+		const int n_infected = abm.get_num_infected();
+		for (auto& agent : agents) {
+			if (!agent.infected() && !agent.removed()) {
+				agent.set_infected(true);
+				agent.set_exposed(true);
+				break;
+			}
+		}
+		abm.agents_modified();
+		if (abm.get_num_infected() != n_infected + 1) {
+			std::cerr << "Directly modified agent not counted" << std::endl;
+			return false;
+		}
+		if (!check_population_counts(abm)) {
+			return false;
+		}
+
+		// Counted with the changes again once the records are rebuilt
+		for (int ti = 0; ti <= 4; ++ti) {
+			abm.transmit_with_vac();
+			if (!check_population_counts(abm)) {
+				std::cerr << "Counts differ after direct changes at step " << ti << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/// Contributions updated with changes match contributions computed from scratch
+bool incremental_contributions_test()
+{
+	int tmax = 40;
+
+	ABM abm = vac_reopening_test_model(11);
+	abm.set_incremental_contributions(true);
+	for (int ti = 0; ti <= tmax; ++ti) {
+		abm.transmit_with_vac();
+	}
+	
+	// Copies rebuild the contributions, either way
+	ABM rebuilt(abm), full(abm);
+	full.set_incremental_contributions(false);
+	abm.compute_place_contributions();
+	rebuilt.compute_place_contributions();
+	full.compute_place_contributions();
+	if (!compare_place_contributions(abm, rebuilt) || !compare_place_contributions(abm, full)) {
+		return false;
+	}
+
+	// Place parameter changes take effect
+	full.reset_contributions();
+	abm.transmit_ideal_testing_vac_reopening();
+	full.transmit_ideal_testing_vac_reopening();
+	abm.compute_place_contributions();
+	full.compute_place_contributions();
+	return compare_place_contributions(abm, full);
+}
+
+/// Contributions in touched places only match contributions in all places
+bool touched_places_test()
+{
+	int tmax = 30;
+
+	ABM abm = vac_reopening_test_model(13);
+	for (int ti = 0; ti <= tmax; ++ti) {
+		abm.transmit_ideal_testing_vac_reopening();
+	}
+
+	// Copies don't know the touched places and process all
+	ABM all_places(abm);
+	abm.compute_place_contributions();
+	all_places.compute_place_contributions();
+	if (!compare_place_contributions(abm, all_places)) {
+		return false;
+	}
+	const std::vector<Leisure> leisure_with_contributions = abm.get_vector_of_leisure_locations();
+	abm.reset_contributions();
+	all_places.reset_contributions();
+	if (!compare_place_contributions(abm, all_places)) {
+		return false;
+	}
+
+	// Places modified through the getters are all processed
+	abm.vector_of_leisure_locations() = leisure_with_contributions;
+	abm.reset_contributions();
+	for (const auto& leisure : abm.get_vector_of_leisure_locations()) {
+		if ((leisure.get_infected_contribution() != 0.0) || (leisure.get_total_infected() != 0)) {
+			std::cerr << "Modified place " << leisure.get_ID() << " not reset" << std::endl;
+			return false;
+		}
+	}
+
+	// Both continue the same
+	for (int ti = 0; ti <= 5; ++ti) {
+		abm.transmit_ideal_testing_vac_reopening();
+		all_places.transmit_ideal_testing_vac_reopening();
+	}
+	abm.compute_place_contributions();
+	all_places.compute_place_contributions();
+	return compare_place_contributions(abm, all_places);
+}
+
+/// Recorded contributions are kept while leisure locations reopen
+bool reopening_contributions_test()
+{
+	int tmax = 20;
+
+	ABM abm = vac_reopening_test_model(17);
+	abm.set_incremental_contributions(true);
+	ABM full(abm);
+	full.set_incremental_contributions(false);
+	// The first step builds the records
+	abm.transmit_ideal_testing_vac_reopening();
+	full.transmit_ideal_testing_vac_reopening();
+	const int n_rebuilds = abm.get_number_of_contribution_rebuilds();
+
+	// Transmission rate of the leisure locations changes during reopening
+	int n_rate_changes = 0;
+	for (int ti = 0; ti <= tmax; ++ti) {
+		const double rate = abm.get_vector_of_leisure_locations().front().get_transmission_rate();
+		abm.transmit_ideal_testing_vac_reopening();
+		full.transmit_ideal_testing_vac_reopening();
+		if (abm.get_vector_of_leisure_locations().front().get_transmission_rate() != rate) {
+			++n_rate_changes;
+		}
+		if (abm.get_number_of_contribution_rebuilds() != n_rebuilds) {
+			std::cerr << "Contributions rebuilt at step " << ti << std::endl;
+			return false;
+		}
+	}
+	if (n_rate_changes == 0) {
+		std::cerr << "Leisure transmission rate did not change" << std::endl;
+		return false;
+	}
+
+	// Same as computed in full with the current rates
+	abm.compute_place_contributions();
+	full.compute_place_contributions();
+	return compare_place_contributions(abm, full);
+}
+
 // Common operations for creating the ABM interface
 ABM create_abm(const double dt, int inf0)
 {
@@ -1306,3 +1478,92 @@ bool vaccinated_flag_check(const Agent& agent, const int min_vac_age)
 	}
 	return true;
 }
+
+/// Compares state counts of a model with counts over all its agents
+bool check_population_counts(const ABM& abm)
+{
+	int n_infected = 0, n_exposed = 0, n_active = 0;
+	std::vector<int> treatments(3, 0);
+	for (const auto& agent : abm.get_vector_of_agents()) {
+		n_infected += agent.infected() ? 1 : 0;
+		n_exposed += agent.exposed() ? 1 : 0;
+		if ((agent.infected() && agent.tested_covid_positive())
+			 || (agent.symptomatic_non_covid() && agent.home_isolated()
+					 && agent.tested_false_positive())) {
+			++n_active;
+		}
+		if (agent.home_isolated()) {
+			++treatments.at(0);
+		} else if (agent.hospitalized()) {
+			++treatments.at(1);
+		} else if (agent.hospitalized_ICU()) {
+			++treatments.at(2);
+		}
+	}
+	if ((abm.get_num_infected() != n_infected) || (abm.get_num_exposed() != n_exposed)
+			|| (abm.get_num_active_cases() != n_active) || (abm.get_treatment_data() != treatments)) {
+		std::cerr << "Counted states differ from the agent states" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// True if place contributions in two models are equal up to round-off
+bool compare_place_contributions(const ABM& abm_1, const ABM& abm_2)
+{
+	const double tol = 1e-10;
+	auto compare = [tol](const Place& place_1, const Place& place_2) {
+		const double lam_1 = place_1.get_infected_contribution();
+		const double lam_2 = place_2.get_infected_contribution();
+		if ((std::abs(lam_1 - lam_2) > tol*std::max(1.0, std::abs(lam_2)))
+				|| (place_1.get_total_infected() != place_2.get_total_infected())) {
+			std::cerr << "Contribution in place " << place_1.get_ID() << " differs: " 
+					  << lam_1 << " " << lam_2 << std::endl;
+			return false;
+		}
+		return true;
+	};
+	for (int i = 0; i < abm_1.get_vector_of_households().size(); ++i) {
+		if (!compare(abm_1.get_vector_of_households().at(i), abm_2.get_vector_of_households().at(i))) {
+			return false;
+		}
+	}
+	for (int i = 0; i < abm_1.get_vector_of_schools().size(); ++i) {
+		if (!compare(abm_1.get_vector_of_schools().at(i), abm_2.get_vector_of_schools().at(i))) {
+			return false;
+		}
+	}
+	for (int i = 0; i < abm_1.get_vector_of_workplaces().size(); ++i) {
+		if (!compare(abm_1.get_vector_of_workplaces().at(i), abm_2.get_vector_of_workplaces().at(i))) {
+			return false;
+		}
+	}
+	for (int i = 0; i < abm_1.get_vector_of_hospitals().size(); ++i) {
+		if (!compare(abm_1.get_vector_of_hospitals().at(i), abm_2.get_vector_of_hospitals().at(i))
+				|| (abm_1.get_vector_of_hospitals().at(i).get_n_tested() 
+						!= abm_2.get_vector_of_hospitals().at(i).get_n_tested())) {
+			return false;
+		}
+	}
+	for (int i = 0; i < abm_1.get_vector_of_retirement_homes().size(); ++i) {
+		if (!compare(abm_1.get_vector_of_retirement_homes().at(i), abm_2.get_vector_of_retirement_homes().at(i))) {
+			return false;
+		}
+	}
+	for (int i = 0; i < abm_1.get_vector_of_carpools().size(); ++i) {
+		if (!compare(abm_1.get_vector_of_carpools().at(i), abm_2.get_vector_of_carpools().at(i))) {
+			return false;
+		}
+	}
+	for (int i = 0; i < abm_1.get_vector_of_public_transit().size(); ++i) {
+		if (!compare(abm_1.get_vector_of_public_transit().at(i), abm_2.get_vector_of_public_transit().at(i))) {
+			return false;
+		}
+	}
+	for (int i = 0; i < abm_1.get_vector_of_leisure_locations().size(); ++i) {
+		if (!compare(abm_1.get_vector_of_leisure_locations().at(i), abm_2.get_vector_of_leisure_locations().at(i))) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -63,7 +63,7 @@ int main()
 		const std::vector<Leisure>& leisure_locations = abm.get_vector_of_leisure_locations();
 		
 		for (auto& loc : leisure_locations) {
-			std::cout << loc.get_ID() << " " << loc.get_agent_IDs().size() << std::endl;
+			std::cout << loc.get_ID() << " " << loc.get_number_of_agents() << std::endl;
 		}
 		
 		for (int i=0; i < agents_0.size(); ++i) {
@@ -82,7 +82,7 @@ int main()
 					if (L_type0 == "household") {
 						;	
 					} else if (L_type0 == "public") {
-						std::vector<int> agent_IDs = leisure_locations.at(L_ID0-1).get_agent_IDs();
+						std::vector<int> agent_IDs = leisure_locations.at(L_ID0-1).get_visitor_IDs();
 						if ((std::find(agent_IDs.begin(), agent_IDs.end(), aID)) 
 										!= agent_IDs.end()) {
 							std::cerr << "Agent still registered in the previous leisure location " << aID << std::endl;
@@ -11,6 +11,11 @@ bool agent_constructor_getters_test();
 bool agent_events_test();
 bool agent_out_test();
 bool agent_time_dependent_properties_test();
+bool agent_attributes_test();
+bool agent_copy_test();
+bool agent_vaccine_profiles_test();
+bool vaccine_effects_test();
+bool agent_timed_transitions_test();
 
 // Supporting functions
 std::vector<std::vector<double>> read_correct(const std::string& fname);
@@ -21,6 +26,11 @@ int main()
 	test_pass(agent_events_test(), "Agent class event scheduling and handling functionality");
 	test_pass(agent_out_test(), "Agent class ostream operator");
 	test_pass(agent_time_dependent_properties_test(), "Agent time dependent properties");
+	test_pass(agent_attributes_test(), "Agent attributes stored as enums");
+	test_pass(agent_copy_test(), "Agent copies");
+	test_pass(agent_vaccine_profiles_test(), "Agent vaccine responses from shared profiles");
+	test_pass(vaccine_effects_test(), "Vaccine effectiveness of all the agents evaluated at once");
+	test_pass(agent_timed_transitions_test(), "Agent time of the next timed transition");
 }
 
 /// Tests Agent class constructor and most of existing getters 
@@ -460,3 +470,341 @@ std::vector<std::vector<double>> read_correct(const std::string& fname)
 
 	return solution;
 }
+
+/// Conversion of the agent attributes between their names and enums
+bool agent_attributes_test()
+{
+	const std::vector<std::string> travel_modes = {"car", "carpool", "public", 
+													"walk", "other", "wfh", "None"};
+	const std::vector<TravelMode> travel_enums = {TravelMode::car, TravelMode::carpool, 
+						TravelMode::public_transit, TravelMode::walk, TravelMode::other, 
+						TravelMode::wfh, TravelMode::none};
+	for (size_t i = 0; i < travel_modes.size(); ++i) {
+		Agent agent(false, true, 35, 0.0, 0.0, 1, false, 0, false, false,
+						false, 1, false, 0, false, travel_modes.at(i), 10.0, 0, 0, false);
+		if (agent.get_travel_mode() != travel_enums.at(i)) {
+			std::cerr << "Wrong travel mode for " << travel_modes.at(i) << std::endl;
+			return false;
+		}
+		if (agent.get_work_travel_mode() != travel_modes.at(i)) {
+			std::cerr << "Wrong travel mode name for " << travel_modes.at(i) << std::endl;
+			return false;
+		}
+	}
+
+	Agent agent(false, true, 35, 0.0, 0.0, 1, false, 0, false, false,
+					false, 1, false, 0, false, "car", 10.0, 0, 0, false);
+
+	// Leisure type, not assigned by default
+	if (agent.get_leisure_location_type() != LeisureType::none || !agent.get_leisure_type().empty()) {
+		std::cerr << "Leisure type should not be assigned" << std::endl;
+		return false;
+	}
+	agent.set_leisure_type(LeisureType::household);
+	if (agent.get_leisure_type() != "household") {
+		std::cerr << "Wrong leisure type name" << std::endl;
+		return false;
+	}
+	agent.set_leisure_type("public");
+	if (agent.get_leisure_location_type() != LeisureType::public_location) {
+		std::cerr << "Wrong leisure type" << std::endl;
+		return false;
+	}
+
+	// Occupation
+	agent.set_occupation("E");
+	if (agent.get_occupation_type() != Occupation::E) {
+		std::cerr << "Wrong occupation type" << std::endl;
+		return false;
+	}
+
+	// Vaccine type and subtype
+	VaccineSubtypes subtypes;
+	if (agent.get_vaccine_type() != "one_dose" 
+			|| subtypes.get_name(agent.get_vaccine_subtype_ID()) != "not set") {
+		std::cerr << "Wrong default vaccine type or subtype" << std::endl;
+		return false;
+	}
+	agent.set_vaccine_type("two_doses");
+	agent.set_vaccine_subtype(subtypes.get_ID("two dose - type 2"));
+	if (agent.get_vaccine_regimen() != VaccineType::two_doses) {
+		std::cerr << "Wrong vaccine type" << std::endl;
+		return false;
+	}
+	// Same ID for the same name
+	const int subtype_ID = agent.get_vaccine_subtype_ID();
+	if (subtype_ID != subtypes.get_ID("two dose - type 2") 
+			|| subtypes.get_ID("one dose - type 1") == subtype_ID
+			|| subtypes.get_name(subtype_ID) != "two dose - type 2") {
+		std::cerr << "Wrong vaccine subtype" << std::endl;
+		return false;
+	}
+
+	// Unknown names
+	const std::invalid_argument invarg("");
+	if (!exception_test(false, &invarg, travel_mode_from_name, "bus")) {
+		std::cerr << "Unknown travel mode should throw" << std::endl;
+		return false;
+	}
+	if (!exception_test(false, &invarg, occupation_from_name, "F")) {
+		std::cerr << "Unknown occupation should throw" << std::endl;
+		return false;
+	}
+	if (!exception_test(false, &invarg, leisure_type_from_name, "outside")) {
+		std::cerr << "Unknown leisure type should throw" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/// Copies of an agent are independent, including the vaccine response
+bool agent_copy_test()
+{
+	const double tol = 1e-5;
+	Agent agent(false, true, 35, 0.0, 0.0, 1, false, 0, false, false,
+					false, 1, false, 0, true, "car", 10.0, 0, 0, false);
+	agent.set_exposed(true);
+	agent.set_vaccine_type("two_doses");
+	const std::vector<std::vector<double>> points = {{0.0, 70.0}, {29.2929, 78.7879},
+													 {49.4949, 90.0001}, {80.8081, 90.0001},
+													 {100.0, 30.0004}};
+	agent.set_vaccine_effectiveness(FourPartFunction(points, 0.0));
+	
+	Agent agent_copy = agent;
+	if (!agent_copy.infected() || !agent_copy.exposed() || agent_copy.symptomatic()) {
+		std::cerr << "Wrong states of the copied agent" << std::endl;
+		return false;
+	}
+	if (!float_equality<double>(agent_copy.vaccine_effectiveness(40.0), 
+								agent.vaccine_effectiveness(40.0), tol)) {
+		std::cerr << "Wrong vaccine effectiveness of the copied agent" << std::endl;
+		return false;
+	}
+
+	// Changes of the copy do not affect the original
+	agent_copy.set_exposed(false);
+	agent_copy.set_symptomatic(true);
+	agent_copy.set_vaccine_effectiveness(FourPartFunction(0.5));
+	if (!agent.exposed() || agent.symptomatic()) {
+		std::cerr << "States of the original agent changed" << std::endl;
+		return false;
+	}
+	if (float_equality<double>(agent.vaccine_effectiveness(40.0), 0.5, tol)
+			|| !float_equality<double>(agent_copy.vaccine_effectiveness(40.0), 0.5, tol)) {
+		std::cerr << "Vaccine effectiveness of the original agent changed" << std::endl;
+		return false;
+	}
+
+	// Default response of an agent never vaccinated
+	Agent not_vaccinated;
+	if (!float_equality<double>(not_vaccinated.vaccine_effectiveness(10.0), 0.0, tol)
+			|| !float_equality<double>(not_vaccinated.death_correction(10.0), 1.0, tol)) {
+		std::cerr << "Wrong default vaccine response" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/// Agents vaccinated at different times share one profile
+bool agent_vaccine_profiles_test()
+{
+	const double tol = 1e-5;
+	const std::vector<std::vector<double>> points = {{0.0, 70.0}, {29.2929, 78.7879},
+													 {49.4949, 90.0001}, {80.8081, 90.0001},
+													 {100.0, 30.0004}};
+	const std::vector<std::vector<double>> constant = {{0.0, 1.0}, {1.0, 1.0}, {2.0, 1.0},
+													 {3.0, 1.0}, {4.0, 1.0}};
+	VaccineProfiles profiles;
+	const VaccineProfiles::Benefits benefits = {points, constant, constant, constant, constant};
+	const std::shared_ptr<const VaccineResponse> profile = profiles.get(VaccineType::two_doses, benefits);
+
+	// Same points are the same profile, different are not
+	if (profiles.get(VaccineType::two_doses, benefits) != profile) {
+		std::cerr << "Same benefits registered as another profile" << std::endl;
+		return false;
+	}
+	const VaccineProfiles::Benefits other = {constant, points, constant, constant, constant};
+	if (profiles.get(VaccineType::two_doses, other) == profile) {
+		std::cerr << "Different benefits registered as the same profile" << std::endl;
+		return false;
+	}
+
+	// Values are the same as of the agent's own response starting at that time
+	Agent agent, own;
+	agent.set_vaccine_type("two_doses");
+	own.set_vaccine_type("two_doses");
+	for (const double start : {0.0, 340.0, -31.0}) {
+		agent.set_vaccine_profile(profile, start);
+		own.set_vaccine_effectiveness(FourPartFunction(points, start));
+		for (double time = start - 10.0; time <= start + 120.0; time += 0.25) {
+			if (!float_equality<double>(agent.vaccine_effectiveness(time), own.vaccine_effectiveness(time), tol)
+					|| !float_equality<double>(agent.death_correction(time), 1.0, tol)) {
+				std::cerr << "Wrong vaccine response from a profile starting at " << start 
+						  << " at time " << time << std::endl;
+				return false;
+			}
+		}
+	}
+
+	// Own response replaces the profile
+	agent.set_vaccine_effectiveness(FourPartFunction(0.5));
+	if (!float_equality<double>(agent.vaccine_effectiveness(40.0), 0.5, tol)
+			|| !float_equality<double>(agent.asymptomatic_correction(40.0), 1.0, tol)) {
+		std::cerr << "Profile not replaced by the agent's own response" << std::endl;
+		return false;
+	}
+
+	// Other benefits of the replaced profile stay the same
+	const double start = 340.0;
+	Agent modified;
+	modified.set_vaccine_type("two_doses");
+	modified.set_vaccine_profile(profiles.get(VaccineType::two_doses, other), start);
+	modified.set_vaccine_effectiveness(FourPartFunction(0.5));
+	own.set_asymptomatic_correction(FourPartFunction(points, start));
+	for (double time = start - 10.0; time <= start + 120.0; time += 0.25) {
+		if ((modified.asymptomatic_correction(time) != own.asymptomatic_correction(time))
+				|| !float_equality<double>(modified.vaccine_effectiveness(time), 0.5, tol)) {
+			std::cerr << "Benefits of the profile changed by setting another one at time " 
+					  << time << std::endl;
+			return false;
+		}
+	}
+
+	// Agents keep their profile after the table is gone
+	Agent kept, reference;
+	kept.set_vaccine_type("two_doses");
+	reference.set_vaccine_type("two_doses");
+	{
+		VaccineProfiles temporary;
+		kept.set_vaccine_profile(temporary.get(VaccineType::two_doses, benefits), 0.0);
+	}
+	reference.set_vaccine_profile(profile, 0.0);
+	if (kept.vaccine_effectiveness(40.0) != reference.vaccine_effectiveness(40.0)) {
+		std::cerr << "Profile not kept by the agent" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/// Effectiveness evaluated for all the agents is the same as of each agent
+bool vaccine_effects_test()
+{
+	const std::vector<std::vector<double>> tpf_points = {{0.0, 50.0}, {49.4949, 74.7475},
+													 {73.7374, 74.7475}, {100.0, 73.0003}};
+	const std::vector<std::vector<double>> fpf_points = {{0.0, 70.0}, {29.2929, 78.7879},
+													 {49.4949, 90.0001}, {80.8081, 90.0001},
+													 {100.0, 30.0004}};
+	const std::vector<std::vector<double>> tpf_constant(4, {0.0, 1.0});
+	const std::vector<std::vector<double>> fpf_constant(5, {0.0, 1.0});
+	VaccineProfiles profiles;
+	const std::shared_ptr<const VaccineResponse> one_dose = profiles.get(VaccineType::one_dose, 
+					{tpf_points, tpf_constant, tpf_constant, tpf_constant, tpf_constant});
+	const std::shared_ptr<const VaccineResponse> two_doses = profiles.get(VaccineType::two_doses, 
+					{fpf_points, fpf_constant, fpf_constant, fpf_constant, fpf_constant});
+
+	// Not vaccinated, vaccinated with either profile, and with own response
+	std::vector<Agent> agents(400);
+	for (int i = 0; i < static_cast<int>(agents.size()); ++i) {
+		Agent& agent = agents.at(i);
+		agent.set_ID(i+1);
+		if (i % 4 == 1) {
+			agent.set_vaccine_type(VaccineType::one_dose);
+			agent.set_vaccine_profile(one_dose, -0.5*i);
+		} else if (i % 4 == 2) {
+			agent.set_vaccine_type(VaccineType::two_doses);
+			agent.set_vaccine_profile(two_doses, 0.25*i);
+		} else if (i % 4 == 3) {
+			agent.set_vaccine_type(VaccineType::one_dose);
+			agent.set_vaccine_effectiveness(ThreePartFunction(tpf_points, 0.1*i));
+		}
+	}
+
+	VaccineEffects effects;
+	for (double time = 0.0; time <= 300.0; time += 0.25) {
+		// Vaccination of a new agent is included once invalidated
+		if (float_equality<double>(time, 150.0, 1e-5)) {
+			agents.at(0).set_vaccine_type(VaccineType::two_doses);
+			agents.at(0).set_vaccine_profile(two_doses, time);
+			effects.invalidate();
+		}
+		effects.update(agents, time);
+		for (const auto& agent : agents) {
+			if (effects.effectiveness(agent.get_ID()) != agent.vaccine_effectiveness(time)
+					|| vaccine_effectiveness(agent, time, &effects) != agent.vaccine_effectiveness(time)) {
+				std::cerr << "Effectiveness of agent " << agent.get_ID() << " at time " << time 
+						  << " is " << effects.effectiveness(agent.get_ID()) << " instead of "
+						  << agent.vaccine_effectiveness(time) << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/// Earliest time of the common timed transitions follows the agent state
+bool agent_timed_transitions_test()
+{
+	const double tol = 1e-5;
+	const double inf = std::numeric_limits<double>::infinity();
+	Agent agent(false, true, 35, 0.0, 0.0, 1, false, 0, false, false,
+					false, 1, false, 0, false, "car", 10.0, 0, 0, false);
+	if (agent.get_next_timed_transition() != inf) {
+		std::cerr << "Nothing should be scheduled for a new agent" << std::endl;
+		return false;
+	}
+
+	// Times without the corresponding states are not scheduled
+	agent.set_time_recovered_to_susceptible(50.0);
+	agent.set_time_recovered_can_vaccinate(40.0);
+	agent.set_time_mobility_increase(20.0);
+	if (agent.get_next_timed_transition() != inf) {
+		std::cerr << "Times should not be scheduled without the states" << std::endl;
+		return false;
+	}
+
+	// Recovered - can vaccinate first, then loses immunity
+	agent.set_removed_recovered(true);
+	if (!float_equality<double>(agent.get_next_timed_transition(), 40.0, tol)) {
+		std::cerr << "Wrong time for a recovered agent" << std::endl;
+		return false;
+	}
+	agent.set_removed_can_vaccinate(true);
+	if (!float_equality<double>(agent.get_next_timed_transition(), 50.0, tol)) {
+		std::cerr << "Wrong time for a recovered agent that can vaccinate" << std::endl;
+		return false;
+	}
+
+	// Vaccinated - mobility increase is the earliest
+	agent.set_time_vaccine_effects_reduction(100.0);
+	agent.set_vaccinated(true);
+	if (!float_equality<double>(agent.get_next_timed_transition(), 20.0, tol)) {
+		std::cerr << "Wrong time for a vaccinated agent" << std::endl;
+		return false;
+	}
+	agent.set_more_active(true);
+	agent.set_removed_recovered(false);
+	if (!float_equality<double>(agent.get_next_timed_transition(), 100.0, tol)) {
+		std::cerr << "Wrong time for a more active vaccinated agent" << std::endl;
+		return false;
+	}
+
+	// Contact traced 
+	agent.set_contact_traced(true);
+	agent.set_quarantine_duration(30.0);
+	agent.set_memory_duration(60.0);
+	if (!float_equality<double>(agent.get_next_timed_transition(), 30.0, tol)) {
+		std::cerr << "Wrong time for a quarantined agent" << std::endl;
+		return false;
+	}
+	agent.set_contact_traced(false);
+	agent.set_needs_next_vaccination(true);
+	if (agent.get_next_timed_transition() != inf) {
+		std::cerr << "Nothing should be scheduled" << std::endl;
+		return false;
+	}
+
+	return true;
+}
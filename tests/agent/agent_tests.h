@@ -3,6 +3,7 @@
 
 #include "../../include/infection.h"
 #include "../../include/agent.h"
+#include "../../include/vaccine_effects.h"
 #include "../../include/utils.h"
 #include "../common/test_utils.h"
 #include "../../include/io_operations/abm_io.h"
@@ -0,0 +1,27 @@
+#ifndef ABM_TEST_SETUP_H
+#define ABM_TEST_SETUP_H
+
+#include "../../include/abm.h"
+
+/***************************************************************
+ * Setup of models for tests that run the simulation
+ **************************************************************/
+
+/**
+ * \brief Model of a vaccination and reopening study seeded with active cases
+ * \details Time step is 0.25 days, there are 1000 initially active cases
+ * @param seed [in] - seed of the random number generators of the model
+ * @param fin [in] - file with names of the input files, paths relative to the test directory
+ * @return Model ready for the simulation
+ */
+inline ABM vac_reopening_test_model(const std::uint64_t seed,
+					const std::string& fin = "test_data/input_files_all_vac_reopen.txt")
+{
+	ABM abm(0.25, seed);
+	abm.simulation_setup(fin);
+	abm.initialize_vac_and_reopening();
+	abm.initialize_active_cases(1000);
+	return abm;
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define CONTRIBUTIONS_TESTS_H
 
 #include <algorithm>
+#include <fstream>
 #include "../../include/abm.h"
 #include "../../include/contributions.h"
 #include "../../include/utils.h"
@@ -10,20 +11,43 @@
 // Supporting functions
 template <typename T>
 bool check_regular_contributions(const std::vector<T>&, const std::vector<Agent>&, const std::string, const std::map<std::string, double>, double time = 0.0);
+std::vector<double> student_absenteeism_corrections(const std::map<std::string, double>&, 
+						const std::string fname = "test_data/schools_test.txt");
 
 /// Verification of agent contributions  
 template <typename T>
 bool check_regular_contributions(const std::vector<T>& locations, const std::vector<Agent>& agents, const std::string place_type, const std::map<std::string, double> infection_parameters, double time)
 
 {
+	// Students absenteeism depends on the school type
+	std::vector<double> psi_students;
+	if (place_type == "school"){
+		psi_students = student_absenteeism_corrections(infection_parameters);
+	}
 	for (const auto& location : locations){
 		double lambda = 0.0;
 		std::vector<int> agentIDs = location.get_agent_IDs();
+		// Leisure visitors contribute too
+		const std::vector<int>& visitorIDs = location.get_visitor_IDs();
+		agentIDs.insert(agentIDs.end(), visitorIDs.begin(), visitorIDs.end());
 		double ntot = static_cast<double>(agentIDs.size());
 		// So if an agent is both a student and works at school i they are not counted twice
-		// (total will still be twice)
+		// (total will still be twice); members are stored in no particular order
+		std::sort(agentIDs.begin(), agentIDs.end());
 		auto last = std::unique(agentIDs.begin(), agentIDs.end());
 		agentIDs.erase(last, agentIDs.end());
+		// Agents tested in a hospital contribute to it even if they were removed 
+		// from it, e.g. quarantined employees
+		if (place_type == "hospital"){
+			const std::vector<int> members(agentIDs);
+			for (const auto& agent : agents){
+				if (agent.tested() && agent.tested_in_hospital() 
+						&& agent.get_hospital_ID() == location.get_ID()
+						&& !std::binary_search(members.begin(), members.end(), agent.get_ID())){
+					agentIDs.push_back(agent.get_ID());
+				}
+			}
+		}
 		if (place_type == "household"){
 			ntot = std::pow(ntot, infection_parameters.at("household scaling parameter"));
 		}
@@ -144,8 +168,7 @@ bool check_regular_contributions(const std::vector<T>& locations, const std::vec
 				double beta_sch = 0.0, psi_sch = 0.0;
 				if (agent.student() && agent.get_school_ID() == location.get_ID()){
 					beta_sch = infection_parameters.at("school transmission rate");
-					// All should be the same for the test
-					psi_sch = infection_parameters.at("primary and middle school absenteeism correction");
+					psi_sch = psi_students.at(location.get_ID()-1);
 					if (agent.exposed()){
 						lambda += rho_k*beta_sch;
 					}else{
@@ -284,4 +307,29 @@ bool check_regular_contributions(const std::vector<T>& locations, const std::vec
 	return true;
 }
 
+/// Absenteeism corrections of students in each school, based on school types in the file
+std::vector<double> student_absenteeism_corrections(const std::map<std::string, double>& infection_parameters, 
+						const std::string fname)
+{
+	std::vector<double> psi_students;
+	std::ifstream schools(fname);
+	int ID = 0;
+	double x = 0.0, y = 0.0;
+	std::string school_type;
+	while (schools >> ID >> x >> y >> school_type){
+		if (school_type == "daycare"){
+			psi_students.push_back(infection_parameters.at("daycare absenteeism correction"));
+		}else if (school_type == "primary" || school_type == "middle"){
+			psi_students.push_back(infection_parameters.at("primary and middle school absenteeism correction"));
+		}else if (school_type == "high"){
+			psi_students.push_back(infection_parameters.at("high school absenteeism correction"));
+		}else if (school_type == "college"){
+			psi_students.push_back(infection_parameters.at("college absenteeism correction"));
+		}else{
+			throw std::runtime_error("Wrong school type in the contributions test: " + school_type);
+		}
+	}
+	return psi_students;
+}
+
 #endif
@@ -10,12 +10,14 @@
 // Tests
 bool flu_generation();
 bool flu_transitions();
+bool flu_removals();
 bool flu_testing();
 
 int main()
 {
 	test_pass(flu_generation(), "Creation of flu agents");
 	test_pass(flu_transitions(), "Transitions of flu agents");
+	test_pass(flu_removals(), "Removal of susceptible and flu agents");
 	test_pass(flu_testing(), "Testing of flu agents");
 }
 
@@ -112,6 +114,59 @@ bool flu_transitions()
 	return true;
 }
 
+/// Removal in any order leaves the same agents as removal from a list
+bool flu_removals()
+{
+	int n_tot = 200;
+	double fr_flu = 0.2;
+
+	Flu flu;
+	flu.set_fraction(fr_flu);
+	for (int i=1; i<=n_tot; ++i){
+		flu.add_susceptible_agent(i);
+	}
+	std::vector<int> flu_agents = flu.generate_flu();
+	std::vector<int> susceptible_agents = flu.get_susceptible_IDs();
+
+	// Includes agents not in the group, these are ignored
+	for (int i=1; i<=n_tot; i+=3){
+		flu.remove_susceptible_agent(i);
+		flu.remove_flu_agent(i+1);
+		susceptible_agents.erase(std::remove(susceptible_agents.begin(), 
+							susceptible_agents.end(), i), susceptible_agents.end());
+		flu_agents.erase(std::remove(flu_agents.begin(), 
+							flu_agents.end(), i+1), flu_agents.end());
+	}
+
+	std::vector<int> susceptible_left = flu.get_susceptible_IDs();
+	std::vector<int> flu_left = flu.get_flu_IDs();
+	for (auto ptr : {&susceptible_agents, &flu_agents, &susceptible_left, &flu_left}){
+		std::sort(ptr->begin(), ptr->end());
+	}
+	if (susceptible_left != susceptible_agents){
+		std::cerr << "Wrong susceptible agents after removal" << std::endl;
+		return false;
+	}
+	if (flu_left != flu_agents){
+		std::cerr << "Wrong agents with flu after removal" << std::endl;
+		return false;
+	}
+
+	// Swapping draws from the remaining susceptible
+	int new_flu = flu.swap_flu_agent(flu_left.at(0));
+	if (!std::binary_search(susceptible_agents.begin(), susceptible_agents.end(), new_flu)){
+		std::cerr << "New agent with flu was not susceptible" << std::endl;
+		return false;
+	}
+	if (flu.get_flu_IDs().size() != flu_left.size() 
+			|| flu.get_susceptible_IDs().size() != susceptible_left.size() - 1){
+		std::cerr << "Wrong number of agents after swapping" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
 /// Verifies if testing practices are correctly implemented
 bool flu_testing()
 {
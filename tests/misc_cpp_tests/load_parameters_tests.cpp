@@ -1,6 +1,8 @@
 #include "../common/test_utils.h"
 #include <string>
+#include <algorithm>
 #include "../../include/io_operations/load_parameters.h"
+#include "../../include/infection_parameters.h"
 
 /*************************************************************** 
  * Suite for testing LoadParameters class 
@@ -12,6 +14,7 @@ bool read_strings_test();
 bool read_age_dependent_distribution_test();
 bool read_tables_test();
 bool read_tables_bad_format_test();
+bool resolve_infection_parameters_test();
 
 // Supporting functions
 bool equal_maps(std::map<std::string, double>&, std::map<std::string, double>&);
@@ -26,6 +29,7 @@ int main()
 	test_pass(read_age_dependent_distribution_test(), "Load age-dependent distributions");
 	test_pass(read_tables_test(), "Load tables from files");
 	test_pass(read_tables_bad_format_test(), "Formatting error in the file with a table");
+	test_pass(resolve_infection_parameters_test(), "Resolving infection parameters for agent processing");
 }
 
 /// Test for loading infection parameters
@@ -95,6 +99,60 @@ bool read_tables_test()
 	return equal_maps(expected, loaded);
 }
 
+/// Test for resolving the infection parameters from a parameter map
+bool resolve_infection_parameters_test()
+{
+	LoadParameters ldp;
+	std::map<std::string, double> params 
+		= ldp.load_parameter_map<double>("../abm/test_data/infection_parameters.txt");
+
+	// Every field is the value from the map
+	const InfectionParameters resolved(params);
+	for (const auto& field : InfectionParameters::fields()) {
+		if (!float_equality<double>(resolved.*field.second, params.at(field.first), 1e-15)) {
+			std::cerr << "Wrong value of parameter " << field.first << std::endl;
+			return false;
+		}
+	}
+	if (!float_equality<double>(resolved.recovery_time, params.at("recovery time"), 1e-15)) {
+		std::cerr << "Wrong value of recovery time" << std::endl;
+		return false;
+	}
+
+	// Missing parameters are all reported at once
+	params.erase("recovery time");
+	params.erase("time in ICU");
+	try {
+		InfectionParameters incomplete(params);
+		std::cerr << "Did not throw for missing parameters" << std::endl;
+		return false;
+	} catch (const std::invalid_argument& e) {
+		const std::string msg(e.what());
+		if ((msg.find("recovery time") == std::string::npos) 
+				|| (msg.find("time in ICU") == std::string::npos)) {
+			std::cerr << "Not all missing parameters reported: " << msg << std::endl;
+			return false;
+		}
+	}
+
+	// Names that no part of the model uses
+	params["leisure - max location"] = 100;
+	params["leisure - max locations"] = 100;
+	const std::vector<std::string> unknown = InfectionParameters::unknown_parameters(params);
+	if (std::find(unknown.begin(), unknown.end(), "leisure - max location") == unknown.end()) {
+		std::cerr << "Misspelled parameter not reported as unknown" << std::endl;
+		return false;
+	}
+	for (const auto& name : unknown) {
+		if (name == "leisure - max locations" || name == "household transmission rate"
+				|| name == "quarantine duration") {
+			std::cerr << "Parameter " << name << " reported as unknown" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
 /// Test for loading tabular data with a bad format (should throw)
 bool read_tables_bad_format_test()
 {
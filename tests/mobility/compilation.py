@@ -37,5 +37,5 @@ data_dir = './test_data/'
 exe_name = 'mb_tests'
 # Files needed only for this build
 spec_files = 'mobility_tests.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, '-pthread', '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
@@ -12,6 +12,9 @@ bool distance_computation_test();
 bool constructing_probabilities_test();
 bool constructing_probabilities_default_test();
 bool assigning_locations_test();
+bool truncated_probabilities_test();
+bool threaded_construction_test();
+bool cache_test();
 
 int main()
 {
@@ -19,6 +22,9 @@ int main()
 	test_pass(constructing_probabilities_test(), "Constructing probabilities");
 	test_pass(constructing_probabilities_default_test(), "Constructing probabilities - default settings");
 	test_pass(assigning_locations_test(), "Assigning locations");
+	test_pass(truncated_probabilities_test(), "Limited number of locations per household");
+	test_pass(threaded_construction_test(), "Constructing probabilities with multiple threads");
+	test_pass(cache_test(), "Cached probability tables");
 }
 
 bool distance_computation_test()
@@ -216,3 +222,266 @@ bool assigning_locations_test()
 	}
 	return true;
 }
+
+bool truncated_probabilities_test()
+{
+	bool verbose = false;
+	const std::invalid_argument inv_arg("");
+	double tol = 1e-5;
+	int n_households = 4, n_leisure = 3, n_max = 2; 
+	double dr0 = 1.5, beta = 0.001, kappa = 400.0;
+	// In lats and lons first n_households refer to households
+	std::vector<double> lats = {80.0280, 14.1886, 42.1761, 91.5736, 79.2207, 95.9492, 65.5741};
+	std::vector<double> lons = {5.3568, 127.3694, 140.0990, 101.8103, 113.6610, 111.4699, 58.8341};
+	// With a single location in the tail, its probability is exact
+	std::vector<std::vector<double>> exp_probs = {{9.3121e-03, 6.0285e-02, 3.7611e-03}, 
+											  {1.2752e-08, 1.4194e-10, 5.6409e-09}, 
+											  {2.2917e-05, 3.8474e-07, 1.2505e-06},
+											  {3.2290e-02, 2.9201e-01, 8.0557e-04}};
+	std::vector<std::vector<double>> pdfs = exp_probs;
+	for (auto& ve : pdfs) {
+		double sum_ve = std::accumulate(ve.begin(), ve.end(), 0.0);
+		std::for_each(ve.begin(), ve.end(), [&sum_ve](double& x) { x /= sum_ve; });
+	}
+	for (auto& ve : exp_probs) {
+		std::partial_sum(ve.begin(), ve.end(), ve.begin());
+		double max_ve = ve.back();
+		std::for_each(ve.begin(), ve.end(), [&max_ve](double& x) { x /= max_ve; });
+	}
+
+	// Construct objects
+	Mobility mobility;
+	mobility.set_probability_parameters(dr0, beta, kappa);
+	mobility.set_max_locations(n_max);
+
+	std::vector<Household> households;
+	std::vector<Leisure> leisure_locations;
+	for (int i=0; i<n_households; ++i) {
+		households.push_back(Household(i+1, lats.at(i), lons.at(i), 0.7, 2.0, 0.5, 0.8));		
+	}
+	int ind  = 0;
+	for (int i=n_households; i<n_households + n_leisure; ++i) {
+		leisure_locations.push_back(Leisure(++ind, lats.at(i), lons.at(i), 0.7, 2.0, "Skadarlija"));		
+	}
+	mobility.construct_public_probabilities(households, leisure_locations);
+
+	for (const auto& house : households) {
+		if (mobility.get_number_of_stored_locations(house.get_ID()) != n_max) {
+			std::cerr << "Wrong number of stored locations" << std::endl;
+			return false;
+		}
+	}
+	if (!is_equal_floats<double>(mobility.get_public_probabilities(), exp_probs, tol)) {
+		std::cerr << "Computed probabilities not equal expected" << std::endl;
+		return false;
+	}
+
+	// Sampling frequencies
+	Infection infection;
+	int max_iter = 1000000;
+	bool is_public = false, is_household = false;
+	for (int ih=0; ih<n_households; ++ih) {
+		std::vector<double> freq(n_leisure, 0.0);
+		int n_public = 0;
+		for (int i=0; i<max_iter; ++i) {
+			int picked_ID = mobility.assign_leisure_location(infection, ih+1, is_household, is_public);	
+			if (is_public) {
+				freq.at(picked_ID-1) += 1.0;
+				++n_public;
+			}
+		}
+		for (int j=0; j<n_leisure; ++j) {
+			if (!float_equality<double>(freq.at(j)/n_public, pdfs.at(ih).at(j), 0.01)) {
+				std::cerr << "Wrong frequency of visits to location " << j+1 
+						  << " from household " << ih+1 << std::endl;
+				return false;
+			}
+		}
+	}
+
+	// Invalid input
+	if (!exception_test(verbose, &inv_arg, &Mobility::set_max_locations, mobility, -1)) {
+		std::cerr << "Failed to throw for negative number of locations" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool threaded_construction_test()
+{
+	bool verbose = false;
+	const std::invalid_argument inv_arg("");
+	int n_households = 50, n_leisure = 30;
+	double dr0 = 1.5, beta = 1.75, kappa = 400.0;
+
+	// Locations scattered around a town
+	Infection infection;
+	std::vector<Household> households;
+	std::vector<Leisure> leisure_locations;
+	for (int i=0; i<n_households; ++i) {
+		households.push_back(Household(i+1, 40.9 + 0.1*infection.get_uniform(), 
+							-73.8 + 0.1*infection.get_uniform(), 0.7, 2.0, 0.5, 0.8));		
+	}
+	for (int i=0; i<n_leisure; ++i) {
+		leisure_locations.push_back(Leisure(i+1, 40.9 + 0.1*infection.get_uniform(), 
+							-73.8 + 0.1*infection.get_uniform(), 0.7, 2.0, "Kalemegdan"));		
+	}
+
+	// Same as the pairwise distance and probability computation
+	Mobility mobility;
+	mobility.set_probability_parameters(dr0, beta, kappa);
+	mobility.construct_public_probabilities(households, leisure_locations);
+	std::vector<std::vector<double>> exp_table;
+	for (int ih=0; ih<n_households; ++ih) {
+		std::vector<double> exp_probs;
+		for (const auto& leisure : leisure_locations) {
+			const double dist = mobility.compute_distance(households.at(ih), leisure);
+			exp_probs.push_back(std::pow((dist + dr0), -beta)*std::exp(-dist/kappa));
+		}
+		std::partial_sum(exp_probs.begin(), exp_probs.end(), exp_probs.begin());
+		const double max_p = exp_probs.back();
+		std::for_each(exp_probs.begin(), exp_probs.end(), [&max_p](double& x) { x /= max_p; });
+		exp_table.push_back(exp_probs);
+	}
+	if (!is_equal_floats<double>(mobility.get_public_probabilities(), exp_table, 1e-12)) {
+		std::cerr << "Probabilities not equal expected" << std::endl;
+		return false;
+	}
+
+	// Identical for any number of threads, also with limited locations
+	for (const int n_max : {0, 10}) {
+		mobility.set_max_locations(n_max);
+		mobility.set_number_of_threads(1);
+		mobility.construct_public_probabilities(households, leisure_locations);
+		const std::vector<std::vector<double>> serial = mobility.get_public_probabilities();
+		for (const int n_threads : {2, 3, 100}) {
+			mobility.set_number_of_threads(n_threads);
+			mobility.construct_public_probabilities(households, leisure_locations);
+			if (mobility.get_public_probabilities() != serial) {
+				std::cerr << "Probabilities depend on the number of threads" << std::endl;
+				return false;
+			}
+		}
+	}
+
+	// Invalid input
+	if (!exception_test(verbose, &inv_arg, &Mobility::set_number_of_threads, mobility, 0)) {
+		std::cerr << "Failed to throw for zero threads" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool cache_test()
+{
+	int n_households = 40, n_leisure = 25, n_draws = 1000;
+	double dr0 = 1.5, beta = 1.75, kappa = 400.0;
+	const std::string cache_dir("./");
+
+	Infection infection;
+	std::vector<Household> households;
+	std::vector<Leisure> leisure_locations;
+	for (int i=0; i<n_households; ++i) {
+		households.push_back(Household(i+1, 40.9 + 0.1*infection.get_uniform(), 
+							-73.8 + 0.1*infection.get_uniform(), 0.7, 2.0, 0.5, 0.8));		
+	}
+	for (int i=0; i<n_leisure; ++i) {
+		leisure_locations.push_back(Leisure(i+1, 40.9 + 0.1*infection.get_uniform(), 
+							-73.8 + 0.1*infection.get_uniform(), 0.7, 2.0, "Ada Ciganlija"));		
+	}
+
+	// Same assignments from a computed and a loaded table
+	auto same_assignments = [&](Mobility& mob1, Mobility& mob2) {
+		Infection inf1(1.0, 2021), inf2(1.0, 2021);
+		bool is_house = false, is_public = false;
+		for (int i=0; i<n_draws; ++i) {
+			const int house_ID = i%n_households + 1;
+			if (mob1.assign_leisure_location(inf1, house_ID, is_house, is_public, 0.0)
+					!= mob2.assign_leisure_location(inf2, house_ID, is_house, is_public, 0.0)) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	for (const int n_max : {0, 5}) {
+		Mobility computed;
+		computed.set_probability_parameters(dr0, beta, kappa);
+		computed.set_max_locations(n_max);
+		computed.set_cache_directory(cache_dir);
+		const std::string fname = computed.get_cache_file_name(households, leisure_locations);
+		std::remove(fname.c_str());
+
+		// First run saves the table
+		computed.construct_public_probabilities(households, leisure_locations);
+		if (computed.loaded_from_cache() || !std::ifstream(fname)) {
+			std::cerr << "Table not computed and saved on first use" << std::endl;
+			return false;
+		}
+
+		// Second one maps it, copies share it
+		Mobility copied;
+		{
+			Mobility loaded(computed);
+			loaded.construct_public_probabilities(households, leisure_locations);
+			if (!loaded.loaded_from_cache()) {
+				std::cerr << "Table not loaded from cache" << std::endl;
+				return false;
+			}
+			copied = loaded;
+		}
+		if (copied.get_public_probabilities() != computed.get_public_probabilities()) {
+			std::cerr << "Loaded probabilities not equal computed" << std::endl;
+			return false;
+		}
+		if (!same_assignments(computed, copied)) {
+			std::cerr << "Assignments from loaded table not equal computed" << std::endl;
+			return false;
+		}
+
+		// Different parameters - different file
+		Mobility other(computed);
+		other.set_probability_parameters(dr0, beta, 2.0*kappa);
+		if (other.get_cache_file_name(households, leisure_locations) == fname) {
+			std::cerr << "Cache file does not depend on parameters" << std::endl;
+			return false;
+		}
+
+		// Damaged file is recomputed and replaced
+		std::ofstream(fname, std::ios::binary) << "ABMMOB01 incomplete";
+		Mobility recomputed(computed);
+		recomputed.construct_public_probabilities(households, leisure_locations);
+		if (recomputed.loaded_from_cache() 
+				|| recomputed.get_public_probabilities() != computed.get_public_probabilities()) {
+			std::cerr << "Damaged cache file not recomputed" << std::endl;
+			return false;
+		}
+		recomputed.construct_public_probabilities(households, leisure_locations);
+		if (!recomputed.loaded_from_cache()) {
+			std::cerr << "Damaged cache file not replaced" << std::endl;
+			return false;
+		}
+		std::remove(fname.c_str());
+	}
+
+	// Cache in a directory that does not exist - computed without caching
+	Mobility mobility;
+	mobility.set_probability_parameters(dr0, beta, kappa);
+	mobility.set_cache_directory("./no_such_directory/");
+	mobility.construct_public_probabilities(households, leisure_locations);
+	Mobility not_cached;
+	not_cached.set_probability_parameters(dr0, beta, kappa);
+	not_cached.construct_public_probabilities(households, leisure_locations);
+	if (mobility.loaded_from_cache() 
+			|| mobility.get_public_probabilities() != not_cached.get_public_probabilities()) {
+		std::cerr << "Table not computed for a missing cache directory" << std::endl;
+		return false;
+	}
+
+	// No directory - no cache file
+	if (!not_cached.get_cache_file_name(households, leisure_locations).empty()) {
+		std::cerr << "Cache file name without a cache directory" << std::endl;
+		return false;
+	}
+	return true;
+}
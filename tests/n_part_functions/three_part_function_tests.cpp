@@ -12,6 +12,7 @@
 bool check_the_values();
 bool past_the_limit();
 bool one_value();
+bool batch_values();
 
 // Supporting functions
 std::vector<std::vector<double>> read_correct(const std::string& fname);
@@ -23,6 +24,7 @@ int main()
 	test_pass(check_the_values(), "Correct solutions - with and without the offset");
 	test_pass(past_the_limit(), "Correct behavior after reaching y = 0");
 	test_pass(one_value(), "Returning a constant value at all times");
+	test_pass(batch_values(), "Copies with different offsets evaluated at once");
 }
 
 bool check_the_values()
@@ -159,6 +161,43 @@ bool one_value()
 	return true;
 }
 
+/// Values of copies evaluated at once are exactly the values of each copy
+bool batch_values()
+{
+	const std::vector<std::vector<double>> points = {{0.0, 50.0}, {49.4949, 74.7475},
+													 {73.7374, 74.7475}, {100.0, 73.0003}};
+	std::vector<double> starts;
+	for (double start = -200.0; start <= 400.0; start += 0.75) {
+		starts.push_back(start);
+	}
+	ThreePartFunction tpf(points, 0.0);
+	std::vector<double> values;
+	for (double time = -250.0; time <= 600.0; time += 0.25) {
+		tpf.evaluate(starts, time, values);
+		if (values.size() != starts.size()) {
+			std::cerr << "Wrong number of computed values" << std::endl;
+			return false;
+		}
+		for (int i = 0; i < static_cast<int>(starts.size()); ++i) {
+			// Same as the copy started with an offset
+			ThreePartFunction copy(points, starts.at(i));
+			if (values.at(i) != tpf(time - starts.at(i))) {
+				std::cerr << "Computed function value " << values.at(i)
+						  << " not matching " << tpf(time - starts.at(i))
+						  << " at " << time - starts.at(i) << std::endl;
+				return false;
+			}
+			if (std::abs(values.at(i) - copy(time)) > 1e-5) {
+				std::cerr << "Computed function value " << values.at(i)
+						  << " not matching the copy value " << copy(time)
+						  << " at " << time << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 /// Load the correct solution from fname
 std::vector<std::vector<double>> read_correct(const std::string& fname)
 {
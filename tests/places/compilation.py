@@ -36,4 +36,20 @@ spec_files = 'places_test.cpp '
 compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
 
-
+# Test 2
+# Routine places of agents in a simulation 
+# Name of the executable
+exe_name = 'inc_test'
+# Source files of the whole model
+abm_files = ' '.join(path + x for x in ['abm.cpp', 'data_management_interface.cpp', 'agent.cpp', 
+				'infection.cpp', 'mobility.cpp', 'town.cpp', 'testing.cpp', 'vaccinations.cpp', 
+				'contact_tracing.cpp', 'contributions.cpp', 'transitions/transitions.cpp', 
+				'transitions/regular_transitions.cpp', 'transitions/hsp_employee_transitions.cpp', 
+				'transitions/hsp_patient_transitions.cpp', 'transitions/flu_transitions.cpp', 
+				'states_manager/states_manager.cpp', 'states_manager/regular_states_manager.cpp', 
+				'states_manager/hsp_employee_states_manager.cpp', 'flu.cpp', 
+				'three_part_function.cpp', 'four_part_function.cpp', 'io_operations/load_parameters.cpp'])
+# Files needed only for this build
+spec_files = 'place_incidence_tests.cpp '
+compile_com = ' '.join([cx, std, opt, '-pthread', '-o', exe_name, spec_files, tst_files, src_files, abm_files])
+subprocess.call([compile_com], shell=True)
@@ -0,0 +1,81 @@
+#include "../../include/abm.h"
+#include "../common/test_utils.h"
+#include "../common/abm_test_setup.h"
+
+/*****************************************************
+ *
+ * Test suite for routine places of agents stored
+ * 	 in a sparse matrix
+ *
+ *****************************************************/
+
+// Tests
+bool place_incidence_test();
+
+// Supporting functions
+bool compare_agent_states(const ABM& abm_1, const ABM& abm_2);
+
+int main()
+{
+	test_pass(place_incidence_test(), "Routine places of agents in a sparse matrix");
+}
+
+/// Simulation with routine places from the matrix is the same as with places looked up
+bool place_incidence_test()
+{
+	int tmax = 20;
+
+	ABM abm = vac_reopening_test_model(5);
+	ABM looked_up = vac_reopening_test_model(5);
+	looked_up.set_place_incidence(false);
+
+	const std::vector<Agent>& agents = abm.get_vector_of_agents();
+	PlaceIncidence incidence;
+	incidence.build(agents, abm.get_vector_of_households(), abm.get_vector_of_retirement_homes(),
+					abm.get_vector_of_schools(), abm.get_vector_of_workplaces(),
+					abm.get_vector_of_hospitals(), abm.get_vector_of_carpools(),
+					abm.get_vector_of_public_transit(), abm.get_vector_of_leisure_locations());
+	if (incidence.get_number_of_agents() != agents.size()) {
+		std::cerr << "Wrong number of rows in the incidence matrix" << std::endl;
+		return false;
+	}
+
+	for (int ti = 0; ti <= tmax; ++ti) {
+		abm.transmit_with_vac();
+		looked_up.transmit_with_vac();
+		if (!compare_agent_states(abm, looked_up)) {
+			std::cerr << "Simulations differ at step " << ti << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/// True if all the agents in two models are in the same states
+bool compare_agent_states(const ABM& abm_1, const ABM& abm_2)
+{
+	const std::vector<Agent>& agents_1 = abm_1.get_vector_of_agents();
+	const std::vector<Agent>& agents_2 = abm_2.get_vector_of_agents();
+	if ((abm_1.get_num_infected() != abm_2.get_num_infected())
+			|| (abm_1.get_total_infected() != abm_2.get_total_infected())
+			|| (abm_1.get_total_dead() != abm_2.get_total_dead())) {
+		std::cerr << "Numbers of infected or dead differ" << std::endl;
+		return false;
+	}
+	for (int i = 0; i < agents_1.size(); ++i) {
+		const Agent& agent_1 = agents_1.at(i);
+		const Agent& agent_2 = agents_2.at(i);
+		if ((agent_1.infected() != agent_2.infected()) || (agent_1.exposed() != agent_2.exposed())
+				|| (agent_1.symptomatic() != agent_2.symptomatic())
+				|| (agent_1.removed_dead() != agent_2.removed_dead())
+				|| (agent_1.removed_recovered() != agent_2.removed_recovered())
+				|| (agent_1.tested() != agent_2.tested())
+				|| (agent_1.home_isolated() != agent_2.home_isolated())
+				|| (agent_1.hospitalized() != agent_2.hospitalized())
+				|| (agent_1.vaccinated() != agent_2.vaccinated())) {
+			std::cerr << "States of agent " << agent_1.get_ID() << " differ" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
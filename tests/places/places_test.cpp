@@ -9,6 +9,9 @@
 
 // Tests
 bool place_test();
+bool agent_removal_test();
+bool large_place_removal_test();
+bool visitor_test();
 bool school_test();
 bool retirement_home_test();
 bool workplace_test();
@@ -41,6 +44,9 @@ bool household_contribution_test(Household&, double, int, int, int, double);
 int main()
 {
 	test_pass(place_test(), "Place class functionality");
+	test_pass(agent_removal_test(), "Removal of agents from places");
+	test_pass(large_place_removal_test(), "Removal of agents from a large place");
+	test_pass(visitor_test(), "Visitors of places");
 	test_pass(contribution_test_general_place(), "Contribution test for places");
 
 	test_pass(school_test(), "School class functionality");
@@ -101,6 +107,163 @@ bool place_test()
 	return true;
 }
 
+/// Removal in any order leaves the same agents as removal from a list
+bool agent_removal_test()
+{
+	Place place(1, 0.0, 0.0, 1.0, 0.1);
+	std::vector<int> expected;
+	for (int aID = 1; aID <= 50; ++aID) {
+		place.add_agent(aID);
+		expected.push_back(aID);
+	}
+	// Agent in the place twice, e.g. a student that works there
+	place.add_agent(7);
+	expected.push_back(7);
+	std::sort(expected.begin(), expected.end());
+
+	for (const int aID : {50, 1, 7, 23, 24, 2, 49, 7, 100}) {
+		place.remove_agent(aID);
+		expected.erase(std::remove(expected.begin(), expected.end(), aID), expected.end());
+		std::vector<int> reg_agents = place.get_agent_IDs();
+		if (place.get_number_of_agents() != expected.size()) {
+			std::cerr << "Wrong number of agents after removing " << aID << std::endl;
+			return false;
+		}
+		std::sort(reg_agents.begin(), reg_agents.end());
+		if (reg_agents != expected) {
+			std::cerr << "Wrong agents after removing " << aID << std::endl;
+			return false;
+		}
+	}
+
+	// Removed agents can be added back
+	place.add_agent(1);
+	place.remove_agent(3);
+	place.remove_agent(1);
+	expected.erase(std::remove(expected.begin(), expected.end(), 3), expected.end());
+	std::vector<int> reg_agents = place.get_agent_IDs();
+	std::sort(reg_agents.begin(), reg_agents.end());
+	if (reg_agents != expected) {
+		std::cerr << "Wrong agents after adding a removed agent back" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Place that checks its stored positions of agents
+class IndexedPlace : public Place {
+public:
+	IndexedPlace() : Place(1, 0.0, 0.0, 1.0, 0.1) { }
+
+	/// True if positions are stored
+	bool indexed() const { return !agent_slots.empty(); }
+
+	/// True if there is one stored position for each entry in agent_IDs
+	bool slots_consistent() const
+	{
+		if (!indexed()) {
+			return true;
+		}
+		if (agent_slots.size() != agent_IDs.size()) {
+			return false;
+		}
+		for (const auto& slot : agent_slots) {
+			if ((slot.second < 0) || (slot.second >= static_cast<int>(agent_IDs.size())) 
+					|| (agent_IDs.at(slot.second) != slot.first)) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+/// Agents removed one by one from a large place in random order
+bool large_place_removal_test()
+{
+	const int n_agents = 2000;
+	IndexedPlace place;
+	std::vector<int> expected;
+	for (int aID = 1; aID <= n_agents; ++aID) {
+		place.add_agent(aID);
+		expected.push_back(aID);
+		// Some agents are in the place twice
+		if (aID % 10 == 0) {
+			place.add_agent(aID);
+			expected.push_back(aID);
+		}
+	}
+	if (!place.indexed() || !place.slots_consistent()) {
+		std::cerr << "Positions of agents not stored in a large place" << std::endl;
+		return false;
+	}
+
+	std::vector<int> removal_order(n_agents);
+	std::iota(removal_order.begin(), removal_order.end(), 1);
+	std::shuffle(removal_order.begin(), removal_order.end(), std::mt19937(5));
+	std::sort(expected.begin(), expected.end());
+	for (const int aID : removal_order) {
+		place.remove_agent(aID);
+		expected.erase(std::remove(expected.begin(), expected.end(), aID), expected.end());
+		if (!place.slots_consistent()) {
+			std::cerr << "Stored positions wrong after removing " << aID << std::endl;
+			return false;
+		}
+		std::vector<int> reg_agents = place.get_agent_IDs();
+		std::sort(reg_agents.begin(), reg_agents.end());
+		if (reg_agents != expected) {
+			std::cerr << "Wrong agents after removing " << aID << std::endl;
+			return false;
+		}
+	}
+	if (place.indexed() || (place.get_number_of_agents() != 0)) {
+		std::cerr << "Empty place still stores positions" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Visitors are counted with the agents and removed all at once
+bool visitor_test()
+{
+	Household house(3, 0.0, 0.0, 0.8, 1.0, 0.5, 0.1);
+	const std::vector<int> residents = {4, 9, 2};
+	for (const int aID : residents) {
+		house.add_agent(aID);
+	}
+	const std::vector<int> visitors = {10, 5, 11};
+	for (const int aID : visitors) {
+		house.add_visitor(aID);
+	}
+	if (house.get_agent_IDs() != residents || house.get_visitor_IDs() != visitors) {
+		std::cerr << "Wrong agents or visitors" << std::endl;
+		return false;
+	}
+	if (house.get_number_of_agents() != 6) {
+		std::cerr << "Visitors not counted with the agents" << std::endl;
+		return false;
+	}
+
+	// Visitors are included in the total number of agents
+	const double inf_var = 0.9;
+	house.add_exposed(inf_var);
+	house.compute_infected_contribution();
+	double exp_lambda = 0.5*inf_var/std::pow(6.0, 0.8);
+	if (!float_equality<double>(house.get_infected_contribution(), exp_lambda, 1e-10)) {
+		std::cerr << "Wrong contribution with visitors" << std::endl;
+		return false;
+	}
+
+	house.clear_visitors();
+	house.compute_infected_contribution();
+	exp_lambda = 0.5*inf_var/std::pow(3.0, 0.8);
+	if (!house.get_visitor_IDs().empty() || house.get_agent_IDs() != residents
+			|| !float_equality<double>(house.get_infected_contribution(), exp_lambda, 1e-10)) {
+		std::cerr << "Wrong agents after removing visitors" << std::endl;
+		return false;
+	}
+	return true;
+}
+
 /// Test contribution computation
 bool contribution_test_general_place()
 {
@@ -210,9 +373,9 @@ bool school_test()
 		return false;
 	}
 
-	// Removal
+	// Removal - last agent takes the place of the removed one
 	index = 1;
-	std::vector<int> new_agents = {909, 10005, 201};
+	std::vector<int> new_agents = {909, 201, 10005};
 	school.remove_agent(index);
 
 	reg_agents = school.get_agent_IDs();
@@ -860,9 +1023,9 @@ bool general_place_test(Place& place, const int pID,
 		return false;
 	}
 
-	// Removal
+	// Removal - last agent takes the place of the removed one
 	index = 1;
-	std::vector<int> new_agents = {909, 10005, 201};
+	std::vector<int> new_agents = {909, 201, 10005};
 	place.remove_agent(index);
 
 	reg_agents = place.get_agent_IDs();
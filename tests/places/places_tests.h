@@ -1,6 +1,7 @@
 #ifndef PLACES_TESTS_H
 #define PLACES_TESTS_H
 
+#include <numeric>
 #include "../../include/places/place.h"
 #include "../../include/places/school.h"
 #include "../../include/places/workplace.h"
@@ -20,4 +20,6 @@ subprocess.call([py_version + ' compilation.py'], shell=True)
 ut.msg('Place-derived classes functionality tests', CYAN)
 subprocess.call(['./places_test'], shell=True)
 
-
+# Test suite 2
+ut.msg('Routine places of agents in a simulation', CYAN)
+subprocess.call(['./inc_test'], shell=True)
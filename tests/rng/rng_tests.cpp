@@ -15,6 +15,8 @@ bool gamma_test(double, double, double);
 bool lognormal_test(double, double, double);
 bool weibull_test(double, double, double);
 bool random_shuffle_test();
+bool philox_known_answer_test();
+bool seeded_streams_test();
 
 int main()
 {
@@ -28,6 +30,8 @@ int main()
 	test_pass(lognormal_test(logn_meanx, logn_stx, logn_mean), "Lognormal distribution");
 	test_pass(weibull_test(wb_shape, wb_scale, wb_mean), "Weibull distribution");
 	test_pass(random_shuffle_test(), "Random shuffling");
+	test_pass(philox_known_answer_test(), "Philox known answers");
+	test_pass(seeded_streams_test(), "Seeded and independent streams");
 }
 
 /// Test if the uniform distribution generation is correct
@@ -165,3 +169,94 @@ bool random_shuffle_test()
 	rng.vector_shuffle(v2s);
 	return !(v2s == v_orig);
 }
+
+/// Compare Philox4x32-10 output with the reference known answer values
+bool philox_known_answer_test()
+{
+	typedef std::array<std::uint32_t, 4> block;
+	typedef std::array<std::uint32_t, 2> key;
+
+	std::vector<block> ctrs = {{{0, 0, 0, 0}}, 
+				{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+				{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}};
+	std::vector<key> keys = {{{0, 0}}, {{0xffffffff, 0xffffffff}}, {{0xa4093822, 0x299f31d0}}};
+	std::vector<block> expected = {{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+				{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+				{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}};
+
+	for (int i=0; i<ctrs.size(); ++i) {
+		if (Philox4x32::generate_block(ctrs.at(i), keys.at(i)) != expected.at(i)) {
+			std::cerr << "Wrong Philox output for known answer case " << i << std::endl;
+			return false;
+		}
+	}
+	
+	// Engine interface - first stream of key 0
+	Philox4x32 gen(0);
+	for (int i=0; i<4; ++i) {
+		if (gen() != expected.at(0).at(i)) {
+			std::cerr << "Wrong Philox engine output" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Test reproducibility with a fixed seed and independence of streams 
+bool seeded_streams_test()
+{
+	const int n = 1000;
+	const std::uint64_t seed = 2021;
+	RNG rng_1(seed), rng_2(seed), rng_3(seed + 1);
+	std::vector<double> nums_1, nums_2, nums_3;
+	
+	// Same seed, same numbers
+	for (int i=0; i<n; ++i) {
+		nums_1.push_back(rng_1.get_random_gamma(0.77, 3.42));
+		nums_2.push_back(rng_2.get_random_gamma(0.77, 3.42));
+		nums_3.push_back(rng_3.get_random_gamma(0.77, 3.42));
+	}
+	if (nums_1 != nums_2) {
+		std::cerr << "Generators with the same seed differ" << std::endl;
+		return false;
+	}
+	if (nums_1 == nums_3) {
+		std::cerr << "Generators with different seeds are identical" << std::endl;
+		return false;
+	}
+
+	// Streams can be revisited in any order
+	std::vector<double> agent_1, agent_2, agent_1_again;
+	rng_1.set_stream(1, 5);
+	for (int i=0; i<n; ++i) {
+		agent_1.push_back(rng_1.get_random(0.0, 1.0));
+	}
+	rng_1.set_stream(2, 5);
+	for (int i=0; i<n; ++i) {
+		agent_2.push_back(rng_1.get_random(0.0, 1.0));
+	}
+	rng_2.set_stream(2, 6);
+	rng_2.get_random(0.0, 1.0);
+	rng_2.set_stream(1, 5);
+	for (int i=0; i<n; ++i) {
+		agent_1_again.push_back(rng_2.get_random(0.0, 1.0));
+	}
+	if (agent_1 != agent_1_again) {
+		std::cerr << "Same stream gives different numbers" << std::endl;
+		return false;
+	}
+	if (agent_1 == agent_2) {
+		std::cerr << "Different agent streams are identical" << std::endl;
+		return false;
+	}
+
+	// Streams for a different purpose
+	RNG rng_flu = rng_1.split(RNGPurpose::flu);
+	rng_flu.set_stream(1, 5);
+	rng_1.set_stream(1, 5);
+	if (rng_flu.get_random(0.0, 1.0) == rng_1.get_random(0.0, 1.0)) {
+		std::cerr << "Streams with different purpose are identical" << std::endl;
+		return false;
+	}
+	return true;
+}
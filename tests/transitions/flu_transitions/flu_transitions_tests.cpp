@@ -51,7 +51,8 @@ bool test_susceptible_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
-    std::vector<int> state_changes(4,0);
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
+    SusceptibleStateChanges state_changes = {0, 0, 0, 0};
 
 	FluTransitions flu_tr;
 	Flu& flu = abm.get_flu_object();
@@ -105,7 +106,7 @@ bool test_susceptible_transitions()
 				state_changes = flu_tr.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, retirement_homes,
 				   	carpools, public_transit, leisure_locations,	
-					infection_parameters, agents, flu, testing, dt);
+					resolved_parameters, agents, flu, testing, dt);
 			}
 			if (state_changes.at(0) == 0){
 				// Testing flags
@@ -402,7 +403,8 @@ bool sim_set_test_susceptible_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
-    std::vector<int> state_changes(4,0);
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
+    SusceptibleStateChanges state_changes = {0, 0, 0, 0};
 
 	FluTransitions flu_tr;
 	Flu& flu = abm.get_flu_object();
@@ -456,7 +458,7 @@ bool sim_set_test_susceptible_transitions()
 				state_changes = flu_tr.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, retirement_homes,
 				   	carpools, public_transit, leisure_locations,	
-					infection_parameters, agents, flu, testing, dt);
+					resolved_parameters, agents, flu, testing, dt);
 			}
 			if (state_changes.at(0) == 0){
 				// Testing flags
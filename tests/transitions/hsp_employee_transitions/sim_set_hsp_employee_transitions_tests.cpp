@@ -22,7 +22,7 @@ bool check_isolation(const Agent&, const std::vector<School>&,
 bool check_testing_transitions(const Agent& agent, const std::vector<Household>& households, 
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
 				const std::vector<Transit>&, const std::vector<Transit>&,
-				std::vector<int>& state_changes, int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
+				InfectedStateChanges& state_changes, int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
 				int& n_positive, int& n_false_neg, int& n_hsp, int& n_hsp_icu, int& n_ih, double time, double dt);
 bool test_leisure(const Agent&, const std::vector<Household>&, 
 				const std::vector<RetirementHome>&, const double);
@@ -37,7 +37,7 @@ bool check_hospitalized_isolation(const Agent& agent, const std::vector<Househol
 bool check_symptomatic_agent_removal(const Agent& agent, const std::vector<Household>& households,
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
 				const std::vector<Transit>&, const std::vector<Transit>&,
-				std::vector<int>& state_changes, int& n_rh, int& n_rd, double time, double dt);
+				InfectedStateChanges& state_changes, int& n_rh, int& n_rd, double time, double dt);
 
 int main()
 {
@@ -73,6 +73,7 @@ bool test_susceptible_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object();
 
 	HspEmployeeTransitions hsp_em;
@@ -101,7 +102,7 @@ bool test_susceptible_transitions()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-					leisure_locations, infection_parameters, agents, testing);
+					leisure_locations, resolved_parameters, agents, testing);
 				if (got_infected == 0){
 					continue;
 				}
@@ -219,6 +220,7 @@ bool test_exposed_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object(); 
 
 	HspEmployeeTransitions hsp_em;
@@ -233,7 +235,7 @@ bool test_exposed_transitions()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -253,11 +255,11 @@ bool test_exposed_transitions()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-					leisure_locations, infection_parameters, agents, testing);
+					leisure_locations, resolved_parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_em.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals, carpools, public_transit,
-					infection_parameters, testing);
+					resolved_parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households, schools, 
@@ -383,6 +385,7 @@ bool test_symptomatic_transitions()
 
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object();
 
 	HspEmployeeTransitions hsp_em;
@@ -396,7 +399,7 @@ bool test_symptomatic_transitions()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -416,14 +419,14 @@ bool test_symptomatic_transitions()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-				   	leisure_locations, infection_parameters, agents, testing);
+				   	leisure_locations, resolved_parameters, agents, testing);
 			} else if (agent.exposed() == true){
 				state_changes = hsp_em.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals, carpools, public_transit,
-					infection_parameters, testing);
+					resolved_parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = hsp_em.symptomatic_transitions(agent, time, dt, infection,  
-					households, schools, hospitals, carpools, public_transit, infection_parameters);
+					households, schools, hospitals, carpools, public_transit, resolved_parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, schools, hospitals, 
 							carpools, public_transit, state_changes, n_sy_recovering, n_sy_dying, time, dt)){
@@ -491,6 +494,7 @@ bool test_exposed_transitions_seeded()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object(); 
 
 	HspEmployeeTransitions hsp_em;
@@ -505,7 +509,7 @@ bool test_exposed_transitions_seeded()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -525,11 +529,11 @@ bool test_exposed_transitions_seeded()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-					leisure_locations, infection_parameters, agents, testing);
+					leisure_locations, resolved_parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_em.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals, carpools, public_transit,
-					infection_parameters, testing);
+					resolved_parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households, schools, 
@@ -657,6 +661,7 @@ bool test_symptomatic_transitions_seeded()
 
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object();
 
 	HspEmployeeTransitions hsp_em;
@@ -670,7 +675,7 @@ bool test_symptomatic_transitions_seeded()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -690,14 +695,14 @@ bool test_symptomatic_transitions_seeded()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-				   	leisure_locations, infection_parameters, agents, testing);
+				   	leisure_locations, resolved_parameters, agents, testing);
 			} else if (agent.exposed() == true){
 				state_changes = hsp_em.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals, carpools, public_transit,
-					infection_parameters, testing);
+					resolved_parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = hsp_em.symptomatic_transitions(agent, time, dt, infection,  
-					households, schools, hospitals, carpools, public_transit, infection_parameters);
+					households, schools, hospitals, carpools, public_transit, resolved_parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, schools, hospitals, 
 							carpools, public_transit, state_changes, n_sy_recovering, n_sy_dying, time, dt)){
@@ -833,7 +838,7 @@ bool check_fractions(int num1, int num2, double fr_expected, std::string msg, bo
 bool check_testing_transitions(const Agent& agent, const std::vector<Household>& households,
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
 				const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit,
-				std::vector<int>& state_changes, int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
+				InfectedStateChanges& state_changes, int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
 				int& n_positive, int& n_false_neg, int& n_hsp, int& n_hsp_icu, int& n_ih, double time, double dt)
 {
 	// Testing flags
@@ -1135,7 +1140,7 @@ bool test_leisure(const Agent& agent, const std::vector<Household>& households,
 bool check_symptomatic_agent_removal(const Agent& agent, const std::vector<Household>& households,
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
 				const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit,
-				std::vector<int>& state_changes, int& n_rh, int& n_rd, double time, double dt)
+				InfectedStateChanges& state_changes, int& n_rh, int& n_rd, double time, double dt)
 {
 	const int aID = agent.get_ID();
 	if (state_changes.at(1)){
@@ -21,13 +21,13 @@ bool only_hospitals(const Agent&, const std::vector<Hospital>&, const std::vecto
 				const std::vector<School>&, const std::vector<RetirementHome>& retirement_homes,
 				const std::vector<Workplace>&);
 bool check_testing_transitions(const Agent& agent, const std::vector<Household>& households, 
-				const std::vector<Hospital>& hospitals,	std::vector<int>& state_changes, 
+				const std::vector<Hospital>& hospitals,	InfectedStateChanges& state_changes, 
 				int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
 				int& n_positive, int& n_false_neg, int& n_hsp, int& n_hsp_icu, int& n_ih, double time, double dt);
 bool check_treatment_setup(const Agent& agent, const std::vector<Household>& households,
 			const std::vector<Hospital>& hospitals, int& n_hsp, int& n_hsp_icu, int& n_ih, double time, double dt);
 bool check_symptomatic_agent_removal(const Agent& agent, const std::vector<Household>& households,
-				const std::vector<Hospital>& hospitals, std::vector<int>& state_changes, 
+				const std::vector<Hospital>& hospitals, InfectedStateChanges& state_changes, 
 				int& n_rh, int& n_rd, double time, double dt);
 
 int main()
@@ -60,6 +60,7 @@ bool test_susceptible_transitions()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object();
 
 	HspPatientTransitions hsp_pt;
@@ -85,7 +86,7 @@ bool test_susceptible_transitions()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, resolved_parameters, agents, testing);
 				if (got_infected == 0){
 					continue;
 				}
@@ -199,6 +200,7 @@ bool test_exposed_transitions()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object(); 
 
 	HspPatientTransitions hsp_pt;
@@ -213,7 +215,7 @@ bool test_exposed_transitions()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -227,10 +229,10 @@ bool test_exposed_transitions()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, resolved_parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_pt.exposed_transitions(agent, infection, time, dt, 
-					households, hospitals, infection_parameters, testing);
+					households, hospitals, resolved_parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households,  
@@ -346,6 +348,7 @@ bool test_symptomatic_transitions()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object();
 
 	HspPatientTransitions hsp_pt;
@@ -359,7 +362,7 @@ bool test_symptomatic_transitions()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -372,13 +375,13 @@ bool test_symptomatic_transitions()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, resolved_parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_pt.exposed_transitions(agent, infection, time, dt, 
-					households, hospitals, infection_parameters, testing);
+					households, hospitals, resolved_parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = hsp_pt.symptomatic_transitions(agent, time, dt, infection,  
-					households, hospitals, infection_parameters);
+					households, hospitals, resolved_parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, hospitals, 
 							state_changes, n_sy_recovering, n_sy_dying, time, dt)){
@@ -441,6 +444,7 @@ bool test_exposed_transitions_seeded()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object(); 
 
 	HspPatientTransitions hsp_pt;
@@ -455,7 +459,7 @@ bool test_exposed_transitions_seeded()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -469,10 +473,10 @@ bool test_exposed_transitions_seeded()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, resolved_parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_pt.exposed_transitions(agent, infection, time, dt, 
-					households, hospitals, infection_parameters, testing);
+					households, hospitals, resolved_parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households,  
@@ -590,6 +594,7 @@ bool test_symptomatic_transitions_seeded()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object();
 
 	HspPatientTransitions hsp_pt;
@@ -603,7 +608,7 @@ bool test_symptomatic_transitions_seeded()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -616,13 +621,13 @@ bool test_symptomatic_transitions_seeded()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, resolved_parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_pt.exposed_transitions(agent, infection, time, dt, 
-					households, hospitals, infection_parameters, testing);
+					households, hospitals, resolved_parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = hsp_pt.symptomatic_transitions(agent, time, dt, infection,  
-					households, hospitals, infection_parameters);
+					households, hospitals, resolved_parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, hospitals, 
 							state_changes, n_sy_recovering, n_sy_dying, time, dt)){
@@ -731,7 +736,7 @@ bool only_hospitals(const Agent& agent, const std::vector<Hospital>& hospitals,
 
 /// Tests for exposed agent that is undergoing testing or gets the results
 bool check_testing_transitions(const Agent& agent, const std::vector<Household>& households,
-				const std::vector<Hospital>& hospitals, std::vector<int>& state_changes, 
+				const std::vector<Hospital>& hospitals, InfectedStateChanges& state_changes, 
 				int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
 				int& n_positive, int& n_false_neg, int& n_hsp, int& n_hsp_icu, int& n_ih, double time, double dt)
 {
@@ -955,7 +960,7 @@ bool check_treatment_setup(const Agent& agent, const std::vector<Household>& hou
 
 /// Test for properties related to removal of a symptomatic agent
 bool check_symptomatic_agent_removal(const Agent& agent, const std::vector<Household>& households,
-				const std::vector<Hospital>& hospitals, std::vector<int>& state_changes, 
+				const std::vector<Hospital>& hospitals, InfectedStateChanges& state_changes, 
 				int& n_rh, int& n_rd, double time, double dt)
 {
 	const int aID = agent.get_ID();
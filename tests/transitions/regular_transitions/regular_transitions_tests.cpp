@@ -31,7 +31,7 @@ bool check_testing_transitions(const Agent& agent, const std::vector<Household>&
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
 				const std::vector<RetirementHome>& retirement_homes, const std::vector<Workplace>& workplaces,
 				const std::vector<Transit>&, const std::vector<Transit>&,
-				std::vector<int>& state_changes, int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
+				InfectedStateChanges& state_changes, int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
 				int& n_positive, int& n_false_neg, int& n_hsp, int& n_hsp_icu, int& n_ih, double time, double dt);
 bool check_treatment_setup(const Agent& agent, const std::vector<Household>& households,
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
@@ -46,7 +46,7 @@ bool check_symptomatic_agent_removal(const Agent& agent, const std::vector<House
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
 				const std::vector<RetirementHome>& retirement_homes, const std::vector<Workplace>& workplaces, 
 				const std::vector<Transit>&, const std::vector<Transit>&,
-				std::vector<int>& state_changes, int& n_rh, int& n_rd, double time, double dt);
+				InfectedStateChanges& state_changes, int& n_rh, int& n_rd, double time, double dt);
 
 int main()
 {
@@ -82,6 +82,7 @@ bool test_susceptible_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Flu& flu = abm.get_flu_object();
 	Testing testing = abm.get_testing_object();
 
@@ -115,7 +116,7 @@ bool test_susceptible_transitions()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations, 
-					infection_parameters, agents, flu, testing);
+					resolved_parameters, agents, flu, testing);
 				if (got_infected == 0){
 					continue;
 				}
@@ -248,6 +249,7 @@ bool test_exposed_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object();
 	Flu flu = abm.get_flu_object();
 
@@ -263,7 +265,7 @@ bool test_exposed_transitions()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -286,11 +288,11 @@ bool test_exposed_transitions()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations,
-					infection_parameters, agents, flu, testing);
+					resolved_parameters, agents, flu, testing);
 			} else if (agent.exposed() == true){
 				state_changes = regular.exposed_transitions(agent, infection, time, dt, 
 					households, schools, workplaces, hospitals, retirement_homes,
-					carpools, public_transit, infection_parameters, testing);
+					carpools, public_transit, resolved_parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households, schools, 
@@ -415,6 +417,7 @@ bool test_symptomatic_transitions()
 
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Flu& flu = abm.get_flu_object();
 	Testing testing = abm.get_testing_object();
 
@@ -429,7 +432,7 @@ bool test_symptomatic_transitions()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -452,15 +455,15 @@ bool test_symptomatic_transitions()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations,
-					infection_parameters, agents, flu, testing);
+					resolved_parameters, agents, flu, testing);
 			}else if (agent.exposed() == true){
 				state_changes = regular.exposed_transitions(agent, infection, time, dt, 
 					households, schools, workplaces, hospitals, retirement_homes, 
-					carpools, public_transit, infection_parameters, testing);
+					carpools, public_transit, resolved_parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = regular.symptomatic_transitions(agent, time, dt, infection,
 					households, schools, workplaces, hospitals, retirement_homes,
-					carpools, public_transit, infection_parameters);
+					carpools, public_transit, resolved_parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, schools, hospitals, retirement_homes, 
 									workplaces, carpools, public_transit, 
@@ -528,6 +531,7 @@ bool test_exposed_transitions_seeded()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Testing testing = abm.get_testing_object();
 	Flu flu = abm.get_flu_object();
 
@@ -543,7 +547,7 @@ bool test_exposed_transitions_seeded()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -566,11 +570,11 @@ bool test_exposed_transitions_seeded()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations,
-					infection_parameters, agents, flu, testing);
+					resolved_parameters, agents, flu, testing);
 			} else if (agent.exposed() == true){
 				state_changes = regular.exposed_transitions(agent, infection, time, dt, 
 					households, schools, workplaces, hospitals, retirement_homes,
-					carpools, public_transit, infection_parameters, testing);
+					carpools, public_transit, resolved_parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households, schools, 
@@ -697,6 +701,7 @@ bool test_symptomatic_transitions_seeded()
 
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& resolved_parameters = abm.get_resolved_infection_parameters();
 	Flu& flu = abm.get_flu_object();
 	Testing testing = abm.get_testing_object();
 
@@ -711,7 +716,7 @@ bool test_symptomatic_transitions_seeded()
 	int n_sy_recovering = 0, n_sy_dying = 0;
 	int n_tr_hsp = 0, n_hsp_icu = 0, n_ih = 0;
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
-    std::vector<int> state_changes(5,0);
+    InfectedStateChanges state_changes = {0, 0, 0, 0, 0};
 
 	// To initialize Flu agents
 	testing.check_switch_time(0);
@@ -735,15 +740,15 @@ bool test_symptomatic_transitions_seeded()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations,
-					infection_parameters, agents, flu, testing);
+					resolved_parameters, agents, flu, testing);
 			}else if (agent.exposed() == true){
 				state_changes = regular.exposed_transitions(agent, infection, time, dt, 
 					households, schools, workplaces, hospitals, retirement_homes, 
-					carpools, public_transit, infection_parameters, testing);
+					carpools, public_transit, resolved_parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = regular.symptomatic_transitions(agent, time, dt, infection,
 					households, schools, workplaces, hospitals, retirement_homes,
-					carpools, public_transit, infection_parameters);
+					carpools, public_transit, resolved_parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, schools, hospitals, retirement_homes, 
 									workplaces, carpools, public_transit, state_changes, n_sy_recovering, n_sy_dying, time, dt)){
@@ -983,7 +988,7 @@ bool check_testing_transitions(const Agent& agent, const std::vector<Household>&
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
 				const std::vector<RetirementHome>& retirement_homes, const std::vector<Workplace>& workplaces,
 			   	const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit,
-				std::vector<int>& state_changes, int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
+				InfectedStateChanges& state_changes, int& n_tested_exposed, int& n_tested_sy, int& n_waiting_for_res, 
 				int& n_positive, int& n_false_neg, int& n_hsp, int& n_hsp_icu, int& n_ih, double time, double dt)
 {
 	// Testing flags
@@ -1215,7 +1220,7 @@ bool check_symptomatic_agent_removal(const Agent& agent, const std::vector<House
 				const std::vector<School>& schools, const std::vector<Hospital>& hospitals,
 				const std::vector<RetirementHome>& retirement_homes, const std::vector<Workplace>& workplaces,
 				const std::vector<Transit>& carpools, const std::vector<Transit>& public_transit,
-				std::vector<int>& state_changes, int& n_rh, int& n_rd, double time, double dt)
+				InfectedStateChanges& state_changes, int& n_rh, int& n_rd, double time, double dt)
 {
 	const int aID = agent.get_ID();
 	if (state_changes.at(1)){
@@ -32,3 +32,20 @@ spec_files = 'vaccinations_tests.cpp '
 compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
 
+# Test suite 2
+# Vaccinations during a simulation
+exe_name = 'vac_abm_tests'
+# Source files of the rest of the model
+abm_files = ' '.join(path + x for x in ['abm.cpp', 'data_management_interface.cpp', 
+				'mobility.cpp', 'town.cpp', 'testing.cpp', 'contact_tracing.cpp', 'contributions.cpp', 
+				'transitions/transitions.cpp', 'transitions/regular_transitions.cpp', 
+				'transitions/hsp_employee_transitions.cpp', 'transitions/hsp_patient_transitions.cpp', 
+				'transitions/flu_transitions.cpp', 'states_manager/states_manager.cpp', 
+				'states_manager/regular_states_manager.cpp', 'states_manager/hsp_employee_states_manager.cpp', 
+				'flu.cpp', 'places/place.cpp', 'places/household.cpp', 'places/workplace.cpp', 
+				'places/school.cpp', 'places/hospital.cpp', 'places/retirement_home.cpp', 
+				'places/transit.cpp', 'places/leisure.cpp'])
+# Files needed only for this build
+spec_files = 'vaccinations_in_abm_tests.cpp '
+compile_com = ' '.join([cx, std, opt, '-pthread', '-o', exe_name, spec_files, tst_files, src_files, abm_files])
+subprocess.call([compile_com], shell=True)
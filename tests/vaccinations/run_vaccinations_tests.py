@@ -16,7 +16,10 @@ py_version = 'python3'
 # Compile
 subprocess.call([py_version + ' compilation.py'], shell=True)
 
-# Test suite 
+# Test suite 1
 ut.msg('Vaccinations class functionality tests', CYAN)
 subprocess.call(['./vac_tests'], shell=True)
 
+# Test suite 2
+ut.msg('Vaccinations during a simulation', CYAN)
+subprocess.call(['./vac_abm_tests'], shell=True)
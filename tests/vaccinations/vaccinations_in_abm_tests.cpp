@@ -0,0 +1,48 @@
+#include "../../include/abm.h"
+#include "../common/test_utils.h"
+#include "../common/abm_test_setup.h"
+
+/*****************************************************
+ *
+ * Test suite for vaccinations during a simulation
+ *
+ *****************************************************/
+
+// Tests
+bool eligibility_pool_test();
+
+int main()
+{
+	test_pass(eligibility_pool_test(), "Tracked pool of agents eligible for vaccination");
+}
+
+/// Pool of agents eligible for random vaccination matches filtering all the agents
+bool eligibility_pool_test()
+{
+	int tmax = 40;
+
+	ABM abm = vac_reopening_test_model(7);
+	abm.set_number_of_threads(2);
+	for (int ti = 0; ti <= tmax; ++ti) {
+		abm.transmit_with_vac();
+		const Vaccinations& tracked = abm.get_vaccinations_object();
+		if (!tracked.tracking_eligibility()) {
+			continue;
+		}
+		Vaccinations full = tracked;
+		full.stop_tracking_eligibility();
+		const std::vector<Agent>& agents = abm.get_vector_of_agents();
+		if (tracked.max_eligible_random(agents) != full.max_eligible_random(agents)) {
+			std::cerr << "Eligible agents differ at step " << ti << std::endl;
+			return false;
+		}
+		for (const std::string group : {"hospital employees", "school employees", 
+					"retirement home employees", "retirement home residents"}) {
+			if (tracked.max_eligible_group(agents, group) != full.max_eligible_group(agents, group)) {
+				std::cerr << "Eligible agents in group " << group << " differ at step " << ti << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
@@ -17,20 +17,21 @@ using one_map = const std::map<std::string, std::vector<std::vector<double>>>;
 
 // Tests
 bool check_random_vaccinations_functionality();
-bool check_group_vaccinations_functionality();
+bool check_group_vaccinations_functionality(const bool track_eligible);
 bool check_random_vaccinations_neg_time_offset();
 bool check_random_revaccinations();
 
 // Supporting functions
-bool check_agent_vaccination_attributes(Agent& agent, const double time, 
-											nested_maps&, const double offset, 
+bool check_agent_vaccination_attributes(Agent& agent, const Vaccinations& vaccinations, 
+											const double time, nested_maps&, const double offset, 
 											const std::set<int>& revac_IDs = {}, std::ostream& out= std::cout);
 
 int main()
 {
 	test_pass(check_random_vaccinations_functionality(), "Random vaccination functionality");
 	test_pass(check_random_vaccinations_neg_time_offset(), "Random vaccination functionality - negative time offset");
-	test_pass(check_group_vaccinations_functionality(), "Group vaccination functionality");
+	test_pass(check_group_vaccinations_functionality(false), "Group vaccination functionality");
+	test_pass(check_group_vaccinations_functionality(true), "Group vaccination functionality - tracked eligible agents");
 	test_pass(check_random_revaccinations(), "Random re-vaccination functionality");
 }
 
@@ -158,7 +159,7 @@ bool check_random_vaccinations_functionality()
 	std::vector<double> offsets(n_agents, 0.0);
 	for (int i=0; i<n_steps; ++i) {
 		for (auto& agent : agents) {
-			if (!check_agent_vaccination_attributes(agent, time, vac_data_map, offsets.at(agent.get_ID()-1))) {
+			if (!check_agent_vaccination_attributes(agent, vaccinations, time, vac_data_map, offsets.at(agent.get_ID()-1))) {
 				std::cerr << "Error in properties of vaccinated and not vaccinated agents" << std::endl;
 				return false;		
 			}
@@ -316,7 +317,7 @@ bool check_random_vaccinations_neg_time_offset()
 	// Check properties with time
 	for (int i=0; i<n_steps; ++i) {
 		for (auto& agent : agents) {
-			if (!check_agent_vaccination_attributes(agent, time, vac_data_map, agent.get_vac_time_offset())) {
+			if (!check_agent_vaccination_attributes(agent, vaccinations, time, vac_data_map, agent.get_vac_time_offset())) {
 				std::cerr << "Error in properties of vaccinated and not vaccinated agents" << std::endl;
 				return false;		
 			}
@@ -346,7 +347,7 @@ bool check_random_vaccinations_neg_time_offset()
 	return true;
 }
 
-bool check_group_vaccinations_functionality()
+bool check_group_vaccinations_functionality(const bool track_eligible)
 {
 	// Vaccination settings
 	const std::string data_dir("test_data/");
@@ -445,6 +446,10 @@ bool check_group_vaccinations_functionality()
 
 	// Vaccination functionality
 	Vaccinations vaccinations(fname, data_dir);
+	// Agents change only through vaccinations so the tracked ones stay valid
+	if (track_eligible) {
+		vaccinations.track_eligibility(agents);
+	}
 
 	// Vaccination data
 	nested_maps& vac_data_map = vaccinations.get_vaccination_data();
@@ -492,7 +497,7 @@ bool check_group_vaccinations_functionality()
 	std::vector<double> offsets(n_agents, 0.0);
 	for (int i=0; i<n_steps; ++i) {
 		for (auto& agent : agents) {
-			if (!check_agent_vaccination_attributes(agent, time, vac_data_map, offsets.at(agent.get_ID()-1))) {
+			if (!check_agent_vaccination_attributes(agent, vaccinations, time, vac_data_map, offsets.at(agent.get_ID()-1))) {
 				std::cerr << "Error in properties of vaccinated and not vaccinated agents" << std::endl;
 				return false;		
 			}
@@ -531,8 +536,8 @@ bool check_group_vaccinations_functionality()
 }
 
 /// Tests all the states and properties related to vaccinations
-bool check_agent_vaccination_attributes(Agent& agent, const double time, 
-											nested_maps& vac_data_map, const double offset,
+bool check_agent_vaccination_attributes(Agent& agent, const Vaccinations& vaccinations, 
+											const double time, nested_maps& vac_data_map, const double offset,
 											const std::set<int>& revac_IDs, std::ostream& fout)
 {
 	double tol = 1e-3;
@@ -569,14 +574,14 @@ bool check_agent_vaccination_attributes(Agent& agent, const double time,
 	} else {
 		// For re-vaccinations - just print and inspect
 		if ((!revac_IDs.empty()) && (revac_IDs.find(agent.get_ID())!=revac_IDs.end())) {
-			fout << time << " " << agent.get_ID() << " " << agent.get_vaccine_subtype() << " " 
+			fout << time << " " << agent.get_ID() << " " << vaccinations.get_vaccine_subtype(agent) << " " 
 				 << agent.vaccine_effectiveness(time) << " " << agent.asymptomatic_correction(time) << " " 
 				 << agent.transmission_correction(time) << " " 
 				 << agent.severe_correction(time) << " " << agent.death_correction(time) << std::endl;
 			return true; 
 		}
 		// Get the property map for this agents tag
-		std::string tag = agent.get_vaccine_subtype();
+		std::string tag = vaccinations.get_vaccine_subtype(agent);
 		one_map& prop_map = vac_data_map.at(tag);
 		// Construct tpf or fpf for each property
 		// Check for current time if all properties equal expeceted
@@ -764,7 +769,7 @@ bool check_random_revaccinations()
 	// Check properties with time
 	for (int i=0; i<n_steps; ++i) {
 		for (auto& agent : agents) {
-			if (!check_agent_vaccination_attributes(agent, time, vac_data_map, 
+			if (!check_agent_vaccination_attributes(agent, vaccinations, time, vac_data_map, 
 					agent.get_vac_time_offset(), revaccinated, fout)) {
 				std::cerr << "Error in properties of vaccinated and not vaccinated agents" << std::endl;
 				return false;		